@@ -6,6 +6,7 @@
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
+#include "duckdb/storage/object_cache.hpp"
 
 #include "erpl_rfc_extension.hpp"
 #include "pragma_ping.hpp"
@@ -13,15 +14,30 @@
 #include "pragma_ini.hpp"
 #include "pragma_tunnel_deprecated.hpp"
 #include "scanner_invoke.hpp"
+#include "scanner_invoke_each.hpp"
+#include "scanner_invoke_table.hpp"
+#include "scanner_bulk_call.hpp"
+#include "scanner_invoke_handle.hpp"
 #include "scanner_show_groups.hpp"
 #include "scanner_describe_function.hpp"
 #include "scanner_show_functions.hpp"
 #include "scanner_show_tables.hpp"
 #include "scanner_describe_fields.hpp"
 #include "scanner_read_table.hpp"
+#include "scanner_read_table_incremental.hpp"
+#include "scanner_extract.hpp"
 #include "scanner_rfc_authorizations.hpp"
+#include "scanner_replica_status.hpp"
+#include "scanner_rfc_api_stats.hpp"
+#include "scanner_scan_history.hpp"
+#include "scanner_trace_decode.hpp"
 #include "sap_rfc_api.hpp"
 #include "sap_rfc.hpp"
+#include "sap_metadata_cache.hpp"
+#include "sap_invoke_cache.hpp"
+#include "sap_shared_scan.hpp"
+#include "sap_trace_spans.hpp"
+#include "sap_scan_history.hpp"
 
 #include "telemetry.hpp"
 #include "erpl_telemetry.hpp"
@@ -127,6 +143,17 @@ namespace duckdb {
         erpl::ErplTracer::Instance().SetTraceDirectory(parameter.GetValue<string>());
     }
 
+    static void OnTraceFormat(ClientContext &, SetScope, Value &parameter)
+    {
+        auto format = parameter.GetValue<string>();
+        auto format_upper = StringUtil::Upper(format);
+        if (format_upper != "TEXT" && format_upper != "BINARY") {
+            throw BinderException("Invalid trace format: " + format + ". Valid formats are: text, binary");
+        }
+        erpl::ErplTracer::Instance().SetFormat(format_upper == "BINARY" ? erpl::TraceFormat::BINARY
+                                                                       : erpl::TraceFormat::TEXT);
+    }
+
     static void OnTraceMaxFileSize(ClientContext &, SetScope, Value &parameter)
     {
         auto max_size = parameter.GetValue<int64_t>();
@@ -157,6 +184,50 @@ namespace duckdb {
         SetRfcReadTableBatchBudget(parameter.GetValue<unsigned int>());
     }
 
+    static void OnMetadataCache(ClientContext &, SetScope, Value &parameter) {
+        SetRfcMetadataCache(parameter.GetValue<bool>());
+    }
+
+    static void OnInvokeCacheTtl(ClientContext &, SetScope, Value &parameter) {
+        SetRfcInvokeCacheTtl(parameter.GetValue<unsigned int>());
+    }
+
+    static void OnInvokeCacheMaxMemory(ClientContext &, SetScope, Value &parameter) {
+        SetRfcInvokeCacheMaxMemory(parameter.GetValue<uint64_t>());
+    }
+
+    static void OnInvokeCacheFunctions(ClientContext &, SetScope, Value &parameter) {
+        SetRfcInvokeCacheFunctions(parameter.GetValue<string>());
+    }
+
+    static void OnSharedScanBuffer(ClientContext &, SetScope, Value &parameter) {
+        SetRfcSharedScanBuffer(parameter.GetValue<uint64_t>());
+    }
+
+    static void OnTraceSpansDir(ClientContext &context, SetScope, Value &parameter) {
+        auto directory = parameter.GetValue<string>();
+        if (!directory.empty() && !DBConfig::GetConfig(context).CanAccessFile(directory, FileType::FILE_TYPE_DIR)) {
+            throw PermissionException("Cannot write span traces to '%s': file system operations are "
+                                      "disabled by configuration", directory);
+        }
+        SetRfcTraceSpansDirectory(directory);
+    }
+
+    static void OnScanHistory(ClientContext &context, SetScope, Value &parameter) {
+        auto path = parameter.GetValue<string>();
+        // Writes go through the query's FileSystem as well; checking here
+        // turns a history that could never be written into an error.
+        if (!path.empty() && !DBConfig::GetConfig(context).CanAccessFile(path, FileType::FILE_TYPE_REGULAR)) {
+            throw PermissionException("Cannot write the scan history to '%s': file system operations are "
+                                      "disabled by configuration", path);
+        }
+        SetRfcScanHistoryPath(path);
+    }
+
+    static void OnCatalogDiscoveryThreads(ClientContext &, SetScope, Value &parameter) {
+        SetRfcCatalogDiscoveryThreads(parameter.GetValue<unsigned int>());
+    }
+
     static void OnRfcBackend(ClientContext &, SetScope, Value &parameter) {
         SetRfcBackend(parameter.GetValue<string>());
     }
@@ -165,6 +236,10 @@ namespace duckdb {
         SetRfcBackendLibraryPath(parameter.GetValue<string>());
     }
 
+    static void OnRfcApiStats(ClientContext &, SetScope, Value &parameter) {
+        SetRfcApiInstrumentation(parameter.GetValue<bool>());
+    }
+
     // Reports which implementation is serving RFC calls, resolving the backend if that
     // has not happened yet.  Deliberately returns the bare name rather than the library
     // path, so a test can assert on it without depending on where the build put things.
@@ -191,6 +266,8 @@ namespace duckdb {
                                   LogicalType::VARCHAR, Value("console"), OnTraceOutput);
         config.AddExtensionOption("erpl_trace_file_path", "Set ERPL RFC trace file path", LogicalType::VARCHAR,
                                   Value("trace"), OnTraceDirectory);
+        config.AddExtensionOption("erpl_trace_format", "Set ERPL RFC trace file format (text, binary; read binary with erpl_trace_decode)",
+                                  LogicalType::VARCHAR, Value("text"), OnTraceFormat);
         config.AddExtensionOption("erpl_trace_max_file_size", "Set ERPL RFC trace file max size in bytes",
                                   LogicalType::BIGINT, Value::BIGINT(0), OnTraceMaxFileSize);
         config.AddExtensionOption("erpl_trace_rotation", "Enable ERPL RFC trace file rotation", LogicalType::BOOLEAN,
@@ -247,6 +324,16 @@ namespace duckdb {
             Value(""),
             OnRfcBackendPath);
 
+        config.AddExtensionOption(
+            "erpl_rfc_api_stats",
+            "Count and time every call into the RFC library, per entry point (RfcInvoke, "
+            "RfcGetString, RfcMoveTo, ...), for sap_rfc_api_stats().  Takes effect at once "
+            "and may be switched at any time; switching it on clears the statistics "
+            "gathered before.  Off by default.",
+            LogicalType::BOOLEAN,
+            Value::BOOLEAN(false),
+            OnRfcApiStats);
+
         config.AddExtensionOption(
             "erpl_rfc_read_table_batch_budget",
             "Target upper bound on concurrent result rows (projected columns x "
@@ -262,6 +349,98 @@ namespace duckdb {
             Value::UINTEGER(RfcReadColumnStateMachine::DEFAULT_READ_TABLE_BATCH_BUDGET),
             OnReadTableBatchBudget);
 
+        config.AddExtensionOption(
+            "erpl_rfc_metadata_cache",
+            "When true (default), RFC function descriptors and the sap_read_table "
+            "capability probes (RFC_READ_TABLE variant, ET_DATA support, TBLOUT result "
+            "table, import parameters) are cached process-wide per SAP system and shared "
+            "by all connections to it, so only the first bind against a system pays for "
+            "the metadata round-trips.  Set to false to drop the cache and go to the SDK "
+            "on every bind.  The SAP NW RFC SDK keeps its own descriptor repository, so "
+            "neither setting picks up a function module changed by a transport; that "
+            "takes a new DuckDB process, which starts with an empty SDK repository.",
+            LogicalType::BOOLEAN,
+            Value(true),
+            OnMetadataCache);
+
+        config.AddExtensionOption(
+            "erpl_rfc_invoke_cache_ttl",
+            "Seconds a sap_rfc_invoke result is cached process-wide and served to identical "
+            "calls (same system, client, user, function, path and arguments).  Identical "
+            "calls that overlap share one RFC round-trip.  Only functions matching "
+            "erpl_rfc_invoke_cache_functions are cached.  0 (the default) disables the "
+            "cache and drops everything cached so far.",
+            LogicalType::UINTEGER,
+            Value::UINTEGER(0),
+            OnInvokeCacheTtl);
+
+        config.AddExtensionOption(
+            "erpl_rfc_invoke_cache_max_memory",
+            "Upper bound in bytes on the sap_rfc_invoke results held by the invoke cache; "
+            "the least recently used results are evicted first, and a single larger "
+            "result is not cached.  Default 64 MiB.",
+            LogicalType::UBIGINT,
+            Value::UBIGINT(RfcInvokeCache::DEFAULT_MAX_MEMORY),
+            OnInvokeCacheMaxMemory);
+
+        config.AddExtensionOption(
+            "erpl_rfc_invoke_cache_functions",
+            "Comma-separated allow-list of function modules whose sap_rfc_invoke results "
+            "may be cached, with * as wildcard.  List only modules without side effects; "
+            "the default covers BAPI GetList / GetDetail methods and a few read-only "
+            "system functions.",
+            LogicalType::VARCHAR,
+            Value(RfcInvokeCache::DEFAULT_FUNCTIONS),
+            OnInvokeCacheFunctions);
+
+        config.AddExtensionOption(
+            "erpl_rfc_shared_scan_buffer",
+            "Upper bound in bytes on the decoded batches a running sap_read_table scan "
+            "keeps for identical scans (same system, user, table, columns and filters) "
+            "that other sessions start while it runs; those read its batches instead "
+            "of extracting the table again.  A reader more than this far behind is cut "
+            "off: it extracts on its own if it has returned no rows yet, and fails "
+            "otherwise.  Default 0, which turns sharing off.",
+            LogicalType::UBIGINT,
+            Value::UBIGINT(RfcSharedScan::DEFAULT_BUFFER),
+            OnSharedScanBuffer);
+
+        config.AddExtensionOption(
+            "erpl_rfc_trace_spans_dir",
+            "Directory that gets one Chrome trace JSON file (chrome://tracing, "
+            "ui.perfetto.dev) per query running sap_read_table, sap_rfc_invoke, "
+            "sap_rfc_invoke_each or sap_rfc_bulk_call: a span for every "
+            "connection open, metadata lookup, RFC call, retry back-off and decode, "
+            "on the thread that ran it and tagged with scan and column.  At most "
+            "100000 spans are kept per query; the number dropped is in the file.  "
+            "Written through DuckDB's file system.  Empty (the default) records nothing.",
+            LogicalType::VARCHAR,
+            Value(""),
+            OnTraceSpansDir);
+
+        config.AddExtensionOption(
+            "erpl_rfc_scan_history",
+            "File every sap_read_table and sap_rfc_invoke scan appends a line to when it "
+            "ends: duration, rows, bytes, RFC calls and time, retries, connections and "
+            "batch size, for sap_rfc_scan_history().  Systems and tables are recorded as "
+            "fingerprints, never by name.  Empty (the default) records nothing.",
+            LogicalType::VARCHAR,
+            Value(""),
+            OnScanHistory);
+
+        config.AddExtensionOption(
+            "erpl_rfc_catalog_discovery_threads",
+            "Number of RFC connections an attached SAP catalog uses to discover the "
+            "DDIC schemas of its TABLES list the first time the catalog is enumerated "
+            "(SHOW TABLES, information_schema.columns, duckdb_columns()).  All listed "
+            "tables are then resolved concurrently over pooled connections instead of "
+            "one DDIF_FIELDINFO_GET round-trip after another.  The default of 3 stays "
+            "below the concurrent logon limit of typical dialog gateways.  Capped at 64; "
+            "0 falls back to discovering tables one at a time.",
+            LogicalType::UINTEGER,
+            Value::UINTEGER(3),
+            OnCatalogDiscoveryThreads);
+
         auto provider = make_uniq<RfcEnvironmentCredentialsProvider>(config);
         provider->SetAll();
 
@@ -298,6 +477,30 @@ namespace duckdb {
             loader.RegisterFunction(std::move(info));
         }
 
+        {
+            CreateTableFunctionInfo info(CreateRfcReadTableIncrementalScanFunction());
+            FunctionDescription desc;
+            desc.description = "Upsert the rows of an SAP table changed since the last run into a local table, by DDIC key, and advance the stored watermark in the same transaction.";
+            desc.examples    = {"SELECT * FROM sap_read_table_incremental('VBAK', WATERMARK_COLUMN='AEDAT')",
+                                "SELECT * FROM sap_read_table_incremental('VBAK', WATERMARK_COLUMN='AEDAT', TARGET='sales_orders', STATE='etl_watermarks')"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"table_name"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateSapExtractScanFunction());
+            FunctionDescription desc;
+            desc.description = "Extract an SAP table to Parquet files in partitions, recording each finished partition in a manifest so that a rerun resumes after a failure.";
+            desc.examples    = {"SELECT * FROM sap_extract('BSEG', TARGET='/data/bseg/')",
+                                "SELECT * FROM sap_extract('BSEG', TARGET='/data/bseg/', FILTER='BUKRS = ''1000''', PARALLEL=8)"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"table_name"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
         {
             CreateTableFunctionInfo info(CreateRfcInvokeScanFunction());
             FunctionDescription desc;
@@ -313,6 +516,63 @@ namespace duckdb {
             loader.RegisterFunction(std::move(info));
         }
 
+        {
+            CreateTableFunctionInfo info(CreateRfcInvokeEachScanFunction());
+            FunctionDescription desc;
+            desc.description = "Call an RFC-enabled SAP function module once per row of a subquery, several calls at a time over pooled connections. Each input column fills the import parameter of the same name; results are tagged with input_row_id.";
+            desc.examples    = {"SELECT * FROM sap_rfc_invoke_each('STFC_CONNECTION', (SELECT 'Hello ' || i AS REQUTEXT FROM range(100) t(i)), threads=8)"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"function_name", "input"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateRfcInvokeTableScanFunction());
+            FunctionDescription desc;
+            desc.description = "Call an RFC-enabled SAP function module once, passing a subquery as one of its TABLES or CHANGING table parameters. Input columns fill the fields of the same name; other parameters go into `arguments` as a STRUCT.";
+            desc.examples    = {"SELECT * FROM sap_rfc_invoke_table('STFC_STRUCTURE', (SELECT 'A' AS RFCCHAR1, 1 AS RFCINT4), parameter='RFCTABLE', path='/RFCTABLE')"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"function_name", "input"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateRfcBulkCallScanFunction());
+            FunctionDescription desc;
+            desc.description = "Write a subquery to SAP through a BAPI: one call per row, or per batch of rows passed as a table parameter, on several connections in parallel. Commits with BAPI_TRANSACTION_COMMIT every `commit_every` calls and returns the RETURN messages of every call and commit.";
+            desc.examples    = {"SELECT * FROM sap_rfc_bulk_call('BAPI_PO_CHANGE', (SELECT PURCHASEORDER FROM pos), commit_every=100, threads=4)",
+                                "SELECT * FROM sap_rfc_bulk_call('Z_BAPI_UPLOAD', (SELECT * FROM items), parameter='IT_ITEMS', batch_size=500)"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"function_name", "input"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateRfcInvokeHandleScanFunction());
+            FunctionDescription desc;
+            desc.description = "Call an RFC-enabled SAP function module once and keep its results for this connection. Returns a handle that sap_rfc_result reads any result path from, without calling SAP again.";
+            desc.examples    = {"SET VARIABLE h = (SELECT handle FROM sap_rfc_invoke_handle('STFC_STRUCTURE', {'RFCTABLE': [{'RFCCHAR1': 'A'}]}))"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"function_name"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateRfcResultScanFunction());
+            FunctionDescription desc;
+            desc.description = "Read one result path of a call made by sap_rfc_invoke_handle, as sap_rfc_invoke with the same path would. An empty path returns every result parameter as one row.";
+            desc.examples    = {"SELECT * FROM sap_rfc_result(getvariable('h'), '/RFCTABLE')",
+                                "SELECT * FROM sap_rfc_result(getvariable('h'), '/ECHOSTRUCT')"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"handle", "path"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
         {
             CreateTableFunctionInfo info(CreateRfcShowFunctionScanFunction());
             FunctionDescription desc;
@@ -380,6 +640,61 @@ namespace duckdb {
             loader.RegisterFunction(std::move(info));
         }
 
+        {
+            CreateTableFunctionInfo info(CreateSapReplicaStatusScanFunction());
+            FunctionDescription desc;
+            desc.description = "Show the tables mirrored by SAP catalogs attached with CACHE: when each local copy was loaded, how stale it is, and the last refresh error.";
+            desc.examples    = {"SELECT table_name, staleness, last_error FROM sap_replica_status()"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateSapReplicaRefreshScanFunction());
+            FunctionDescription desc;
+            desc.description = "Reload every table of a SAP catalog attached with CACHE now, wait until each is done, and return their replica status.";
+            desc.examples    = {"SELECT table_name, row_count, last_error FROM sap_replica_refresh('sap')"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"database_name"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateSapRfcApiStatsScanFunction());
+            FunctionDescription desc;
+            desc.description = "Show, per SAP RFC library entry point, the calls made while erpl_rfc_api_stats is on: count, errors by return code, total and average time, and latency percentiles.";
+            desc.examples    = {"SELECT entry_point, calls, total_ms, p99_us FROM sap_rfc_api_stats()"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateSapRfcScanHistoryScanFunction());
+            FunctionDescription desc;
+            desc.description = "Read the scan history written while erpl_rfc_scan_history is set: one row per sap_read_table or sap_rfc_invoke scan with its duration, rows, bytes, RFC calls, retries, connections and batch size. OBJECT narrows it to one table or function module.";
+            desc.examples    = {"SELECT finished_at, duration_ms, rows FROM sap_rfc_scan_history(OBJECT='MARA')"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
+        {
+            CreateTableFunctionInfo info(CreateErplTraceDecodeScanFunction());
+            FunctionDescription desc;
+            desc.description = "Decode a binary ERPL trace file, as written with erpl_trace_format = 'binary', into one row per message. Needs no SAP system.";
+            desc.examples    = {"SELECT timestamp, level, component, message FROM erpl_trace_decode('trace/erpl_trace.bin')"};
+            desc.categories  = {"sap"};
+            desc.parameter_names = {"path"};
+            info.descriptions.push_back(std::move(desc));
+            loader.RegisterFunction(std::move(info));
+        }
+
         loader.RegisterFunction(CreateRfcSetTraceLevelPragma());
         loader.RegisterFunction(CreateRfcSetTraceDirPragma());
         loader.RegisterFunction(CreateRfcSetMaximumTraceFileSizePragma());
@@ -388,6 +703,21 @@ namespace duckdb {
         loader.RegisterFunction(CreateRfcReloadIniFilePragma());
     }
     
+    // Kept in the database's object cache, so it is released when the
+    // database closes and the tracer learns when the last database using it
+    // is gone (see erpl::ErplTracer::AttachDatabase).  It reports no memory,
+    // so the cache never evicts it.
+    class ErplTracerHold : public ObjectCacheEntry
+    {
+    public:
+        ErplTracerHold() { erpl::ErplTracer::Instance().AttachDatabase(); }
+        ~ErplTracerHold() override { erpl::ErplTracer::Instance().DetachDatabase(); }
+
+        static string ObjectType() { return "erpl_rfc_tracer_hold"; }
+        string GetObjectType() override { return ObjectType(); }
+        optional_idx GetEstimatedCacheMemory() const override { return optional_idx(); }
+    };
+
     static void LoadInternal(ExtensionLoader &loader)
     {
         // Pin erpl_rfc permanently so DuckDB's dlclose between connection cycles
@@ -427,6 +757,7 @@ namespace duckdb {
         RegisterConfiguration(loader);
         RegisterRfcFunctions(loader);
         RegisterSapStorageExtension(loader);
+        loader.GetDatabaseInstance().GetObjectCache().GetOrCreate<ErplTracerHold>(ErplTracerHold::ObjectType());
 
         // Stubs naming erpl_tunnel for the SSH tunnel functions erpl used to bundle.
         // See TUNNEL_REMOVAL_PLAN.md.
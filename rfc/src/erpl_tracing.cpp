@@ -1,9 +1,112 @@
 #include "erpl_tracing.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
 #include <iostream>
 
 namespace erpl {
 
+// Single-producer single-consumer queue of one thread's messages.  The owning
+// thread pushes; the consumer is whoever holds the tracer's drain_mutex.
+class TraceRing {
+public:
+    static constexpr uint64_t CAPACITY = 1024;
+
+    TraceRing() : slots(CAPACITY)
+    {
+    }
+
+    bool TryPush(TraceRecord &record)
+    {
+        auto h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        slots[h & (CAPACITY - 1)] = std::move(record);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(TraceRecord &record)
+    {
+        auto t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        record = std::move(slots[t & (CAPACITY - 1)]);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const
+    {
+        return tail.load(std::memory_order_relaxed) == head.load(std::memory_order_acquire);
+    }
+
+    // Set when the owning thread exits; the ring is dropped once drained.
+    std::atomic<bool> orphaned{false};
+
+private:
+    std::vector<TraceRecord> slots;
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+};
+
+namespace {
+
+struct TraceRingHandle {
+    std::shared_ptr<TraceRing> ring;
+    uint32_t thread = 0;
+
+    ~TraceRingHandle()
+    {
+        if (ring) {
+            ring->orphaned.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local TraceRingHandle t_trace_ring;
+std::atomic<uint32_t> g_next_trace_thread{1};
+
+void PutU16(std::string &out, uint16_t value)
+{
+    for (int i = 0; i < 2; i++) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void PutU32(std::string &out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void PutI64(std::string &out, int64_t value)
+{
+    auto bits = static_cast<uint64_t>(value);
+    for (int i = 0; i < 8; i++) {
+        out += static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+}
+
+uint64_t GetLE(const std::string &in, size_t pos, size_t width)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[pos + i])) << (8 * i);
+    }
+    return value;
+}
+
+// i64 timestamp, u8 level, u32 thread, u16 + u32 + u32 string lengths.
+constexpr size_t BINARY_FIXED_SIZE = 8 + 1 + 4 + 2 + 4 + 4;
+
+} // namespace
+
 ErplTracer &ErplTracer::Instance()
 {
     static ErplTracer instance;
@@ -17,79 +120,130 @@ ErplTracer::ErplTracer()
 
 ErplTracer::~ErplTracer()
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    if (trace_file && trace_file->is_open()) {
-        trace_file->close();
+    threshold.store(static_cast<int>(TraceLevel::NONE), std::memory_order_relaxed);
+    bool running;
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        writer_stop = true;
+        running = writer.joinable();
     }
+    writer_cv.notify_all();
+    if (running) {
+        // Only if a database was never closed.  Joining here may deadlock
+        // (see AttachDatabase), so the thread is left to the process exit.
+        writer.detach();
+        return;
+    }
+    Drain();
+    CloseTraceFile();
 }
 
 void ErplTracer::SetEnabled(bool enable_flag)
 {
-    {
-        std::lock_guard<std::mutex> lock(trace_mutex);
-        if (enabled == enable_flag) {
-            return;
-        }
-
-        enabled = enable_flag;
-
-        if (enabled) {
-            EnsureTraceFile();
-        } else {
-            if (trace_file && trace_file->is_open()) {
-                trace_file->close();
-            }
-            trace_file.reset();
-        }
+    std::lock_guard<std::mutex> lock(enable_mutex);
+    if (enabled.exchange(enable_flag) == enable_flag) {
+        return;
     }
 
-    // Call Info outside the lock to avoid deadlock
     if (enable_flag) {
+        StartWriter();
+        UpdateThreshold();
         Info("TRACER", "Tracing enabled");
     } else {
         Info("TRACER", "Tracing disabled");
+        UpdateThreshold();
+        // Nothing is queued any more; the writer would only poll.
+        StopWriter();
+        Flush();
+        CloseTraceFile();
+    }
+}
+
+void ErplTracer::AttachDatabase()
+{
+    std::lock_guard<std::mutex> lock(enable_mutex);
+    databases++;
+    if (enabled.load()) {
+        StartWriter();
+    }
+}
+
+void ErplTracer::DetachDatabase()
+{
+    std::lock_guard<std::mutex> lock(enable_mutex);
+    if (databases == 0 || --databases > 0) {
+        return;
     }
+    StopWriter();
+    Flush();
+    CloseTraceFile();
 }
 
 void ErplTracer::SetLevel(TraceLevel trace_level)
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    level = trace_level;
+    level.store(static_cast<int>(trace_level));
+    UpdateThreshold();
     Info("TRACER", "Trace level set to: " + LevelToString(trace_level));
 }
 
 void ErplTracer::SetTraceDirectory(const std::string &directory)
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    trace_directory = directory;
-    std::filesystem::path path(directory);
-    if (!std::filesystem::exists(path)) {
-        std::filesystem::create_directories(path);
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        trace_directory = directory;
+        file_full = false;
+        std::filesystem::path path(directory);
+        if (!std::filesystem::exists(path)) {
+            std::filesystem::create_directories(path);
+        }
     }
+    // Messages already queued go to the old file.
+    Flush();
+    CloseTraceFile();
     Info("TRACER", "Trace directory set to: " + directory);
-    if (enabled) {
-        EnsureTraceFile();
-    }
 }
 
 void ErplTracer::SetOutputMode(const std::string &mode)
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    output_mode = mode;
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        output_mode = mode;
+    }
     Info("TRACER", "Trace output mode set to: " + mode);
 }
 
+void ErplTracer::SetFormat(TraceFormat trace_format)
+{
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (format == trace_format) {
+            return;
+        }
+        format = trace_format;
+        file_full = false;
+    }
+    CloseTraceFile();
+    Info("TRACER", std::string("Trace format set to: ") + (trace_format == TraceFormat::BINARY ? "binary" : "text"));
+}
+
 void ErplTracer::SetMaxFileSize(int64_t max_size)
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    max_file_size = max_size;
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        max_file_size = max_size;
+        file_full = false;
+    }
     Info("TRACER", "Trace max file size set to: " + std::to_string(max_size));
 }
 
 void ErplTracer::SetRotation(bool rotation)
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    rotation_enabled = rotation;
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        rotation_enabled = rotation;
+        file_full = false;
+    }
     Info("TRACER", "Trace rotation " + std::string(rotation ? "enabled" : "disabled"));
 }
 
@@ -100,28 +254,23 @@ void ErplTracer::Trace(TraceLevel msg_level, const std::string &component, const
 
 void ErplTracer::Trace(TraceLevel msg_level, const std::string &component, const std::string &message, const std::string &data)
 {
-    if (!ShouldEmit(msg_level)) {
+    if (!ShouldTrace(msg_level)) {
         return;
     }
 
-    std::string log_message;
-    log_message.reserve(128 + component.size() + message.size() + data.size());
-
-    log_message += GetTimestamp();
-    log_message += " [";
-    log_message += LevelToString(msg_level);
-    log_message += "] [";
-    log_message += component;
-    log_message += "] ";
-    log_message += message;
-
-    if (!data.empty()) {
-        log_message += "\nData: ";
-        log_message += data;
+    auto &ring = LocalRing();
+    TraceRecord record;
+    record.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.level = msg_level;
+    record.thread = t_trace_ring.thread;
+    record.component = component;
+    record.message = message;
+    record.data = data;
+
+    if (!ring.TryPush(record)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
     }
-
-    std::cout << log_message << std::endl;
-    WriteToFile(log_message);
 }
 
 void ErplTracer::Error(const std::string &component, const std::string &message)
@@ -174,48 +323,120 @@ void ErplTracer::TraceMessage(const std::string &component, const std::string &m
     Trace(TraceLevel::TRACE, component, message, data);
 }
 
+void ErplTracer::Flush()
+{
+    Drain();
+}
+
 bool ErplTracer::Enabled() const
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    return enabled;
+    return enabled.load();
 }
 
 TraceLevel ErplTracer::CurrentLevel() const
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    return level;
+    return static_cast<TraceLevel>(level.load());
 }
 
-void ErplTracer::WriteToFile(const std::string &message)
+uint64_t ErplTracer::Dropped() const
 {
-    std::lock_guard<std::mutex> lock(trace_mutex);
-    if (!trace_file) {
-        return;
-    }
-    if (!trace_file->is_open()) {
-        return;
+    return dropped.load(std::memory_order_relaxed);
+}
+
+std::string ErplTracer::EncodeBinary(const TraceRecord &record)
+{
+    auto component_size = std::min<size_t>(record.component.size(), UINT16_MAX);
+    auto body_size = BINARY_FIXED_SIZE + component_size + record.message.size() + record.data.size();
+
+    std::string out;
+    out.reserve(4 + body_size);
+    PutU32(out, static_cast<uint32_t>(body_size));
+    PutI64(out, record.timestamp_us);
+    out += static_cast<char>(record.level);
+    PutU32(out, record.thread);
+    PutU16(out, static_cast<uint16_t>(component_size));
+    PutU32(out, static_cast<uint32_t>(record.message.size()));
+    PutU32(out, static_cast<uint32_t>(record.data.size()));
+    out.append(record.component, 0, component_size);
+    out += record.message;
+    out += record.data;
+    return out;
+}
+
+bool ErplTracer::DecodeBinary(const std::string &bytes, std::vector<TraceRecord> &records)
+{
+    if (bytes.size() < BINARY_MAGIC_SIZE || bytes.compare(0, BINARY_MAGIC_SIZE, BINARY_MAGIC) != 0) {
+        return false;
     }
 
-    (*trace_file) << message << std::endl;
-    trace_file->flush();
+    size_t pos = BINARY_MAGIC_SIZE;
+    while (bytes.size() - pos >= 4) {
+        auto body_size = GetLE(bytes, pos, 4);
+        if (body_size < BINARY_FIXED_SIZE || bytes.size() - pos - 4 < body_size) {
+            break;
+        }
+        auto body = pos + 4;
+
+        TraceRecord record;
+        record.timestamp_us = static_cast<int64_t>(GetLE(bytes, body, 8));
+        auto level_value = static_cast<unsigned char>(bytes[body + 8]);
+        record.level = level_value <= static_cast<int>(TraceLevel::TRACE) ? static_cast<TraceLevel>(level_value)
+                                                                          : TraceLevel::NONE;
+        record.thread = static_cast<uint32_t>(GetLE(bytes, body + 9, 4));
+        auto component_size = GetLE(bytes, body + 13, 2);
+        auto message_size = GetLE(bytes, body + 15, 4);
+        auto data_size = GetLE(bytes, body + 19, 4);
+        if (BINARY_FIXED_SIZE + component_size + message_size + data_size != body_size) {
+            break;
+        }
+        auto strings = body + BINARY_FIXED_SIZE;
+        record.component = bytes.substr(strings, component_size);
+        record.message = bytes.substr(strings + component_size, message_size);
+        record.data = bytes.substr(strings + component_size + message_size, data_size);
+        records.push_back(std::move(record));
+
+        pos = body + body_size;
+    }
+    return true;
 }
 
-std::string ErplTracer::GetTimestamp()
+std::string ErplTracer::FormatText(const TraceRecord &record)
 {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    auto time_t = static_cast<std::time_t>(record.timestamp_us / 1000000);
+    auto ms = (record.timestamp_us / 1000) % 1000;
 
+    // std::localtime returns a shared buffer; this runs on the writer
+    // thread and in erpl_trace_decode at once.
+    std::tm local_time {};
+#ifdef _WIN32
+    localtime_s(&local_time, &time_t);
+#else
+    localtime_r(&time_t, &local_time);
+#endif
     char buffer[32];
-    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&time_t));
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local_time);
+    char millis[8];
+    std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>(ms));
+
+    std::string log_message;
+    log_message.reserve(64 + record.component.size() + record.message.size() + record.data.size());
+    log_message += buffer;
+    log_message += millis;
+    log_message += " [";
+    log_message += LevelToString(record.level);
+    log_message += "] [";
+    log_message += record.component;
+    log_message += "] ";
+    log_message += record.message;
 
-    std::string timestamp(buffer);
-    timestamp += ".";
-    timestamp += std::to_string(ms.count());
-    return timestamp;
+    if (!record.data.empty()) {
+        log_message += "\nData: ";
+        log_message += record.data;
+    }
+    return log_message;
 }
 
-std::string ErplTracer::LevelToString(TraceLevel trace_level) const
+std::string ErplTracer::LevelToString(TraceLevel trace_level)
 {
     switch (trace_level) {
         case TraceLevel::NONE:
@@ -235,33 +456,200 @@ std::string ErplTracer::LevelToString(TraceLevel trace_level) const
     }
 }
 
-bool ErplTracer::ShouldEmit(TraceLevel msg_level) const
+TraceRing &ErplTracer::LocalRing()
 {
-    if (!enabled) {
-        return false;
+    if (!t_trace_ring.ring) {
+        t_trace_ring.ring = std::make_shared<TraceRing>();
+        t_trace_ring.thread = g_next_trace_thread.fetch_add(1);
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        rings.push_back(t_trace_ring.ring);
+    }
+    return *t_trace_ring.ring;
+}
+
+void ErplTracer::UpdateThreshold()
+{
+    auto value = enabled.load() ? level.load() : static_cast<int>(TraceLevel::NONE);
+    threshold.store(value, std::memory_order_relaxed);
+}
+
+void ErplTracer::StartWriter()
+{
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    if (writer.joinable()) {
+        return;
+    }
+    writer_stop = false;
+    writer = std::thread([this]() { WriterLoop(); });
+}
+
+void ErplTracer::StopWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        writer_stop = true;
+    }
+    writer_cv.notify_all();
+    if (writer.joinable()) {
+        writer.join();
     }
-    return static_cast<int>(msg_level) <= static_cast<int>(level);
 }
 
+void ErplTracer::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    while (!writer_stop) {
+        // Polling keeps the producers free of any wake-up; 20 ms is well
+        // below what anyone watching a trace notices.
+        writer_cv.wait_for(lock, std::chrono::milliseconds(20), [this]() { return writer_stop; });
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
+
+void ErplTracer::Drain()
+{
+    std::lock_guard<std::mutex> drain_lock(drain_mutex);
+
+    std::vector<std::shared_ptr<TraceRing>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        snapshot = rings;
+    }
+
+    std::vector<TraceRecord> records;
+    TraceRecord record;
+    for (auto &ring : snapshot) {
+        while (ring->TryPop(record)) {
+            records.push_back(std::move(record));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                   [](const std::shared_ptr<TraceRing> &ring) {
+                                       return ring->orphaned.load(std::memory_order_acquire) && ring->Empty();
+                                   }),
+                    rings.end());
+    }
+
+    auto lost = dropped.load(std::memory_order_relaxed);
+    if (lost != dropped_reported) {
+        TraceRecord note;
+        note.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        note.level = TraceLevel::WARN;
+        note.component = "TRACER";
+        note.message = std::to_string(lost - dropped_reported) + " trace messages dropped, the trace buffer was full";
+        records.push_back(std::move(note));
+        dropped_reported = lost;
+    }
+
+    if (records.empty()) {
+        return;
+    }
+    // Each ring is in order; merge the threads by time.
+    std::stable_sort(records.begin(), records.end(), [](const TraceRecord &a, const TraceRecord &b) {
+        return a.timestamp_us < b.timestamp_us;
+    });
+    Write(records);
+}
+
+void ErplTracer::Write(const std::vector<TraceRecord> &records)
+{
+    std::lock_guard<std::mutex> lock(output_mutex);
+    auto to_console = output_mode != "file";
+    auto to_file = output_mode == "file" || output_mode == "both";
+
+    if (to_console) {
+        std::string text;
+        for (auto &record : records) {
+            text += FormatText(record);
+            text += '\n';
+        }
+        std::cout << text << std::flush;
+    }
+
+    if (!to_file) {
+        return;
+    }
+    for (auto &record : records) {
+        EnsureTraceFile();
+        if (!trace_file) {
+            return;
+        }
+        if (format == TraceFormat::BINARY) {
+            auto bytes = EncodeBinary(record);
+            trace_file->write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        } else {
+            (*trace_file) << FormatText(record) << '\n';
+        }
+    }
+    trace_file->flush();
+}
+
+// Called with output_mutex held.  Leaves trace_file null if the file cannot
+// be opened or is full.
 void ErplTracer::EnsureTraceFile()
 {
-    if (trace_file && trace_file->is_open()) {
+    if (file_full) {
         return;
     }
+    auto binary = format == TraceFormat::BINARY;
+    std::filesystem::path file_path = std::filesystem::path(trace_directory) /
+                                      (binary ? "erpl_trace.bin" : "erpl_trace.log");
 
-    std::filesystem::path directory(trace_directory);
-    if (!std::filesystem::exists(directory)) {
-        std::filesystem::create_directories(directory);
+    if (!trace_file) {
+        OpenTraceFile(file_path, binary);
+        if (!trace_file) {
+            return;
+        }
+    }
+    if (max_file_size <= 0 || static_cast<int64_t>(trace_file->tellp()) < max_file_size) {
+        return;
+    }
+    trace_file.reset();
+    if (!rotation_enabled) {
+        // Full, and not to be rotated: stop writing, rather than reopen it
+        // for every drain.
+        file_full = true;
+        return;
     }
+    std::error_code ec;
+    std::filesystem::rename(file_path, file_path.string() + ".1", ec);
+    OpenTraceFile(file_path, binary);
+}
 
-    std::filesystem::path file_path = directory / "erpl_trace.log";
-    trace_file = std::make_unique<std::ofstream>(file_path, std::ios::app);
+// Called with output_mutex held.
+void ErplTracer::OpenTraceFile(const std::filesystem::path &file_path, bool binary)
+{
+    if (!std::filesystem::exists(file_path.parent_path())) {
+        std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    auto mode = std::ios::app | std::ios::ate | (binary ? std::ios::binary : std::ios::openmode());
+    trace_file = std::make_unique<std::ofstream>(file_path, mode);
     if (!trace_file->is_open()) {
         std::cerr << "Failed to open trace file: " << file_path << std::endl;
         trace_file.reset();
+        return;
+    }
+    if (binary && trace_file->tellp() == 0) {
+        trace_file->write(BINARY_MAGIC, BINARY_MAGIC_SIZE);
     }
 }
 
+void ErplTracer::CloseTraceFile()
+{
+    std::lock_guard<std::mutex> lock(output_mutex);
+    if (trace_file && trace_file->is_open()) {
+        trace_file->close();
+    }
+    trace_file.reset();
+}
+
 } // namespace erpl
 
 void erpl_trace_error(const std::string &component, const std::string &message)
@@ -313,5 +701,3 @@ void erpl_trace_trace_data(const std::string &component, const std::string &mess
 {
     erpl::ErplTracer::Instance().TraceMessage(component, message, data);
 }
-
-
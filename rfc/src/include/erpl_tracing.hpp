@@ -2,11 +2,14 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace erpl {
 
@@ -19,15 +22,50 @@ enum class TraceLevel {
     TRACE
 };
 
+// How the trace file is written: text lines (erpl_trace.log), or length-
+// prefixed binary records (erpl_trace.bin) that are cheaper to write and are
+// read back with erpl_trace_decode().  The console always gets text.
+enum class TraceFormat {
+    TEXT,
+    BINARY
+};
+
+// One message, as queued by the thread that traced it.  Timestamps and
+// formatting are left to the writer thread.
+struct TraceRecord {
+    // Microseconds since the epoch.
+    int64_t timestamp_us = 0;
+    TraceLevel level = TraceLevel::NONE;
+    // Small number of the tracing thread, in order of its first message.
+    uint32_t thread = 0;
+    std::string component;
+    std::string message;
+    std::string data;
+};
+
+class TraceRing;
+
+// Messages are queued in a lock-free ring per thread and written by a
+// background thread, so a traced call costs a level check and a few string
+// copies, never a lock or a write.  A thread that outruns the writer drops
+// messages instead of waiting; the writer reports how many.
 class ErplTracer {
 public:
     static ErplTracer &Instance();
 
+    // Whether a message at `level` would be traced: one relaxed load.  The
+    // ERPL_TRACE_* macros check it before building their arguments.
+    static bool ShouldTrace(TraceLevel msg_level)
+    {
+        return static_cast<int>(msg_level) <= threshold.load(std::memory_order_relaxed);
+    }
+
 public:
     void SetEnabled(bool enabled);
     void SetLevel(TraceLevel level);
     void SetTraceDirectory(const std::string &directory);
     void SetOutputMode(const std::string &output_mode);
+    void SetFormat(TraceFormat format);
     void SetMaxFileSize(int64_t max_size);
     void SetRotation(bool rotation);
 
@@ -45,8 +83,33 @@ public:
     void TraceMessage(const std::string &component, const std::string &message);
     void TraceMessage(const std::string &component, const std::string &message, const std::string &data);
 
+    // Writes everything queued so far before returning.
+    void Flush();
+
+    // Every database that loads the extension holds the tracer; when the
+    // last one closes, the writer thread is stopped and the file closed.
+    // That is not left to the static destructor: joining a thread there
+    // deadlocks on Windows, which runs it under the loader lock.
+    void AttachDatabase();
+    void DetachDatabase();
+
     bool Enabled() const;
     TraceLevel CurrentLevel() const;
+    // Messages dropped because their thread's ring was full.
+    uint64_t Dropped() const;
+
+    // Binary trace file format.  The file starts with BINARY_MAGIC; each
+    // record is a little-endian u32 length of the rest, then i64 timestamp,
+    // u8 level, u32 thread, u16 component length, u32 message length, u32
+    // data length, and the three strings.
+    static constexpr const char *BINARY_MAGIC = "ERPLTRC1";
+    static constexpr size_t BINARY_MAGIC_SIZE = 8;
+    static std::string EncodeBinary(const TraceRecord &record);
+    // Decodes a binary trace file's content.  Returns false if it does not
+    // start with BINARY_MAGIC; a record cut off at the end is ignored.
+    static bool DecodeBinary(const std::string &bytes, std::vector<TraceRecord> &records);
+    static std::string FormatText(const TraceRecord &record);
+    static std::string LevelToString(TraceLevel level);
 
 private:
     ErplTracer();
@@ -57,23 +120,54 @@ public:
     ErplTracer &operator=(const ErplTracer &) = delete;
 
 private:
-    void WriteToFile(const std::string &message);
-    std::string GetTimestamp();
-    std::string LevelToString(TraceLevel level) const;
-    bool ShouldEmit(TraceLevel level) const;
+    // The level messages are traced at while enabled, NONE otherwise.
+    static inline std::atomic<int> threshold{0};
+
+    TraceRing &LocalRing();
+    void UpdateThreshold();
+    void StartWriter();
+    void StopWriter();
+    void WriterLoop();
+    // Moves every queued message to the outputs.  Serialised by drain_mutex,
+    // which makes the writer thread and Flush() the rings' only consumer.
+    void Drain();
+    void Write(const std::vector<TraceRecord> &records);
     void EnsureTraceFile();
+    void OpenTraceFile(const std::filesystem::path &file_path, bool binary);
+    void CloseTraceFile();
 
 private:
-    mutable std::mutex trace_mutex;
-    bool enabled = false;
-    TraceLevel level = TraceLevel::INFO;
+    std::atomic<bool> enabled{false};
+    std::atomic<int> level{static_cast<int>(TraceLevel::INFO)};
+    std::atomic<uint64_t> dropped{0};
+    uint64_t dropped_reported = 0;
 
-private:
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;
+
+    std::mutex drain_mutex;
+
+    // Serialises turning tracing on and off, and the writer's start and stop.
+    std::mutex enable_mutex;
+    uint32_t databases = 0;
+
+    std::mutex writer_mutex;
+    std::condition_variable writer_cv;
+    std::thread writer;
+    bool writer_stop = false;
+    bool writer_wake = false;
+
+    // Output settings and the file; used by the writer under output_mutex.
+    mutable std::mutex output_mutex;
     std::string trace_directory;
     std::string output_mode;
+    TraceFormat format = TraceFormat::TEXT;
     int64_t max_file_size = 0;
     bool rotation_enabled = false;
     std::unique_ptr<std::ofstream> trace_file;
+    // Set once the file reached max_file_size with rotation off; nothing is
+    // written to it until one of the output settings changes.
+    bool file_full = false;
 };
 
 } // namespace erpl
@@ -89,15 +183,34 @@ void erpl_trace_debug_data(const std::string &component, const std::string &mess
 void erpl_trace_trace(const std::string &component, const std::string &message);
 void erpl_trace_trace_data(const std::string &component, const std::string &message, const std::string &data);
 
-#define ERPL_TRACE_ERROR(component, message) erpl_trace_error((component), (message))
-#define ERPL_TRACE_ERROR_DATA(component, message, data) erpl_trace_error_data((component), (message), (data))
-#define ERPL_TRACE_WARN(component, message) erpl_trace_warn((component), (message))
-#define ERPL_TRACE_WARN_DATA(component, message, data) erpl_trace_warn_data((component), (message), (data))
-#define ERPL_TRACE_INFO(component, message) erpl_trace_info((component), (message))
-#define ERPL_TRACE_INFO_DATA(component, message, data) erpl_trace_info_data((component), (message), (data))
-#define ERPL_TRACE_DEBUG(component, message) erpl_trace_debug((component), (message))
-#define ERPL_TRACE_DEBUG_DATA(component, message, data) erpl_trace_debug_data((component), (message), (data))
-#define ERPL_TRACE_TRACE(component, message) erpl_trace_trace((component), (message))
-#define ERPL_TRACE_TRACE_DATA(component, message, data) erpl_trace_trace_data((component), (message), (data))
+// The arguments are only evaluated if the level is traced, so a
+// StringUtil::Format or a joined OPTIONS list costs nothing otherwise.
+#define ERPL_TRACE_AT(level, call)                                                                                     \
+    do {                                                                                                               \
+        if (erpl::ErplTracer::ShouldTrace(level)) {                                                                    \
+            call;                                                                                                      \
+        }                                                                                                              \
+    } while (0)
+
+#define ERPL_TRACE_ERROR(component, message) \
+    ERPL_TRACE_AT(erpl::TraceLevel::ERROR, erpl_trace_error((component), (message)))
+#define ERPL_TRACE_ERROR_DATA(component, message, data) \
+    ERPL_TRACE_AT(erpl::TraceLevel::ERROR, erpl_trace_error_data((component), (message), (data)))
+#define ERPL_TRACE_WARN(component, message) \
+    ERPL_TRACE_AT(erpl::TraceLevel::WARN, erpl_trace_warn((component), (message)))
+#define ERPL_TRACE_WARN_DATA(component, message, data) \
+    ERPL_TRACE_AT(erpl::TraceLevel::WARN, erpl_trace_warn_data((component), (message), (data)))
+#define ERPL_TRACE_INFO(component, message) \
+    ERPL_TRACE_AT(erpl::TraceLevel::INFO, erpl_trace_info((component), (message)))
+#define ERPL_TRACE_INFO_DATA(component, message, data) \
+    ERPL_TRACE_AT(erpl::TraceLevel::INFO, erpl_trace_info_data((component), (message), (data)))
+#define ERPL_TRACE_DEBUG(component, message) \
+    ERPL_TRACE_AT(erpl::TraceLevel::DEBUG_LEVEL, erpl_trace_debug((component), (message)))
+#define ERPL_TRACE_DEBUG_DATA(component, message, data) \
+    ERPL_TRACE_AT(erpl::TraceLevel::DEBUG_LEVEL, erpl_trace_debug_data((component), (message), (data)))
+#define ERPL_TRACE_TRACE(component, message) \
+    ERPL_TRACE_AT(erpl::TraceLevel::TRACE, erpl_trace_trace((component), (message)))
+#define ERPL_TRACE_TRACE_DATA(component, message, data) \
+    ERPL_TRACE_AT(erpl::TraceLevel::TRACE, erpl_trace_trace_data((component), (message), (data)))
 
 
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include "sap_connection.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace duckdb {
+
+struct SapTableSchema {
+	vector<Value> field_metas;
+	vector<string> names;
+	vector<LogicalType> types;
+};
+
+// ---------------------------------------------------------------------------
+// SapAttachWarmup — background connection warm-up and DDIC discovery
+//
+// `ATTACH ... (TYPE sap_rfc, WARM_CONNECTIONS n, PREFETCH_SCHEMA true)`
+// moves the logon and metadata latency of the first queries off the
+// interactive path:
+//
+//   - WARM_CONNECTIONS n opens n connections in the background and parks
+//     them in the process-wide RfcConnectionPool, from which the next
+//     RfcAuthParams::Connect() calls are served without a logon.
+//   - PREFETCH_SCHEMA fetches the DDIC field list of every TABLES entry
+//     concurrently, so catalog lookups (and the scan bind, which re-uses the
+//     entry's DDIC rows) find the schema already resolved.
+//
+// The same discovery workers back bulk catalog population: the first time
+// the catalog is enumerated (SHOW TABLES, information_schema.columns,
+// duckdb_columns()), every TABLES entry not yet resolved is queued at once
+// and discovered over up to erpl_rfc_catalog_discovery_threads pooled
+// connections, instead of one DDIF_FIELDINFO_GET round-trip after another.
+//
+// The threads capture only a copy of the auth parameters — never the
+// attaching ClientContext, which may be gone before they finish.  The
+// generator owning this object cancels and joins them on DETACH; each
+// thread stops after at most one in-flight RFC call.
+// ---------------------------------------------------------------------------
+class SapAttachWarmup {
+public:
+	// Upper bounds keep a typo (WARM_CONNECTIONS 1000) from exhausting the
+	// SAP gateway; see erpl_rfc_max_persistent_connections for the reasoning.
+	static constexpr idx_t MAX_WARM_CONNECTIONS = 64;
+	static constexpr idx_t MAX_PREFETCH_THREADS = 4;
+	static constexpr idx_t MAX_DISCOVERY_THREADS = 64;
+
+	// Resolves the schema of one table on a discovery worker.  `connection`
+	// is the worker's own: opened by the lookup on first use, kept for the
+	// worker's next table, and parked in the pool when the worker is done.
+	using SchemaLookup = std::function<SapTableSchema(RfcAuthParams &auth_params,
+	                                                  std::shared_ptr<RfcConnection> &connection, const string &table)>;
+
+	SapAttachWarmup(RfcAuthParams auth_params_p, idx_t warm_connections, const vector<string> &prefetch_tables,
+	                SchemaLookup lookup_p = LookupDdicSchema);
+	~SapAttachWarmup();
+
+	// Queues every table of `tables` that is neither resolved nor in flight,
+	// and tops the discovery workers up to `max_threads` (never more than
+	// there are queued tables).
+	void Prefetch(const vector<string> &tables, idx_t max_threads);
+
+	// Returns the prefetched schema of `table`, waiting if it is still being
+	// fetched.  False if it was never queued or its prefetch failed — the
+	// caller then discovers it itself (and reports any error).
+	bool TryGetSchema(const string &table, SapTableSchema &schema);
+
+	// DDIF_FIELDINFO_GET over a pooled connection; what every ATTACH uses.
+	static SapTableSchema LookupDdicSchema(RfcAuthParams &auth_params, std::shared_ptr<RfcConnection> &connection,
+	                                       const string &table);
+
+private:
+	void WarmConnection();
+	void PrefetchSchemas();
+
+	RfcAuthParams auth_params;
+	string pool_key;
+	SchemaLookup lookup;
+
+	std::mutex lock;
+	std::condition_variable cv;
+	bool cancelled = false;
+	std::deque<string> queue;
+	// Tables queued or in flight; TryGetSchema waits until a name leaves it.
+	case_insensitive_set_t pending;
+	case_insensitive_map_t<SapTableSchema> schemas;
+	idx_t prefetch_workers = 0;
+
+	// Only grows (Prefetch may add workers after construction); everything
+	// in it is joined by the destructor.
+	vector<std::thread> threads;
+};
+
+} // namespace duckdb
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <mutex>
+
 #include "duckdb.hpp"
 #include "sap_rfc_api.hpp"
 #include "sap_secret.hpp"
@@ -12,6 +16,7 @@ namespace duckdb
 		std::string host;
 		std::string partner_host;
 		std::string sys_number;
+		std::string sys_id;
 		std::string client;
 		std::string user;
 		std::string language;
@@ -44,11 +49,29 @@ namespace duckdb
     {
         RFC_CONNECTION_HANDLE handle;
 
+        // Key under which RfcConnectionPool::Release parks this connection;
+        // set by RfcAuthParams::OpenConnection.  Empty means "never pool".
+        std::string pool_key;
+        // Set by RfcConnectionPool::TryTake: this connection's logon was
+        // made for an earlier user.
+        bool reused_from_pool = false;
+
         RfcConnection(RFC_CONNECTION_HANDLE handle);
         ~RfcConnection();
 
 		void Close();
         void Ping();
+		// Like Ping(), but reports a failure instead of throwing.
+		bool TryPing();
+		// Aborts the call another thread is blocked in on this handle
+		// (RfcCancel).  The SDK closes the connection as part of it, so the
+		// connection must not be used or pooled afterwards.  Never throws.
+		void Cancel();
+		// Ends the ABAP session state of the calls made so far
+		// (RfcResetServerContext): open LUWs, function group globals and
+		// buffers, while keeping the logon.  False if that failed and the
+		// connection is unusable.  Never throws.
+		bool ResetServerContext();
 		RfcConnectionAttributes ConnectionAttributes();
     } RfcConnection;
 
@@ -105,7 +128,19 @@ namespace duckdb
 
 		static RfcAuthParams FromContext(ClientContext &context, const string &secret_name = SAP_SECRET_DEFAULT_PATH);
 		string ToString();
+		// Hands out a parked connection for these parameters if one is
+		// available (see RfcConnectionPool), else logs on.
 		std::shared_ptr<RfcConnection> Connect();
+		// Always performs a fresh RfcOpenConnection logon.
+		std::shared_ptr<RfcConnection> OpenConnection();
+
+		// Identifies connections that are interchangeable: same target, same
+		// credentials.  In-process only; it contains credential material and
+		// must never be logged or rendered.
+		string PoolKey() const;
+		// Identifies the SAP system and client a connection goes to, without
+		// user or credentials, as a hash; for the scan history.
+		string SystemFingerprint() const;
 
 		// The (name, value) pairs handed to RfcOpenConnection, in table order and
 		// with unset parameters omitted — the SDK treats an empty value as an
@@ -132,6 +167,57 @@ namespace duckdb
 
 	const vector<RfcAuthParamDefinition> &RfcAuthParamDefinitions();
 
+	/**
+	 * @brief Process-wide parking lot for idle, already logged-on connections.
+	 *
+	 * Filled ahead of demand (ATTACH ... WARM_CONNECTIONS n) and drained by
+	 * RfcAuthParams::Connect, so the first queries against an attached system
+	 * skip the logon round-trip.  A parked connection is handed out at most
+	 * once — callers close it as usual when done.  Connections idle for longer
+	 * than MAX_IDLE are discarded whenever a connection is parked or taken,
+	 * and at most MAX_PARKED_PER_KEY stay parked per key.  Gateways and
+	 * firewalls may drop an idle session much earlier, so one idle for
+	 * PING_AFTER_IDLE or more is pinged before it is handed out, and closed
+	 * in favour of the next one (or a new logon) if that fails.
+	 *
+	 * The pool is never destroyed: a static destructor may run after the SDK
+	 * is unloaded, and closing handles then would crash the process on exit.
+	 * Whatever is parked at exit is dropped with the process.
+	 */
+	class RfcConnectionPool
+	{
+		public:
+			static constexpr std::chrono::seconds MAX_IDLE = std::chrono::seconds(300);
+			static constexpr std::chrono::seconds PING_AFTER_IDLE = std::chrono::seconds(30);
+			static constexpr idx_t MAX_PARKED_PER_KEY = 16;
+
+			static RfcConnectionPool &Get();
+
+			// Parks a freshly logged-on connection.  `idle_for` backdates it as
+			// if it had been parked that long ago; exposed for testing.
+			void Park(const string &key, std::shared_ptr<RfcConnection> connection,
+			          std::chrono::steady_clock::duration idle_for = std::chrono::steady_clock::duration::zero());
+			// Hands a connection that is done with its work back: its server
+			// context is reset and it is parked under its pool_key when it has
+			// one, closed otherwise.  Only for connections in a clean state —
+			// not after a failed or cancelled call.
+			void Release(std::shared_ptr<RfcConnection> connection);
+			// A parked connection for `key` that answered a ping if it was idle
+			// for PING_AFTER_IDLE or more; nullptr if there is none.
+			std::shared_ptr<RfcConnection> TryTake(const string &key);
+			idx_t Size(const string &key);
+			void Clear();
+
+		private:
+			struct ParkedConnection {
+				std::shared_ptr<RfcConnection> connection;
+				std::chrono::steady_clock::time_point parked_at;
+			};
+
+			std::mutex lock;
+			std::unordered_map<string, std::deque<ParkedConnection>> parked;
+	};
+
 	// Maps an RFC_RC failure code to an enumerated telemetry error_class
 	// (auth_error|connection_failed|timeout|rfc_error). Code-controlled enum in,
 	// enum out — never inspects or forwards the SAP error message.
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+
+namespace duckdb {
+
+// One partition of a sap_extract job that is safely on disk.
+struct SapExtractPartition {
+	idx_t index = 0;
+	idx_t row_offset = 0;
+	idx_t rows = 0;
+	// Relative to the target directory.
+	string file;
+};
+
+// The checkpoint of a sap_extract job, and the place where the processes
+// that share it hand out its partitions: a text file in the target
+// directory with one line describing the job, one line per claim and one
+// line per completed partition,
+//
+//   job    <table> <partition rows> <columns> <filter>
+//   claim  <index> <owner> <expiry, ms since the epoch>
+//   part   <index> <row offset> <rows> <file>
+//
+// tab-separated.  Every read and write happens under an exclusive lock on
+// the file, so processes on one host, or on a file system with working
+// locks, see each other's claims.  A claim expires unless its owner renews
+// it; one with expiry 0 is released.  A partition is recorded only after
+// its Parquet file has been renamed into place, and each line is synced
+// before the lock is released, so after a crash the manifest never lists a
+// file that is not complete.  A torn last line is cut off.
+class SapExtractManifest {
+public:
+	static constexpr const char *FILE_NAME = "_sap_extract_manifest.tsv";
+	// How long to retry while another process holds the lock.
+	static constexpr int64_t LOCK_TIMEOUT_MS = 30000;
+
+	enum class ClaimResult : uint8_t {
+		CLAIMED,
+		// Every partition left is claimed by someone else; try again later.
+		BUSY,
+		DONE
+	};
+
+	SapExtractManifest(FileSystem &fs, string directory);
+
+	// Reads the manifest, if there is one, and records `job` in a new one.
+	// Throws if the directory holds a different job: resuming it with other
+	// arguments would mix two extractions.
+	void Open(const string &job);
+
+	// Claims the first partition that is neither recorded nor claimed, until
+	// `now_ms + lease_ms`.  With the number of partitions not yet known, a
+	// partition past the end may be claimed; it reads no rows.
+	ClaimResult Claim(const string &owner, int64_t now_ms, int64_t lease_ms, idx_t &index);
+	// Extends the claims of `owner` on `indexes` until `now_ms + lease_ms`.
+	// Returns the partitions whose claim is no longer its own, because it
+	// expired or was taken over; those are not renewed.
+	vector<idx_t> Renew(const string &owner, const vector<idx_t> &indexes, int64_t now_ms, int64_t lease_ms);
+	void Release(const string &owner, idx_t index);
+	void Record(const SapExtractPartition &partition);
+
+	// As of the last time the file was read.
+	bool IsDone(idx_t index);
+	// The number of partitions of the table, once a partition shorter than
+	// `partition_rows` is recorded; DConstants::INVALID_INDEX before that.
+	idx_t PartitionCount(idx_t partition_rows);
+	vector<SapExtractPartition> Partitions();
+
+	// Line format, exposed for testing.
+	static string FormatJob(const string &table, idx_t partition_rows, const vector<string> &columns,
+	                        const string &filter);
+	static string FormatPartition(const SapExtractPartition &partition);
+	static bool ParsePartition(const string &line, SapExtractPartition &partition);
+
+private:
+	struct Claimed {
+		string owner;
+		int64_t expiry_ms = 0;
+	};
+
+	// Runs `action` with the file open, locked, and read up to its end.
+	void Locked(const std::function<void(FileHandle &)> &action);
+	void ReadNewLines(FileHandle &handle);
+	void Apply(const string &line);
+	void Append(FileHandle &handle, const string &line);
+	idx_t PartitionCountLocked(idx_t partition_rows);
+
+	FileSystem &fs;
+	string directory;
+	string path;
+	// Set on Open(), for PartitionCount() within Claim().
+	idx_t partition_rows = 0;
+
+	std::mutex lock;
+	string job;
+	std::map<idx_t, SapExtractPartition> partitions;
+	std::map<idx_t, Claimed> claims;
+	// How far the file has been read; always at the start of a line.
+	idx_t read_offset = 0;
+};
+
+} // namespace duckdb
@@ -57,6 +57,7 @@ bool GetRfcStrictTypeCheck();
             virtual ~RfcType();
 
             bool IsComplexType() const;
+            RFCTYPE GetRfcTypeAsEnum() const;
             std::string GetName() const;
             unsigned int GetLength() const;
             unsigned int GetDecimals() const;
@@ -143,8 +144,19 @@ bool GetRfcStrictTypeCheck();
     {
         public:
             RfcFunction(std::shared_ptr<RfcConnection> &connection, std::string function_name);
+            // Wraps an already resolved descriptor (see RfcMetadataCache);
+            // no RfcGetFunctionDesc round-trip.
+            RfcFunction(std::shared_ptr<RfcConnection> &connection, std::string function_name,
+                        RFC_FUNCTION_DESC_HANDLE desc_handle);
             ~RfcFunction() noexcept;
 
+            // RfcGetFunctionDesc plus the SDK exit-guard bookkeeping every
+            // successful lookup needs.  Returns NULL and fills `error_info`
+            // on failure instead of throwing.
+            static RFC_FUNCTION_DESC_HANDLE LookupDescription(RFC_CONNECTION_HANDLE connection_handle,
+                                                              const std::string &function_name,
+                                                              RFC_ERROR_INFO &error_info);
+
             RFC_FUNCTION_DESC_HANDLE GetDescriptionHandle() const;
 
             std::string GetName();
@@ -227,10 +239,37 @@ bool GetRfcStrictTypeCheck();
             void SelectResultAndDeactivateOthers(RfcFunctionParameterDesc &param_desc);
             void SelectResultAndDeactivateOthers(std::vector<std::string> &param_names);
             void SelectResultAndDeactivateOthers(std::vector<unsigned int> &col_idxs);
+            // Deactivates every result parameter except the first token of
+            // `path`, so the server does not send data the caller never reads.
+            // TABLES and CHANGING parameters that carry an argument stay
+            // active, since deactivating them would also drop the input.
+            void DeactivateResultsOutsidePath(const std::string &path);
+            // Same rule for an explicit list of result parameters to keep.
+            void DeactivateResultsExcept(const std::vector<std::string> &keep);
+            // Called by the adapters for every parameter they fill.
+            void MarkParameterSupplied(const std::string &param_name);
+            // Handle of a TABLES or CHANGING table parameter, for callers that
+            // fill it row by row (RfcTableAppender).  Marks it as supplied.
+            RFC_TABLE_HANDLE GetTableParameter(const std::string &param_name);
 
             RFC_FUNCTION_HANDLE GetFunctionHandle() const;
             DATA_CONTAINER_HANDLE GetDataContainerHandle() const;
 
+            // Prepared-invocation support.  An invocation may be executed
+            // more than once: the constructor fills the static arguments,
+            // SetParameter overwrites a single import (e.g. a paging offset)
+            // in place, and ClearResultTables empties the tables filled by
+            // the previous call.  The SDK ships every TABLES parameter in
+            // both directions, so without the clear the last call's result
+            // rows would be sent back to the server.
+            void SetParameter(const std::string &param_name, Value value);
+            void ClearResultTables(const std::set<std::string> &input_tables);
+            // Both of the above for the next call.  False when the handle
+            // cannot be reused, e.g. on a backend that rejects
+            // RfcDeleteAllRows; the caller then builds a new invocation.
+            bool PrepareNextCall(const std::set<std::string> &input_tables,
+                                 const std::vector<std::pair<std::string, Value>> &parameters);
+
         private:
             bool IsAdaptByPosition(std::vector<Value> &arguments);
             RFC_FUNCTION_HANDLE CreateRfcFunctionHandle(std::shared_ptr<RfcFunction> function);
@@ -238,10 +277,132 @@ bool GetRfcStrictTypeCheck();
 
             std::shared_ptr<RfcFunction> _function;
             std::vector<Value> _arguments;
+            std::set<std::string> _supplied_params;
             RFC_FUNCTION_HANDLE _handle;
     };
 
 
+    /**
+     * @brief Fills an RFC table (a TABLES or CHANGING parameter) from DuckDB
+     *        data chunks.
+     *
+     * The mapping from input columns to fields of the table's line type is
+     * resolved once.  Each chunk is then cast column-wise to the DuckDB type
+     * closest to the field's RFC type and written with the typed SDK setters.
+     * No per-cell duckdb::Value and no field lookup by name are involved.
+     * Nested structure/table fields and UTC timestamps fall back to
+     * RfcType::AdaptValue.
+     */
+    class RfcTableAppender
+    {
+        public:
+            // Input columns are matched to fields by upper-cased name.  A line
+            // type with a single unnamed field (a table of an elementary type)
+            // takes a single input column of any name.
+            RfcTableAppender(std::shared_ptr<RfcType> table_type, const std::string &param_name,
+                             const std::vector<std::string> &column_names,
+                             const std::vector<LogicalType> &column_types);
+
+            void Append(RFC_TABLE_HANDLE table_handle, DataChunk &chunk);
+            idx_t RowCount() const;
+
+        private:
+            struct Column {
+                idx_t input_idx;
+                std::string field_name;
+                unique_ptr<SAP_UC, void (*)(void*)> uc_field_name;
+                RFCTYPE rfc_type;
+                std::shared_ptr<RfcType> type;
+                // INVALID for columns that take the AdaptValue fallback.
+                LogicalType staging_type;
+            };
+
+            std::string _param_name;
+            std::vector<Column> _columns;
+            std::vector<SAP_UC> _uc_buffer;
+            idx_t _row_count = 0;
+
+    };
+
+    /**
+     * @brief Sets import parameters of an invocation from a row of a DuckDB
+     *        data chunk.
+     *
+     * The counterpart of RfcTableAppender for the scalar parameters of
+     * calls made once per input row.  Input columns are matched to
+     * parameters once, with their SAP_UC names.  Stage casts a chunk
+     * column-wise, and Adapt then writes one row with the typed SDK
+     * setters.  Text is converted into a per-thread buffer with its
+     * explicit length, so there is no per-call allocation and embedded
+     * NULs survive.  Structure and table parameters and UTC timestamps
+     * fall back to RfcType::AdaptValue.
+     */
+    class RfcImportAdapter
+    {
+        public:
+            // The columns of one input chunk, cast once for all its rows.
+            struct Batch {
+                DataChunk *chunk = nullptr;
+                std::vector<unique_ptr<Vector>> staged;
+                std::vector<UnifiedVectorFormat> formats;
+            };
+
+            // Input columns are matched to import, changing and tables
+            // parameters by upper-cased name.
+            RfcImportAdapter(RfcFunction &function, const std::vector<std::string> &column_names,
+                             const std::vector<LogicalType> &column_types);
+
+            void Stage(DataChunk &chunk, Batch &batch) const;
+            // Safe to call from several threads for different invocations
+            // of the same batch.  NULL cells leave the parameter untouched.
+            void Adapt(RfcInvocation &invocation, const Batch &batch, idx_t row_idx) const;
+
+        private:
+            struct Column {
+                std::string param_name;
+                unique_ptr<SAP_UC, void (*)(void*)> uc_param_name;
+                RFCTYPE rfc_type;
+                std::shared_ptr<RfcType> type;
+                // INVALID for columns that take the AdaptValue fallback.
+                LogicalType staging_type;
+            };
+
+            std::vector<Column> _columns;
+    };
+
+    /**
+     * @brief Reads one SDK field straight into a DuckDB vector.
+     *
+     * The layout is resolved once from the type descriptors: the field
+     * names as SAP_UC, and a child layout per field of a structure or table
+     * line.  Write then fills StructVector children and ListVector entries
+     * directly, so a deep BAPI result never becomes a nested Value tree.
+     * Its vector type is the one RfcType::CreateDuckDbType declares.
+     */
+    class RfcVectorLayout
+    {
+        public:
+            RfcVectorLayout(const std::string &field_name, std::shared_ptr<RfcType> rfc_type);
+
+            // Reads this field of `container_handle` into `target[row_idx]`.
+            void Write(DATA_CONTAINER_HANDLE container_handle, Vector &target, idx_t row_idx) const;
+
+        private:
+            std::string _field_name;
+            std::shared_ptr<SAP_UC> _uc_field_name;
+            std::shared_ptr<RfcType> _rfc_type;
+            RFCTYPE _rfc_kind;
+            std::vector<RfcVectorLayout> _children;
+            // A table line with a single unnamed field is a LIST of that
+            // field's type, not of a STRUCT (see CreateDuckDbTypeForRfcTable).
+            bool _unwrap_line;
+
+            void WriteElementary(DATA_CONTAINER_HANDLE container_handle, Vector &target, idx_t row_idx) const;
+            void WriteFields(DATA_CONTAINER_HANDLE struct_handle, Vector &target, idx_t row_idx) const;
+            void WriteTable(RFC_TABLE_HANDLE table_handle, Vector &target, idx_t row_idx) const;
+    };
+
+
     /**
      * @brief A class taking a `RfcInvocation` and streaming its results back.
     */
@@ -264,9 +425,17 @@ bool GetRfcStrictTypeCheck();
 
             unsigned int TotalRows();
             bool IsTabularResult();
+            // True when rows are read window by window from the SDK table
+            // handle instead of from a converted duckdb::Value tree.
+            bool IsStreaming() const;
 
             std::string ToSQLString();
 
+            // Result columns for `path`, derived from the function descriptor
+            // alone (no RFC call).  Throws if the path does not resolve.
+            static std::pair<std::vector<std::string>, std::vector<LogicalType>> InferResultSchema(
+                RfcFunction &function, std::string path);
+
             static std::shared_ptr<RfcResultSet> InvokeFunction(
                 std::shared_ptr<RfcConnection> connection,
                 std::string function_name,
@@ -293,12 +462,30 @@ bool GetRfcStrictTypeCheck();
             std::vector<Value> _result_data;
             unsigned int _total_rows;
             unsigned int _current_row_idx;
+
+            // Streaming reader.  When `path` ends in a TABLES parameter (or a
+            // table nested in structures), FetchNextResult walks the SDK table
+            // handle directly, one STANDARD_VECTOR_SIZE window at a time, and
+            // converts only the cells it writes.  Memory stays at the SDK
+            // buffer the call already holds.  _result_data is then only filled
+            // if a caller asks for the whole result as a Value.
+            RFC_TABLE_HANDLE _table_handle;
+            // Single-row reader, for no path or a path ending in a structure:
+            // the function or structure handle the columns are fields of.
+            DATA_CONTAINER_HANDLE _row_container;
+            // One layout per result column, in _result_names order.
+            std::vector<RfcVectorLayout> _column_layouts;
+            bool _materialized;
+
+            bool OpenDirectReader(std::string path);
+            void EnsureMaterialized();
+            unsigned int FetchNextStreamedResult(DataChunk &output, std::vector<std::string> &selected_fields);
+            unsigned int FetchDirectRow(DataChunk &output, std::vector<std::string> &selected_fields);
             
-            std::pair<std::vector<std::string>, std::vector<LogicalType>> InferResultSchema(std::string path);
-            std::vector<LogicalType> ExtractResultTypes(std::vector<RfcFunctionParameterDesc> &param_infos);
-            std::vector<LogicalType> ExtractResultTypes(std::vector<RfcFieldDesc> &field_infos);
-            std::vector<std::string> ExtractResultNames(std::vector<RfcFunctionParameterDesc> &param_infos);
-            std::vector<std::string> ExtractResultNames(std::vector<RfcFieldDesc> &field_infos);
+            static std::vector<LogicalType> ExtractResultTypes(std::vector<RfcFunctionParameterDesc> &param_infos);
+            static std::vector<LogicalType> ExtractResultTypes(std::vector<RfcFieldDesc> &field_infos);
+            static std::vector<std::string> ExtractResultNames(std::vector<RfcFunctionParameterDesc> &param_infos);
+            static std::vector<std::string> ExtractResultNames(std::vector<RfcFieldDesc> &field_infos);
 
             std::vector<Value> ConvertValuesAndSelectPath(std::string path);
             std::vector<Value> ConvertResultValues(std::vector<RfcFunctionParameterDesc> &param_infos);
@@ -318,11 +505,6 @@ bool GetRfcStrictTypeCheck();
 
         std::shared_ptr<RfcInvocation> invocation;
         std::shared_ptr<RfcResultSet> result_set;
-        // When the called RFC has no export/changing/table parameters
-        // (e.g. RFC_PING), we synthesize a single boolean 'ok' column.
-        // `ok_only` flags that mode; `ok_only_emitted` tracks the one row.
-        bool ok_only = false;
-        bool ok_only_emitted = false;
 
         std::vector<std::string> GetFieldNames();
         std::vector<std::string> GetResultNames();
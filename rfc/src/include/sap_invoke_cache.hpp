@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "duckdb.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+
+#include "sap_connection.hpp"
+
+namespace duckdb
+{
+	// Lifetime of a cached sap_rfc_invoke result in seconds.  Default 0, which
+	// disables the cache; setting it to 0 also drops everything cached so far.
+	// Wired to `erpl_rfc_invoke_cache_ttl`.
+	void SetRfcInvokeCacheTtl(unsigned int seconds);
+	unsigned int GetRfcInvokeCacheTtl();
+
+	// Upper bound on the bytes held by cached results, least recently used
+	// evicted first.  Wired to `erpl_rfc_invoke_cache_max_memory`.
+	void SetRfcInvokeCacheMaxMemory(idx_t bytes);
+	idx_t GetRfcInvokeCacheMaxMemory();
+
+	// Comma-separated function module names, `*` as wildcard, whose results
+	// may be cached.  Wired to `erpl_rfc_invoke_cache_functions`.
+	void SetRfcInvokeCacheFunctions(const std::string &patterns);
+	std::string GetRfcInvokeCacheFunctions();
+
+	/**
+	 * @brief Process-wide cache of sap_rfc_invoke results, with single-flight.
+	 *
+	 * Only function modules on the allow-list are cached, and only while the
+	 * TTL is non-zero: the cache cannot tell a read from a write, so what is
+	 * side-effect free is left to the user.  A result is the full output of
+	 * the call for one path, every column, kept as a ColumnDataCollection and
+	 * scanned by any number of statements at once.
+	 *
+	 * Identical calls that arrive while the first one is still in flight
+	 * wait for it and share its result instead of making their own.  A failed
+	 * call is not cached; its waiters see the same error.
+	 */
+	class RfcInvokeCache
+	{
+		public:
+			using Result = std::shared_ptr<const ColumnDataCollection>;
+
+			// Read-only by SAP's BAPI conventions (GetList / GetDetail) or by
+			// definition; anything else has to be allowed explicitly.
+			static constexpr const char *DEFAULT_FUNCTIONS =
+				"BAPI_*_GETLIST,BAPI_*_GETDETAIL,RFC_READ_TEXT,RFC_SYSTEM_INFO,RFC_GET_FUNCTION_INTERFACE";
+			static constexpr idx_t DEFAULT_MAX_MEMORY = 64ULL * 1024 * 1024;
+
+			static RfcInvokeCache &Get();
+
+			// True when the cache is on and `function_name` is on the allow-list.
+			static bool IsCacheable(const std::string &function_name);
+			// Pure helper behind IsCacheable, exposed for offline testing.
+			static bool MatchesAllowList(const std::string &patterns, const std::string &function_name);
+
+			// Results depend on the system, client and user (authorizations),
+			// on the function and path, and on the arguments as serialized JSON
+			// including their types.
+			static std::string Key(const RfcConnectionAttributes &attributes, const std::string &function_name,
+			                       const std::string &path, const std::vector<Value> &arguments);
+
+			// Returns the cached result for `key`, or runs `invoke` once for all
+			// concurrent callers and caches what it returns, if `function_name`
+			// is still cacheable by then.
+			Result GetOrInvoke(const std::string &key, const std::string &function_name,
+			                   const std::function<Result()> &invoke);
+
+			// Drops every result and forgets the calls in flight: their results
+			// are handed to their waiters but not cached.
+
+			void Clear();
+			idx_t Size();
+			idx_t MemoryUsage();
+
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			struct Entry {
+				Result result;
+				idx_t size = 0;
+				Clock::time_point expires;
+				std::list<std::string>::iterator lru_position;
+			};
+
+			std::mutex lock;
+			std::map<std::string, Entry> entries;
+			// Most recently used first.
+			std::list<std::string> lru;
+			std::map<std::string, std::shared_future<Result>> in_flight;
+			idx_t memory_usage = 0;
+			// Bumped by Clear(), so a call that started before does not touch
+			// the in-flight entry or the cache afterwards.
+			idx_t generation = 0;
+
+			bool TryGet(const std::string &key, Result &result);
+			void Insert(const std::string &key, const std::string &function_name, Result result);
+			void Erase(std::map<std::string, Entry>::iterator it);
+	};
+} // namespace duckdb
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "duckdb.hpp"
+#include "sap_rfc_api.hpp"
+#include "sap_connection.hpp"
+#include "sap_function.hpp"
+
+namespace duckdb
+{
+	// Toggle for the process-wide function-descriptor / capability cache.
+	// Default true.  Wired to the `erpl_rfc_metadata_cache` extension option;
+	// turning it off also drops everything cached so far.
+	void SetRfcMetadataCache(bool enabled);
+	bool GetRfcMetadataCache();
+
+	/**
+	 * @brief What one RFC_READ_TABLE variant looks like on one SAP system.
+	 *
+	 * Everything sap_read_table needs to know about a read function before it
+	 * can build its arguments, derived once from the function descriptor and
+	 * then shared by every bind against the same system.
+	 */
+	struct RfcReadTableCapabilities
+	{
+		std::string function_name;
+		// ET_DATA result table is present (string-capable variants).
+		bool has_et_data = false;
+		// USE_ET_DATA_4_RETURN import parameter *and* ET_DATA are present.
+		bool has_et_data_switch = false;
+		// "/TBLOUTxxxx" (largest bucket first), "/DATA", or empty if neither.
+		std::string result_path;
+		// Names of all non-export parameters.
+		std::set<std::string> import_params;
+
+		static RfcReadTableCapabilities FromFunction(RfcFunction &function);
+
+		// Pure helper behind `result_path`, exposed for offline testing.
+		static std::string SelectResultPath(const std::set<std::string> &result_names);
+	};
+
+	/**
+	 * @brief Process-wide cache of function descriptors and read-table
+	 *        capabilities, keyed by SAP system.
+	 *
+	 * RFC_FUNCTION_DESC_HANDLEs are owned by the SDK repository and are never
+	 * freed (see RfcFunction::~RfcFunction), so one handle can back any number
+	 * of RfcFunction wrappers on any connection to the same system.  Caching
+	 * them here removes the RfcGetFunctionDesc round-trip (and the parameter
+	 * walk for the capability probes) from every bind after the first.
+	 *
+	 * Lookups that fail because the function does not exist on the system are
+	 * cached too, for NEGATIVE_TTL, so the RFC_READ_TABLE fallback loop does
+	 * not re-probe missing /BODS or /SAPDS variants on every bind, while a
+	 * function module transported in later is still found.  Transport-level
+	 * failures are never cached.
+	 */
+	class RfcMetadataCache
+	{
+		public:
+			static constexpr std::chrono::seconds NEGATIVE_TTL{60};
+
+			static RfcMetadataCache &Get();
+
+			// Key under which descriptors are shared: system id, release and
+			// logon language (descriptors carry language-dependent texts).
+			// Falls back to the partner host if the system id is unavailable.
+			static std::string SystemKey(const RfcConnectionAttributes &attributes);
+
+			// Returns an RfcFunction bound to `connection`, re-using a cached
+			// descriptor when one exists.  Throws like the RfcFunction
+			// constructor when the function cannot be resolved.
+			std::shared_ptr<RfcFunction> GetFunction(std::shared_ptr<RfcConnection> &connection,
+			                                         const std::string &function_name);
+			RfcReadTableCapabilities GetReadTableCapabilities(std::shared_ptr<RfcConnection> &connection,
+			                                                  const std::string &function_name);
+
+			void Clear();
+			idx_t Size();
+
+			// Whether a "does not exist" outcome cached at `cached_at` must be
+			// looked up again.
+			static bool NegativeEntryExpired(std::chrono::steady_clock::time_point cached_at,
+			                                 std::chrono::steady_clock::time_point now);
+
+		private:
+			struct DescriptorEntry {
+				RFC_FUNCTION_DESC_HANDLE handle = nullptr;
+				// Non-empty for a cached "function does not exist" outcome.
+				std::string error;
+				std::chrono::steady_clock::time_point cached_at;
+			};
+
+			struct SystemEntry {
+				std::map<std::string, DescriptorEntry> descriptors;
+				std::map<std::string, RfcReadTableCapabilities> read_table;
+			};
+
+			std::mutex lock;
+			std::map<std::string, SystemEntry> systems;
+
+			static std::string TrySystemKey(RfcConnection &connection);
+	};
+} // namespace duckdb
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace duckdb {
+
+// One mirrored table, as reported by sap_replica_status().
+struct SapReplicaTableStatus {
+	string table_name;
+	// False until the first successful load; refreshed_at and row_count are
+	// only meaningful once it is set.
+	bool loaded = false;
+	timestamp_t refreshed_at;
+	idx_t row_count = 0;
+	idx_t refresh_ms = 0;
+	bool refreshing = false;
+	timestamp_t next_refresh_at;
+	string last_error;
+	// Refresh attempts finished so far, failed ones included.
+	idx_t attempts = 0;
+	// RefreshNow() asked for another refresh while this one was running.
+	bool rerun = false;
+};
+
+// A local DuckDB copy of some tables of an attached SAP catalog:
+//
+//   ATTACH '' AS sap (TYPE sap_rfc, TABLES 'T001,MARA', CACHE 'replica.duckdb', REFRESH '15 minutes');
+//
+// The replica file is attached as `<catalog>_replica`.  Each table in it is
+// a full copy made with `sap_read_table`, replaced in one transaction.  When
+// a copy exists, SapTableEntry scans it instead of SAP.  Load times survive
+// a restart (table erpl_replica_state), so re-attaching an existing replica
+// serves reads at once and only reloads what is due.
+//
+// Shared by the catalog's table entries and its SapReplicaRefresher.  The
+// refresh thread only touches this object, which it keeps alive itself, and
+// never the catalog that started it.
+class SapReplica {
+public:
+	static constexpr const char *STATE_TABLE = "erpl_replica_state";
+	static constexpr int64_t DEFAULT_REFRESH_MICROS = Interval::MICROS_PER_HOUR;
+	// A table whose refresh failed is tried again after this long, or after
+	// the refresh interval if that is shorter.
+	static constexpr int64_t RETRY_MICROS = 5 * Interval::MICROS_PER_MINUTE;
+
+	static std::shared_ptr<SapReplica> Create(string catalog_name, string path, string secret_name,
+	                                          vector<string> tables, int64_t refresh_micros);
+	// Every replica still attached in this process.
+	static vector<std::shared_ptr<SapReplica>> All();
+
+	// The local copy of `table`, if one has been loaded and still has the
+	// `columns` of the SAP table; null otherwise, and the caller reads SAP.
+	optional_ptr<TableCatalogEntry> TryGetTable(ClientContext &context, const string &table,
+	                                            const ColumnList &columns);
+
+	const string &CatalogName() const {
+		return catalog_name;
+	}
+	const string &ReplicaName() const {
+		return replica_name;
+	}
+	const string &Path() const {
+		return path;
+	}
+	int64_t RefreshMicros() const {
+		return refresh_micros;
+	}
+	vector<SapReplicaTableStatus> Status();
+
+	// Makes every table due and waits until each has been refreshed once
+	// more; throws if the replica is stopped or `context` is interrupted
+	// meanwhile.  Errors of the refresh itself end up in Status().
+	void RefreshNow(ClientContext &context);
+
+	// Body of the refresh thread; returns once Stop() is called or the
+	// database is gone.
+	void Run(weak_ptr<DatabaseInstance> db);
+	// Wakes the refresh thread and interrupts a refresh in flight.  Called on
+	// DETACH and when the database closes.
+	void Stop();
+	bool Stopped();
+
+private:
+	SapReplica(string catalog_name, string path, string secret_name, vector<string> tables, int64_t refresh_micros);
+
+	void Open(DatabaseInstance &db);
+	// Holds no reference to the database between statements other than its
+	// own connection, and interrupts itself once that connection is the
+	// last one: a closed database is then released within one task, not
+	// after the whole copy.
+	void Refresh(const weak_ptr<DatabaseInstance> &weak_db, const string &table);
+
+	string catalog_name;
+	string replica_name;
+	string path;
+	string secret_name;
+	int64_t refresh_micros;
+
+	std::mutex lock;
+	std::condition_variable cv;
+	bool cancelled = false;
+	bool opened = false;
+	// Set by RefreshNow() to wake the thread out of its wait.
+	bool refresh_requested = false;
+	vector<SapReplicaTableStatus> tables;
+	// The connection of the refresh in flight, so Stop() can interrupt it.
+	Connection *active = nullptr;
+};
+
+// Owns the refresh thread of one attached catalog: stops and joins it when
+// the catalog is detached or the database closes.
+class SapReplicaRefresher {
+public:
+	SapReplicaRefresher(DatabaseInstance &db, std::shared_ptr<SapReplica> replica);
+	~SapReplicaRefresher();
+
+private:
+	std::shared_ptr<SapReplica> replica;
+	std::thread thread;
+};
+
+} // namespace duckdb
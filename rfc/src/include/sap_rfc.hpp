@@ -1,16 +1,20 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <optional>
 #include <thread>
 
 #include "duckdb.hpp"
+#include "duckdb/common/insertion_order_preserving_map.hpp"
 #include "duckdb/parallel/base_pipeline_event.hpp"
 #include "duckdb/parallel/task_executor.hpp"
 #include "sap_rfc_api.hpp"
 
 #include "sap_function.hpp"
+#include "sap_trace_spans.hpp"
 
 namespace duckdb 
 {
@@ -43,6 +47,33 @@ namespace duckdb
 	class RfcReadColumnStateMachine; // forward declaration
 	class RfcReadColumnTask; // forward declaration
 
+	// What one sap_read_table scan did, shown by EXPLAIN ANALYZE.  Counted by
+	// the column tasks from any thread; reset when the scan (re)starts.
+	struct RfcReadTableStats
+	{
+		std::atomic<idx_t> rfc_calls{0};
+		std::atomic<idx_t> rfc_time_us{0};
+		// Bytes of the result rows' CSV payload, as received.
+		std::atomic<idx_t> payload_bytes{0};
+		std::atomic<idx_t> rows_decoded{0};
+		std::atomic<idx_t> decode_time_us{0};
+		// Logons made for this scan, and logons it took from the connection
+		// pool instead.  A column's cached connection counts once, when it
+		// is obtained, not for every batch it serves.
+		std::atomic<idx_t> connections_opened{0};
+		std::atomic<idx_t> connections_reused{0};
+		std::atomic<idx_t> retries{0};
+		// ROWCOUNT of the largest batch requested.
+		std::atomic<idx_t> max_batch_rows{0};
+
+		void Reset();
+		void RecordCall(std::chrono::steady_clock::time_point started);
+		void RecordBatchSize(idx_t rows);
+		void AddTo(InsertionOrderPreservingMap<string> &result) const;
+
+		static idx_t MicrosecondsSince(std::chrono::steady_clock::time_point started);
+	};
+
 	typedef std::shared_ptr<RfcConnection> (* RfcConnectionFactory_t)(ClientContext &context);
 	std::shared_ptr<RfcConnection> DefaultRfcConnectionFactory(ClientContext &context);
 
@@ -68,6 +99,9 @@ namespace duckdb
 			void InitOptionsFromWhereClause(std::string &where_clause);
 			void AddOptionsFromWhereClause(std::string &where_clause);
 			void InitAndVerifyFields(std::vector<std::string> req_fields);
+			// Same, with the DDIC field metadata (DFIES rows) already at hand
+			// — e.g. from ATTACH schema discovery — instead of fetched here.
+			void InitAndVerifyFields(std::vector<std::string> req_fields, std::vector<Value> available_fields);
 			
 			void ActivateColumns(vector<column_t> &column_ids);
 			void AddOptionsFromFilters(duckdb::optional_ptr<duckdb::TableFilterSet> filters);
@@ -103,12 +137,44 @@ namespace duckdb
 			unsigned int GetEffectiveMaxBatchSize() const { return effective_max_batch_size; }
 
 			std::string ToString();
+			// EXPLAIN parameters: the table, read function and pushed OPTIONS;
+			// with `analyze`, the column tasks, batch size and the counters
+			// of the last scan too.
+			InsertionOrderPreservingMap<string> ExplainParams(bool analyze);
 			double GetProgress();
 
+			// Cancellation.  Cancel() wakes every retry back-off and aborts
+			// every RFC call in flight (see RfcConnection::Cancel); while a
+			// scan runs, a watchdog thread turns ClientContext::interrupted
+			// into Cancel().  Column tasks then throw InterruptException
+			// instead of sitting out the remaining retries.
+			void Cancel();
+			bool IsCancelled();
+			// Sleeps for `delay` unless the scan is cancelled first; returns
+			// false if it was.
+			bool WaitUnlessCancelled(std::chrono::milliseconds delay);
+			// Bracket one RFC call so Cancel() can reach it.  BeginCall throws
+			// InterruptException if the scan is already cancelled.
+			void BeginCall(std::shared_ptr<RfcConnection> connection);
+			void EndCall(const std::shared_ptr<RfcConnection> &connection);
+			// Called when a scan (re)starts and when it is done with its
+			// connections — exhausted, or abandoned early because a LIMIT was
+			// satisfied or the query failed.  FinishScan stops the watchdog
+			// and hands every cached column connection back to the
+			// RfcConnectionPool.
+			void BeginScan();
+			void FinishScan();
+
+			~RfcReadTableBindData();
+
 		public:
 			std::string table_name;
 			std::vector<std::string> options;
 			unsigned int limit = 0;
+			// Rows skipped before the first one read (ROW_OFFSET), e.g. to read
+			// one partition of a table.  A multiple of MAX_BATCH_SIZE, so every
+			// ROWSKIPS sent stays a multiple of its ROWCOUNT.
+			unsigned int row_offset = 0;
 			unsigned int max_threads = 0;
 			std::string read_table_function;
 			std::string read_table_delimiter;
@@ -117,6 +183,11 @@ namespace duckdb
 			std::optional<bool> read_table_supports_et_data_switch;
 			std::string read_table_result_path;
 			std::set<std::string> read_table_import_params;
+			RfcReadTableStats stats;
+			// Span buffer of the running query when erpl_rfc_trace_spans_dir
+			// is set, and this scan's id in it; both set by BeginScan().
+			std::shared_ptr<RfcSpanBuffer> spans;
+			idx_t span_scan_id = 0;
 
 			void SetSecretName(const std::string &name) { secret_name = name; }
 			const std::string &GetSecretName() const { return secret_name; }
@@ -143,12 +214,32 @@ namespace duckdb
 			// here); Step() overwrites this with the column-count-aware cap.
 			unsigned int effective_max_batch_size = 16u * STANDARD_VECTOR_SIZE;
 
+			// How often the watchdog polls ClientContext::interrupted.
+			static constexpr std::chrono::milliseconds CANCEL_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+			std::mutex cancel_lock;
+			std::condition_variable cancel_cv;
+			std::atomic<bool> cancel_requested{false};
+			// Connections with an RFC call in progress.  Cancel() aborts them
+			// under cancel_lock, so EndCall() cannot return (and the caller
+			// cannot close the handle) while RfcCancel still uses it.
+			std::vector<std::shared_ptr<RfcConnection>> in_flight_calls;
+			std::thread watchdog;
+			bool watchdog_stop = false;
+
+			void StartWatchdog();
+			void StopWatchdog();
+
 			std::vector<RfcReadColumnStateMachine> CreateReadColumnStateMachines();
 			unsigned int NActiveStateMachines();
 			unsigned int FirstActiveStateMachineCardinality();
 			bool AreActiveStateMachineCaridnalitiesEqual();
 		public:
 			static std::vector<Value> GetTableFieldMetas(std::shared_ptr<RfcConnection> connection, std::string table_name);
+			// Column names and DuckDB types InitAndVerifyFields({}) would
+			// produce for the given DFIES rows.
+			static void GetSchemaForFieldMetas(std::vector<Value> &field_metas, std::vector<std::string> &names,
+			                                   std::vector<LogicalType> &types);
 			static RfcType GetRfcTypeForFieldMeta(Value &DFIES_entry);
 	
 			static std::string TransformFilter(std::string &column_name, TableFilter &filter);
@@ -206,6 +297,15 @@ namespace duckdb
 			std::shared_ptr<RfcFunction> AcquireFunction(std::shared_ptr<RfcConnection> connection,
 			                                             const std::string &function_name);
 			void InvalidateCachedConnection();
+			// Like InvalidateCachedConnection, but for a connection that is
+			// known to be healthy: it is handed back to the
+			// RfcConnectionPool instead of being closed.  Caller holds
+			// thread_lock.
+			void ReleaseCachedConnection();
+			// Locking entry point for callers outside a column task: releases
+			// (reusable) or invalidates the cached connection and drops the
+			// last batch's function handle.
+			void ReleaseResources(bool reusable);
 
 			// True once AcquireConnection has confirmed this state machine
 			// won a persistent slot from the bind-data budget.  Used by
@@ -274,6 +374,14 @@ namespace duckdb
 			std::shared_ptr<RfcConnection> cached_connection;
 			std::shared_ptr<RfcFunction> cached_function;
 			std::string cached_function_name;
+			// Prepared invocation reused by every batch that runs against
+			// cached_function: QUERY_TABLE, FIELDS, OPTIONS etc. are adapted
+			// once, later batches only rewrite ROWSKIPS/ROWCOUNT and clear
+			// the previous result table.  Keyed by the function object it was
+			// built from plus the delimiter / ET_DATA choice, and dropped
+			// together with the cached connection.
+			std::shared_ptr<RfcInvocation> prepared_invocation;
+			std::string prepared_invocation_key;
 			// The SAP NW RFC SDK requires that any one RFC_CONNECTION_HANDLE
 			// be used by at most one thread.  DuckDB's TaskExecutor pumps
 			// tasks from a shared worker pool, so a single state machine's
@@ -322,6 +430,12 @@ namespace duckdb
 		private:
 			unsigned int ExecuteNextTableReadForColumn();
 			std::vector<Value> CreateFunctionArguments(const std::string &delimiter, bool use_et_data);
+			// Returns an invocation ready to execute for the next batch: the
+			// state machine's prepared one with only the paging parameters
+			// updated when it still matches `func`, else a freshly built one.
+			std::shared_ptr<RfcInvocation> PrepareInvocation(std::shared_ptr<RfcFunction> func,
+			                                                 const std::string &delimiter, bool use_et_data);
+			unsigned int NextBatchRowCount() const;
 
 			// Resolves the SDK result-table handle + its CSV-carrying field for
 			// the just-executed invocation, storing them on the state machine
@@ -46,8 +46,10 @@ inline size_t strlenU16(const SAP_UTF16 *s) {
 // missing name is named, rather than resolving to whatever the loader happens to hold.
 #define ERPL_RFC_API_ENTRY_POINTS(X) \
 	X(RfcAppendNewRow) \
+	X(RfcCancel) \
 	X(RfcCloseConnection) \
 	X(RfcCreateFunction) \
+	X(RfcDeleteAllRows) \
 	X(RfcDestroyFunction) \
 	X(RfcGetBytes) \
 	X(RfcGetChars) \
@@ -81,6 +83,7 @@ inline size_t strlenU16(const SAP_UTF16 *s) {
 	X(RfcOpenConnection) \
 	X(RfcPing) \
 	X(RfcReloadIniFile) \
+	X(RfcResetServerContext) \
 	X(RfcSAPUCToUTF8) \
 	X(RfcSetBytes) \
 	X(RfcSetDate) \
@@ -136,8 +139,46 @@ void SetRfcBackendLibraryPath(const string &path);
 // Resolves the backend library on first call and fills the table. Throws if the library
 // cannot be opened or an entry point is missing -- a half-filled table would fail later,
 // at a call site with no clue as to why.
+// Returns the instrumented table instead while instrumentation is on.
 const RfcApi &GetRfcApi();
 
+// Call statistics of one entry point, gathered while the instrumented table serves
+// calls. A snapshot; the counters keep running.
+struct RfcApiEntryStats {
+	static constexpr idx_t LATENCY_BUCKETS = 32;
+
+	const char *name = nullptr;
+	uint64_t calls = 0;
+	// Calls that returned an RFC_RC other than RFC_OK, or a null handle.
+	uint64_t errors = 0;
+	uint64_t total_ns = 0;
+	uint64_t max_ns = 0;
+	// Bucket 0 counts calls under a microsecond, bucket i those of [2^(i-1), 2^i) us.
+	uint64_t latency[LATENCY_BUCKETS] = {};
+	// Failed calls by return code.
+	vector<std::pair<RFC_RC, uint64_t>> error_codes;
+
+	// Upper bound of the bucket the p-th percentile call falls into, capped at the
+	// slowest call; 0 without calls.
+	double LatencyPercentileUs(double p) const;
+};
+
+// Switches GetRfcApi() between the plain table and one whose slots count and time each
+// call before forwarding it. Backed by the erpl_rfc_api_stats setting. Both tables call
+// into the same library, so this may change at any time; switching on clears the
+// statistics gathered before.
+void SetRfcApiInstrumentation(bool enabled);
+bool IsRfcApiInstrumented();
+
+// Has GetRfcApi() return `api` instead of the resolved backend, until called with
+// nullptr. For tests that stand in for the SDK, so the code around a call can be
+// exercised without a SAP system; `api` must outlive every call made through it.
+void SetRfcApiOverride(const RfcApi *api);
+
+// One entry per slot, in ERPL_RFC_API_ENTRY_POINTS order, including those never called.
+vector<RfcApiEntryStats> GetRfcApiStats();
+void ResetRfcApiStats();
+
 // The backend actually serving calls, resolving it if that has not happened yet.
 RfcBackend GetResolvedRfcBackend();
 
@@ -152,8 +193,10 @@ const string &GetRfcBackendDescription();
 // Call sites are left verbatim: the macro expands to a call through a pointer of exactly
 // the declared type, so overload resolution and implicit conversions behave as before.
 #define RfcAppendNewRow (::duckdb::GetRfcApi().RfcAppendNewRow)
+#define RfcCancel (::duckdb::GetRfcApi().RfcCancel)
 #define RfcCloseConnection (::duckdb::GetRfcApi().RfcCloseConnection)
 #define RfcCreateFunction (::duckdb::GetRfcApi().RfcCreateFunction)
+#define RfcDeleteAllRows (::duckdb::GetRfcApi().RfcDeleteAllRows)
 #define RfcDestroyFunction (::duckdb::GetRfcApi().RfcDestroyFunction)
 #define RfcGetBytes (::duckdb::GetRfcApi().RfcGetBytes)
 #define RfcGetChars (::duckdb::GetRfcApi().RfcGetChars)
@@ -187,6 +230,7 @@ const string &GetRfcBackendDescription();
 #define RfcOpenConnection (::duckdb::GetRfcApi().RfcOpenConnection)
 #define RfcPing (::duckdb::GetRfcApi().RfcPing)
 #define RfcReloadIniFile (::duckdb::GetRfcApi().RfcReloadIniFile)
+#define RfcResetServerContext (::duckdb::GetRfcApi().RfcResetServerContext)
 #define RfcSAPUCToUTF8 (::duckdb::GetRfcApi().RfcSAPUCToUTF8)
 #define RfcSetBytes (::duckdb::GetRfcApi().RfcSetBytes)
 #define RfcSetDate (::duckdb::GetRfcApi().RfcSetDate)
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+
+namespace duckdb
+{
+	// File every finished sap_read_table / sap_rfc_invoke scan appends a line
+	// to; empty turns the history off.  Wired to the `erpl_rfc_scan_history`
+	// extension option.
+	void SetRfcScanHistoryPath(const std::string &path);
+	std::string GetRfcScanHistoryPath();
+
+	/**
+	 * @brief What one scan cost.  Holds the same kind of values as
+	 *        erpl_telemetry.hpp sends, and nothing else: constants, numbers,
+	 *        and fingerprints — never a host, user, client, table or
+	 *        function name, argument, filter or error message.
+	*/
+	struct RfcScanRecord
+	{
+		// Milliseconds since the epoch.
+		int64_t finished_at_ms = 0;
+		// "sap_read_table" or "sap_rfc_invoke".
+		std::string function;
+		// complete: read to the end; stopped: ended early by a LIMIT or an
+		// error; cancelled: interrupted.
+		std::string status;
+		// extracted: read from SAP; shared: from another session's identical
+		// scan; cached: from the invoke cache.
+		std::string source;
+		// Fingerprints of the SAP system and client, and of the table or
+		// function module.
+		std::string system;
+		std::string object;
+		double duration_ms = 0;
+		idx_t rows = 0;
+		idx_t payload_bytes = 0;
+		idx_t rfc_calls = 0;
+		double rfc_time_ms = 0;
+		idx_t retries = 0;
+		idx_t connections_opened = 0;
+		idx_t connections_reused = 0;
+		idx_t columns = 0;
+		// THREADS; 0 when every column runs at once.
+		idx_t threads = 0;
+		idx_t max_batch_rows = 0;
+	};
+
+	/**
+	 * @brief The scan history: a tab-separated text file, one line per scan,
+	 *        appended with a single write so scans of several processes can
+	 *        share it.  Lines that do not parse — a version this build does
+	 *        not know, a line cut off by a crash — are skipped on reading.
+	*/
+	class RfcScanHistory
+	{
+		public:
+			static constexpr const char *LINE_VERSION = "v1";
+
+			// Stable across builds and platforms (FNV-1a, 64 bits, hex), so
+			// fingerprints written weeks apart can be compared.  Not meant to
+			// withstand guessing: a table name is easily tried.
+			static std::string Fingerprint(const std::string &value);
+			// The fingerprint of a table or function module name, as recorded.
+			static std::string ObjectFingerprint(const std::string &name);
+
+			static std::string FormatRecord(const RfcScanRecord &record);
+			static bool ParseRecord(const std::string &line, RfcScanRecord &record);
+
+			// Appends `record` if the history is on.  Never throws: a scan
+			// must not fail because its history could not be written.  Pass
+			// the scan's FileSystem::GetFileSystem(context), so DuckDB's
+			// enable_external_access and allowed_directories apply.
+			static void Append(FileSystem &fs, const RfcScanRecord &record);
+			static std::vector<RfcScanRecord> Read(FileSystem &fs, const std::string &path);
+
+			static int64_t NowMs();
+	};
+} // namespace duckdb
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "duckdb.hpp"
+
+#include "sap_rfc.hpp"
+
+namespace duckdb
+{
+	// Bytes of decoded batches a running sap_read_table scan keeps for
+	// identical scans that join it.  Default 0, i.e. sharing is off: every
+	// shared scan copies each batch it returns.  Wired to
+	// `erpl_rfc_shared_scan_buffer`.
+	void SetRfcSharedScanBuffer(idx_t bytes);
+	idx_t GetRfcSharedScanBuffer();
+
+	/**
+	 * @brief One sap_read_table extraction read by several concurrent scans.
+	 *
+	 * The first scan of a table — same system and user, columns, options
+	 * and read function — registers as the producer and runs the extraction
+	 * as usual; identical scans from other sessions that start while it runs
+	 * join as readers instead of extracting the table again.  The producer
+	 * publishes a copy of each batch it returns.  Batches are spooled from
+	 * the first one on, so a late reader starts at the beginning.
+	 *
+	 * The spool is bounded by GetRfcSharedScanBuffer().  Once it is full the
+	 * scan stops taking new readers and drops the batches every reader has
+	 * passed; a reader still holding the spool up is detached.  A detached
+	 * reader, or one whose producer stopped early (LIMIT, interrupt, error)
+	 * or stalled, starts its own extraction if it has not returned a row
+	 * yet, and fails otherwise: RFC_READ_TABLE does not return rows in the
+	 * same order on every call, so it cannot skip the rows already returned.
+	 */
+	class RfcSharedScan
+	{
+		public:
+			static constexpr idx_t DEFAULT_BUFFER = 0;
+			// A reader that has caught up gives up on a producer that has not
+			// been producing for this long, e.g. because its client stopped
+			// fetching a streamed result.
+			static constexpr std::chrono::milliseconds PRODUCER_IDLE_TIMEOUT = std::chrono::milliseconds(2000);
+
+			enum class ReadResult { CHUNK, FINISHED, DETACHED };
+
+			// Scans share an extraction only with the same credentials, so a
+			// reader never sees rows its own user could not read.  `system` is
+			// RfcAuthParams::PoolKey(): in-process only, never logged.
+			// `columns` describes the projection in output order.
+			static std::string Key(const std::string &system, const RfcReadTableBindData &bind_data,
+			                       const std::vector<std::string> &columns);
+
+			// Joins the running scan for `key` as a reader, or registers a new
+			// one for this scan to produce.  Null when sharing is off, or when
+			// the running scan belongs to the same query's context, which
+			// might be the one that has to produce it.
+			static std::shared_ptr<RfcSharedScan> Join(const std::string &key, ClientContext &context,
+			                                           bool &producer, idx_t &reader_id);
+			// Scans open to readers; exposed for testing.
+			static idx_t RunningCount();
+
+			// Producer side.  BeginStep brackets the extraction of the next
+			// batch, so readers waiting for it know the producer is alive.
+			void BeginStep();
+			void Publish(const DataChunk &chunk);
+			void Finish();
+			// The producer stopped before the end; its readers go on alone.
+			// A no-op after Finish().
+			void Abandon();
+
+			// Reader side.  Copies the next batch into `output`, waiting for
+			// the producer if needed; throws InterruptException when the
+			// reader's query is interrupted meanwhile.
+			ReadResult Read(ClientContext &context, idx_t reader_id, DataChunk &output);
+			void Leave(idx_t reader_id);
+
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			explicit RfcSharedScan(ClientContext &producer_context);
+
+			// Drops spooled batches no reader still needs; when the spool is
+			// over budget, closes the scan to new readers and detaches the
+			// readers furthest behind.  Called with `lock` held.
+			void Trim();
+
+			ClientContext *producer_context;
+
+			std::mutex lock;
+			std::condition_variable cv;
+			// Spooled batches; spool.front() is batch number `first_batch`.
+			std::deque<unique_ptr<DataChunk>> spool;
+			idx_t first_batch = 0;
+			idx_t spool_bytes = 0;
+			// Next batch number per attached reader.
+			std::map<idx_t, idx_t> readers;
+			idx_t next_reader_id = 0;
+			bool open = true;
+			bool finished = false;
+			bool abandoned = false;
+			bool producing = false;
+			Clock::time_point idle_since;
+	};
+} // namespace duckdb
@@ -7,4 +7,11 @@ namespace duckdb {
 
 void RegisterSapStorageExtension(ExtensionLoader &loader);
 
+// Number of connections over which an attached catalog discovers the DDIC
+// schemas of its TABLES list when it is first enumerated.  0 falls back to
+// discovering one table at a time.  Wired to the
+// `erpl_rfc_catalog_discovery_threads` extension option.
+void SetRfcCatalogDiscoveryThreads(unsigned int n);
+unsigned int GetRfcCatalogDiscoveryThreads();
+
 } // namespace duckdb
@@ -5,6 +5,8 @@
 #include "duckdb/storage/table_storage_info.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
 
+#include "sap_replica.hpp"
+
 namespace duckdb {
 
 // A TableCatalogEntry that maps a single SAP table accessed via RFC.  Used
@@ -15,7 +17,8 @@ namespace duckdb {
 class SapTableEntry : public TableCatalogEntry {
 public:
 	SapTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info,
-	              string sap_table_name, string secret_name);
+	              string sap_table_name, string secret_name, vector<Value> field_metas = {},
+	              std::shared_ptr<SapReplica> replica = nullptr);
 
 	TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override;
 
@@ -26,6 +29,14 @@ public:
 private:
 	string sap_table_name;
 	string secret_name;
+	// DDIC field metadata (DFIES rows) the entry's columns were built from.
+	// Handed to the scan bind so it neither repeats the DDIF_FIELDINFO_GET
+	// round-trip nor can disagree with the catalog's column list.  Empty
+	// means "fetch at bind time".
+	vector<Value> field_metas;
+	// Set when the catalog was attached with CACHE; scans read the local
+	// copy instead of SAP once it has been loaded.
+	std::shared_ptr<SapReplica> replica;
 };
 
 } // namespace duckdb
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "duckdb.hpp"
+#include "duckdb/main/client_context_state.hpp"
+
+namespace duckdb
+{
+	// Directory that gets one Chrome trace JSON file per query with RFC
+	// spans; empty turns span recording off.  Wired to the
+	// `erpl_rfc_trace_spans_dir` extension option.
+	void SetRfcTraceSpansDirectory(const std::string &directory);
+	std::string GetRfcTraceSpansDirectory();
+
+	struct RfcSpan
+	{
+		const char *name;
+		const char *category;
+		std::chrono::steady_clock::time_point start;
+		std::chrono::steady_clock::time_point end;
+		std::thread::id thread;
+		idx_t scan_id;
+		std::string column;
+		std::string detail;
+	};
+
+	/**
+	 * @brief The spans recorded during one query.  Written as Chrome trace
+	 *        JSON (chrome://tracing, ui.perfetto.dev) when the query ends,
+	 *        one track per thread.  Holds at most MAX_SPANS; later spans are
+	 *        dropped and only counted, so a long sap_rfc_invoke_each cannot
+	 *        fill memory with them.
+	*/
+	class RfcSpanBuffer
+	{
+		public:
+			static constexpr idx_t MAX_SPANS = 100000;
+
+			RfcSpanBuffer();
+
+			// The buffer of the query `context` runs, nullptr when span
+			// recording is off.
+			static std::shared_ptr<RfcSpanBuffer> ForQuery(ClientContext &context);
+
+			idx_t NextScanId();
+			void Add(RfcSpan span);
+			idx_t Size();
+			// Spans not kept because the buffer was full.
+			idx_t Dropped();
+			std::string ToChromeTraceJson();
+			// Writes <directory>/erpl_rfc_spans_<start>_<n>.json through `fs`;
+			// returns its path.
+			std::string WriteTo(FileSystem &fs, const std::string &directory);
+
+		private:
+			std::mutex lock;
+			std::chrono::steady_clock::time_point origin;
+			std::chrono::system_clock::time_point wall_origin;
+			std::vector<RfcSpan> spans;
+			idx_t dropped = 0;
+			idx_t next_scan_id = 0;
+	};
+
+	/**
+	 * @brief Where the spans of the current thread go, and what they are
+	 *        tagged with.  Set for the duration of a scan step or column
+	 *        task; spans recorded on a thread without one are dropped, so
+	 *        an instrumented call costs a thread-local read when recording
+	 *        is off.
+	*/
+	class RfcSpanContext
+	{
+		public:
+			RfcSpanContext(RfcSpanBuffer *buffer, idx_t scan_id, std::string column);
+			~RfcSpanContext();
+
+			RfcSpanContext(const RfcSpanContext &) = delete;
+			RfcSpanContext &operator=(const RfcSpanContext &) = delete;
+
+			static RfcSpanContext *Current();
+
+		private:
+			friend class RfcTraceSpan;
+
+			RfcSpanBuffer *buffer;
+			idx_t scan_id;
+			std::string column;
+			RfcSpanContext *previous;
+	};
+
+	/**
+	 * @brief Records its own lifetime as a span, if the thread has an
+	 *        RfcSpanContext.  `name` and `category` must be literals.  A
+	 *        detail that has to be built is set with SetDetail() once
+	 *        Recording() says it will be kept.
+	*/
+	class RfcTraceSpan
+	{
+		public:
+			RfcTraceSpan(const char *name, const char *category);
+			RfcTraceSpan(const char *name, const char *category, const std::string &detail);
+			~RfcTraceSpan();
+
+			RfcTraceSpan(const RfcTraceSpan &) = delete;
+			RfcTraceSpan &operator=(const RfcTraceSpan &) = delete;
+
+			bool Recording() const { return context != nullptr; }
+			void SetDetail(std::string detail_p) { detail = std::move(detail_p); }
+
+		private:
+			RfcSpanContext *context;
+			const char *name;
+			const char *category;
+			std::string detail;
+			std::chrono::steady_clock::time_point start;
+	};
+
+	// Holds the query's span buffer and writes it out when the query ends.
+	class RfcSpanState : public ClientContextState
+	{
+		public:
+			void QueryEnd(ClientContext &context) override;
+
+			std::mutex lock;
+			std::shared_ptr<RfcSpanBuffer> buffer;
+	};
+} // namespace duckdb
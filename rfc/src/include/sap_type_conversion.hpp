@@ -72,6 +72,14 @@ namespace duckdb
     //void duck2rfc(Value &duck_value, RFC_BCD &rfc_bcd);
     void duck2rfc(Value &duck_value, RFC_DECF16 &rfc_dec16);
     void duck2rfc(Value &duck_value, RFC_DECF34 &rfc_dec34);
+    // Variants for callers that read straight from DuckDB vectors: they take
+    // the physical value and write the SDK type without a Value or a
+    // temporary string in between.
+    void duck2rfc(date_t date, RFC_DATE &rfc_date);
+    void duck2rfc(dtime_t time, RFC_TIME &rfc_time);
+    // UTF-8 to SAP_UC into a caller-owned buffer that is reused across calls;
+    // returns the converted length in SAP_UC units.
+    unsigned int utf82uc(const char *utf8, idx_t utf8_len, std::vector<SAP_UC> &buffer);
     
     std::string rfcrc2std(RFC_RC &rc);
 
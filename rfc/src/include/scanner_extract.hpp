@@ -0,0 +1,10 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
+
+namespace duckdb
+{
+	TableFunction CreateSapExtractScanFunction();
+} // namespace duckdb
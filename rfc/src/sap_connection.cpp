@@ -3,6 +3,9 @@
 #include "sap_type_conversion.hpp"
 #include "sap_secret.hpp"
 #include "erpl_telemetry.hpp"
+#include "sap_trace_spans.hpp"
+#include "sap_scan_history.hpp"
+#include "erpl_tracing.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -132,6 +135,16 @@ namespace duckdb
 
     std::shared_ptr<RfcConnection> RfcAuthParams::Connect() 
     {
+        auto parked = RfcConnectionPool::Get().TryTake(PoolKey());
+        if (parked) {
+            return parked;
+        }
+        return OpenConnection();
+    }
+
+    std::shared_ptr<RfcConnection> RfcAuthParams::OpenConnection()
+    {
+        RfcTraceSpan span("RfcOpenConnection", "connection");
         RFC_ERROR_INFO error_info;
 
         // Marshal the parameter list into the SDK's wide-character representation.
@@ -172,7 +185,24 @@ namespace duckdb
         }
         // Telemetry: feature_used {feature="connection_opened", auth_kind}.
         erpl_telemetry::CaptureConnectionOpened(auth);
-        return std::make_shared<RfcConnection>(connection_handle);
+        auto connection = std::make_shared<RfcConnection>(connection_handle);
+        connection->pool_key = PoolKey();
+        return connection;
+    }
+
+    string RfcAuthParams::PoolKey() const
+    {
+        std::stringstream ss;
+        for (auto &param : BuildConnectionParams()) {
+            ss << param.first << '=' << param.second << '\n';
+        }
+        return ss.str();
+    }
+
+    string RfcAuthParams::SystemFingerprint() const
+    {
+        return RfcScanHistory::Fingerprint(StringUtil::Join(
+            vector<string> { ashost, sysnr, mshost, msserv, sysid, group, dest, client }, "\n"));
     }
 
     const char *RfcAuthParams::TelemetryAuthKind() const
@@ -208,6 +238,121 @@ namespace duckdb
     }
 
     // RfcAuthParams ------------------------------------------------------------
+
+    RfcConnectionPool &RfcConnectionPool::Get()
+    {
+        // Leaked on purpose, see the class comment.
+        static auto *instance = new RfcConnectionPool();
+        return *instance;
+    }
+
+    void RfcConnectionPool::Park(const string &key, std::shared_ptr<RfcConnection> connection,
+                                 std::chrono::steady_clock::duration idle_for)
+    {
+        if (!connection || connection->handle == NULL) {
+            return;
+        }
+        // Closed by their destructors once the lock is released.
+        std::vector<std::shared_ptr<RfcConnection>> discarded;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            auto now = std::chrono::steady_clock::now();
+            for (auto it = parked.begin(); it != parked.end();) {
+                auto &queue = it->second;
+                while (!queue.empty() && now - queue.front().parked_at > MAX_IDLE) {
+                    discarded.push_back(std::move(queue.front().connection));
+                    queue.pop_front();
+                }
+                it = queue.empty() ? parked.erase(it) : std::next(it);
+            }
+
+            auto &queue = parked[key];
+            if (queue.size() >= MAX_PARKED_PER_KEY) {
+                discarded.push_back(std::move(connection));
+            } else {
+                queue.push_back(ParkedConnection { std::move(connection), now - idle_for });
+            }
+        }
+    }
+
+    void RfcConnectionPool::Release(std::shared_ptr<RfcConnection> connection)
+    {
+        if (!connection) {
+            return;
+        }
+        // Whatever the last user left in the ABAP session — an open LUW,
+        // function group globals — must not carry over to the next one.
+        if (connection->pool_key.empty() || !connection->ResetServerContext()) {
+            try {
+                connection->Close();
+            } catch (...) {
+                // best-effort; the handle is gone either way.
+            }
+            return;
+        }
+        auto key = connection->pool_key;
+        Park(key, std::move(connection));
+    }
+
+    std::shared_ptr<RfcConnection> RfcConnectionPool::TryTake(const string &key)
+    {
+        // Expired and dead connections are closed (by their destructor), and
+        // idle ones pinged, only after the lock is released — both talk to
+        // the gateway.
+        std::vector<std::shared_ptr<RfcConnection>> expired;
+        while (true) {
+            ParkedConnection entry;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                auto it = parked.find(key);
+                if (it == parked.end()) {
+                    return nullptr;
+                }
+                auto now = std::chrono::steady_clock::now();
+                auto &queue = it->second;
+                while (!queue.empty() && !entry.connection) {
+                    auto front = std::move(queue.front());
+                    queue.pop_front();
+                    if (now - front.parked_at > MAX_IDLE || front.connection->handle == NULL) {
+                        expired.push_back(std::move(front.connection));
+                        continue;
+                    }
+                    entry = std::move(front);
+                }
+                if (queue.empty()) {
+                    parked.erase(it);
+                }
+                if (!entry.connection) {
+                    return nullptr;
+                }
+            }
+            if (std::chrono::steady_clock::now() - entry.parked_at >= PING_AFTER_IDLE &&
+                !entry.connection->TryPing()) {
+                expired.push_back(std::move(entry.connection));
+                continue;
+            }
+            entry.connection->reused_from_pool = true;
+            return std::move(entry.connection);
+        }
+    }
+
+    idx_t RfcConnectionPool::Size(const string &key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = parked.find(key);
+        return it == parked.end() ? 0 : it->second.size();
+    }
+
+    void RfcConnectionPool::Clear()
+    {
+        decltype(parked) drained;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            drained.swap(parked);
+        }
+    }
+
+    // RfcConnectionPool --------------------------------------------------------
     
     RfcConnection::RfcConnection(RFC_CONNECTION_HANDLE handle) : handle(handle)
     { }
@@ -246,6 +391,33 @@ namespace duckdb
         }
     }
 
+    void RfcConnection::Cancel()
+    {
+        if (handle == NULL)
+            return;
+
+        // The handle is deliberately not nulled: the owning thread is still
+        // inside (or just returning from) a call on it, and its Close() will
+        // get RFC_INVALID_HANDLE, which is treated as benign.
+        RFC_ERROR_INFO error_info;
+        RfcCancel(handle, &error_info);
+    }
+
+    bool RfcConnection::ResetServerContext()
+    {
+        if (handle == NULL) {
+            return false;
+        }
+        RFC_ERROR_INFO error_info;
+        auto rc = RfcResetServerContext(handle, &error_info);
+        if (rc != RFC_OK) {
+            ERPL_TRACE_DEBUG_DATA("sap_connection", "Could not reset the server context",
+                                  StringUtil::Format("%s: %s", rfcrc2std(error_info.code), uc2std(error_info.message)));
+            return false;
+        }
+        return true;
+    }
+
     void RfcConnection::Ping()
     {
         RFC_RC rc = RFC_OK;
@@ -257,6 +429,21 @@ namespace duckdb
         }
     }
 
+    bool RfcConnection::TryPing()
+    {
+        if (handle == NULL) {
+            return false;
+        }
+        RFC_ERROR_INFO error_info;
+        auto rc = RfcPing(handle, &error_info);
+        if (rc != RFC_OK) {
+            ERPL_TRACE_DEBUG_DATA("sap_connection", "Parked connection did not answer a ping",
+                                  StringUtil::Format("%s: %s", rfcrc2std(error_info.code), uc2std(error_info.message)));
+            return false;
+        }
+        return true;
+    }
+
     RfcConnectionAttributes RfcConnection::ConnectionAttributes()
     {
         RFC_RC rc = RFC_OK;
@@ -274,6 +461,7 @@ namespace duckdb
         conn_attrs.host = uc2std(attributes.host);
         conn_attrs.partner_host = uc2std(attributes.partnerHost);
         conn_attrs.sys_number = uc2std(attributes.sysNumber);
+        conn_attrs.sys_id = uc2std(attributes.sysId);
         conn_attrs.client = uc2std(attributes.client);
         conn_attrs.user = uc2std(attributes.user);
         conn_attrs.language = uc2std(attributes.language);
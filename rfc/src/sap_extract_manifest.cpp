@@ -0,0 +1,241 @@
+#include "sap_extract_manifest.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace duckdb {
+
+// fcntl() locks belong to the process, not to the handle: a second handle
+// of this process would be granted the lock, and closing it would drop the
+// first one's.  So the file is locked by one thread of a process at a time.
+static std::mutex g_manifest_file_lock;
+
+SapExtractManifest::SapExtractManifest(FileSystem &fs_p, string directory_p)
+    : fs(fs_p), directory(std::move(directory_p)), path(fs.JoinPath(directory, FILE_NAME)) {
+}
+
+// Tabs and line breaks separate fields and lines; in an ABAP where clause
+// they are just white space.
+static string FlattenField(const string &value) {
+	auto result = value;
+	for (auto &c : result) {
+		if (c == '\t' || c == '\n' || c == '\r') {
+			c = ' ';
+		}
+	}
+	return result;
+}
+
+string SapExtractManifest::FormatJob(const string &table, idx_t partition_rows, const vector<string> &columns,
+                                     const string &filter) {
+	return StringUtil::Format("job\t%s\t%llu\t%s\t%s", StringUtil::Upper(table), partition_rows,
+	                          FlattenField(StringUtil::Join(columns, ",")), FlattenField(filter));
+}
+
+string SapExtractManifest::FormatPartition(const SapExtractPartition &partition) {
+	return StringUtil::Format("part\t%llu\t%llu\t%llu\t%s", partition.index, partition.row_offset, partition.rows,
+	                          partition.file);
+}
+
+bool SapExtractManifest::ParsePartition(const string &line, SapExtractPartition &partition) {
+	auto fields = StringUtil::Split(line, '\t');
+	if (fields.size() != 5 || fields[0] != "part") {
+		return false;
+	}
+	try {
+		partition.index = std::stoull(fields[1]);
+		partition.row_offset = std::stoull(fields[2]);
+		partition.rows = std::stoull(fields[3]);
+	} catch (std::exception &) {
+		return false;
+	}
+	partition.file = fields[4];
+	return true;
+}
+
+void SapExtractManifest::Locked(const std::function<void(FileHandle &)> &action) {
+	std::lock_guard<std::mutex> process_guard(g_manifest_file_lock);
+	std::lock_guard<std::mutex> guard(lock);
+
+	unique_ptr<FileHandle> handle;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LOCK_TIMEOUT_MS);
+	while (!handle) {
+		try {
+			handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_WRITE |
+			                               FileFlags::FILE_FLAGS_FILE_CREATE | FileLockType::WRITE_LOCK);
+		} catch (IOException &ex) {
+			// The lock is not waited for by the file system; another
+			// process holds it for the few lines it reads and writes.
+			if (std::chrono::steady_clock::now() > deadline) {
+				throw IOException("Could not lock '%s' within %lld ms: %s", path, LOCK_TIMEOUT_MS, ex.what());
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+	}
+	ReadNewLines(*handle);
+	action(*handle);
+}
+
+void SapExtractManifest::ReadNewLines(FileHandle &handle) {
+	auto size = static_cast<idx_t>(handle.GetFileSize());
+	if (size <= read_offset) {
+		return;
+	}
+	string content(size - read_offset, '\0');
+	handle.Read((void *)content.data(), content.size(), read_offset);
+
+	idx_t start = 0;
+	while (true) {
+		auto end = content.find('\n', start);
+		if (end == string::npos) {
+			break;
+		}
+		Apply(content.substr(start, end - start));
+		start = end + 1;
+	}
+	read_offset += start;
+	if (read_offset < size) {
+		// Nobody writes without the lock, so this line was cut off by a
+		// crash while it was written.
+		handle.Truncate(static_cast<int64_t>(read_offset));
+	}
+}
+
+void SapExtractManifest::Apply(const string &line) {
+	if (StringUtil::StartsWith(line, "job\t")) {
+		job = line;
+		return;
+	}
+	if (StringUtil::StartsWith(line, "claim\t")) {
+		auto fields = StringUtil::Split(line, '\t');
+		if (fields.size() != 4) {
+			return;
+		}
+		try {
+			auto &claim = claims[std::stoull(fields[1])];
+			claim.owner = fields[2];
+			claim.expiry_ms = std::stoll(fields[3]);
+		} catch (std::exception &) {
+		}
+		return;
+	}
+	SapExtractPartition partition;
+	if (ParsePartition(line, partition)) {
+		partitions[partition.index] = partition;
+	}
+}
+
+void SapExtractManifest::Append(FileHandle &handle, const string &line) {
+	auto text = line + "\n";
+	handle.Write((void *)text.data(), text.size(), read_offset);
+	handle.Sync();
+	read_offset += text.size();
+	Apply(line);
+}
+
+void SapExtractManifest::Open(const string &job_p) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		job.clear();
+		partitions.clear();
+		claims.clear();
+		read_offset = 0;
+		// The third field of the job line.
+		auto rows_start = job_p.find('\t', job_p.find('\t') + 1) + 1;
+		partition_rows = std::stoull(job_p.substr(rows_start, job_p.find('\t', rows_start) - rows_start));
+	}
+
+	Locked([&](FileHandle &handle) {
+		if (job.empty()) {
+			Append(handle, job_p);
+		} else if (job != job_p) {
+			throw InvalidInputException("'%s' holds a different extraction (%s); resume it with the same arguments or "
+			                            "extract into another directory",
+			                            directory, StringUtil::Replace(job, "\t", " "));
+		}
+	});
+}
+
+SapExtractManifest::ClaimResult SapExtractManifest::Claim(const string &owner, int64_t now_ms, int64_t lease_ms,
+                                                          idx_t &index) {
+	auto result = ClaimResult::DONE;
+	Locked([&](FileHandle &handle) {
+		auto count = PartitionCountLocked(partition_rows);
+		for (idx_t candidate = 0; count == DConstants::INVALID_INDEX || candidate < count; candidate++) {
+			if (partitions.find(candidate) != partitions.end()) {
+				continue;
+			}
+			auto claim = claims.find(candidate);
+			if (claim != claims.end() && claim->second.expiry_ms > now_ms) {
+				result = ClaimResult::BUSY;
+				continue;
+			}
+			Append(handle, StringUtil::Format("claim\t%llu\t%s\t%lld", candidate, owner, now_ms + lease_ms));
+			index = candidate;
+			result = ClaimResult::CLAIMED;
+			return;
+		}
+	});
+	return result;
+}
+
+vector<idx_t> SapExtractManifest::Renew(const string &owner, const vector<idx_t> &indexes, int64_t now_ms,
+                                        int64_t lease_ms) {
+	vector<idx_t> lost;
+	Locked([&](FileHandle &handle) {
+		for (auto index : indexes) {
+			auto claim = claims.find(index);
+			if (claim == claims.end() || claim->second.owner != owner || claim->second.expiry_ms <= now_ms) {
+				lost.push_back(index);
+				continue;
+			}
+			if (partitions.find(index) == partitions.end()) {
+				Append(handle, StringUtil::Format("claim\t%llu\t%s\t%lld", index, owner, now_ms + lease_ms));
+			}
+		}
+	});
+	return lost;
+}
+
+void SapExtractManifest::Release(const string &owner, idx_t index) {
+	Locked([&](FileHandle &handle) {
+		auto claim = claims.find(index);
+		if (claim != claims.end() && claim->second.owner == owner) {
+			Append(handle, StringUtil::Format("claim\t%llu\t%s\t0", index, owner));
+		}
+	});
+}
+
+void SapExtractManifest::Record(const SapExtractPartition &partition) {
+	Locked([&](FileHandle &handle) { Append(handle, FormatPartition(partition)); });
+}
+
+bool SapExtractManifest::IsDone(idx_t index) {
+	std::lock_guard<std::mutex> guard(lock);
+	return partitions.find(index) != partitions.end();
+}
+
+idx_t SapExtractManifest::PartitionCount(idx_t partition_rows_p) {
+	std::lock_guard<std::mutex> guard(lock);
+	return PartitionCountLocked(partition_rows_p);
+}
+
+idx_t SapExtractManifest::PartitionCountLocked(idx_t partition_rows_p) {
+	for (auto &entry : partitions) {
+		if (entry.second.rows < partition_rows_p) {
+			return entry.first + 1;
+		}
+	}
+	return DConstants::INVALID_INDEX;
+}
+
+vector<SapExtractPartition> SapExtractManifest::Partitions() {
+	std::lock_guard<std::mutex> guard(lock);
+	vector<SapExtractPartition> result;
+	for (auto &entry : partitions) {
+		result.push_back(entry.second);
+	}
+	return result;
+}
+
+} // namespace duckdb
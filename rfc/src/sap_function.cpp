@@ -7,9 +7,12 @@
 
 #include "sap_rfc_api.hpp"
 #include "duckdb.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb_argument_helper.hpp"
 #include "sap_function.hpp"
+#include "sap_metadata_cache.hpp"
 #include "erpl_tracing.hpp"
+#include "sap_trace_spans.hpp"
 
 static std::atomic<bool> g_rfc_strict_type_check{false};
 
@@ -154,6 +157,11 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
         return _handle != NULL;
     }
 
+    RFCTYPE RfcType::GetRfcTypeAsEnum() const
+    {
+        return _rfc_type;
+    }
+
     std::string RfcType::GetName() const
     {
         if (_handle == NULL) {
@@ -406,9 +414,14 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
     void RfcType::AdaptValue(DATA_CONTAINER_HANDLE &container_handle, string &arg_name, Value &arg_value) 
     {
+        // Names and text are converted into per-thread buffers that are
+        // reused across calls, so a scalar costs no heap allocation.  The
+        // name is only read before a STRUCTURE/TABLE recursion reuses it.
+        static thread_local std::vector<SAP_UC> uc_name_buffer;
+        static thread_local std::vector<SAP_UC> uc_value_buffer;
+
         RFC_RC rc = RFC_OK;
         RFC_ERROR_INFO error_info;
-        auto sap_arg_name = std2uc(arg_name);
 
         // A NULL DuckDB value means "leave this field at the SDK's initial
         // value" — exactly what the CHAR/STRING/XSTRING/BYTE/UTC branches below
@@ -422,41 +435,46 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
             return;
         }
 
+        utf82uc(arg_name.data(), arg_name.size(), uc_name_buffer);
+        const SAP_UC *sap_arg_name = uc_name_buffer.data();
+
         switch(_rfc_type)
         {
             // Numeric types
             case RFCTYPE_NUM:
             {
-                auto string_value = std2uc(arg_value.GetValue<std::string>());
-                rc = RfcSetNum(container_handle, sap_arg_name.get(), string_value.get(), strlenU(string_value.get()), &error_info);
+                auto string_value = arg_value.type().id() == LogicalTypeId::VARCHAR ? StringValue::Get(arg_value)
+                                                                                     : arg_value.GetValue<std::string>();
+                auto len = utf82uc(string_value.data(), string_value.size(), uc_value_buffer);
+                rc = RfcSetNum(container_handle, sap_arg_name, (RFC_NUM *)uc_value_buffer.data(), len, &error_info);
                 break;
             }
             case RFCTYPE_INT:
             {
                 RFC_INT int_value;
                 duck2rfc(arg_value, int_value);
-                rc = RfcSetInt(container_handle, sap_arg_name.get(), int_value, &error_info);
+                rc = RfcSetInt(container_handle, sap_arg_name, int_value, &error_info);
                 break;
             }
             case RFCTYPE_INT1:
             {
                 RFC_INT1 int_value;
                 duck2rfc(arg_value, int_value);
-                rc = RfcSetInt1(container_handle, sap_arg_name.get(), int_value, &error_info);
+                rc = RfcSetInt1(container_handle, sap_arg_name, int_value, &error_info);
                 break;
             }
             case RFCTYPE_INT2:
             {
                 RFC_INT2 int_value;
                 duck2rfc(arg_value, int_value);
-                rc = RfcSetInt2(container_handle, sap_arg_name.get(), int_value, &error_info);
+                rc = RfcSetInt2(container_handle, sap_arg_name, int_value, &error_info);
                 break;
             }
             case RFCTYPE_INT8:
             {
                 RFC_INT8 int_value;
                 duck2rfc(arg_value, int_value);
-                rc = RfcSetInt8(container_handle, sap_arg_name.get(), int_value, &error_info);
+                rc = RfcSetInt8(container_handle, sap_arg_name, int_value, &error_info);
                 break;
             }
             case RFCTYPE_BCD:
@@ -464,26 +482,26 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
             case RFCTYPE_DECF34:
             {
                 auto string_value = arg_value.DefaultCastAs(LogicalType::VARCHAR).ToString();
-                auto bcd_value = std2uc(string_value);
-                rc = RfcSetString(container_handle, sap_arg_name.get(), bcd_value.get(), strlenU(bcd_value.get()), &error_info);
+                auto len = utf82uc(string_value.data(), string_value.size(), uc_value_buffer);
+                rc = RfcSetString(container_handle, sap_arg_name, uc_value_buffer.data(), len, &error_info);
                 break;
             }
             case RFCTYPE_FLOAT:
             {
                 RFC_FLOAT float_value;
                 duck2rfc(arg_value, float_value);
-                rc = RfcSetFloat(container_handle, sap_arg_name.get(), float_value, &error_info);
+                rc = RfcSetFloat(container_handle, sap_arg_name, float_value, &error_info);
                 break;
             }
             // Character types
             case RFCTYPE_CHAR:
             case RFCTYPE_STRING:
             {
-                if (! arg_value.IsNull()) {
-                    auto string_value = duck2uc(arg_value);
-                    rc = RfcSetString(container_handle, sap_arg_name.get(), string_value.get(), strlenU(string_value.get()), &error_info);
-                }
-
+                // Converted with the explicit length: an embedded NUL is data,
+                // not the end of the string.
+                auto &string_value = StringValue::Get(arg_value);
+                auto len = utf82uc(string_value.data(), string_value.size(), uc_value_buffer);
+                rc = RfcSetString(container_handle, sap_arg_name, uc_value_buffer.data(), len, &error_info);
                 break;
             }
             case RFCTYPE_XSTRING:
@@ -494,7 +512,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
                     break;
                 }
                 auto bytes = StringValue::Get(arg_value);
-                rc = RfcSetXString(container_handle, sap_arg_name.get(),
+                rc = RfcSetXString(container_handle, sap_arg_name,
                                    reinterpret_cast<const SAP_RAW *>(bytes.data()),
                                    static_cast<unsigned int>(bytes.size()),
                                    &error_info);
@@ -510,7 +528,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
                     break;
                 }
                 auto bytes = StringValue::Get(arg_value);
-                rc = RfcSetBytes(container_handle, sap_arg_name.get(),
+                rc = RfcSetBytes(container_handle, sap_arg_name,
                                  reinterpret_cast<const SAP_RAW *>(bytes.data()),
                                  static_cast<unsigned int>(bytes.size()),
                                  &error_info);
@@ -521,7 +539,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
             {
                 RFC_TIME time_value;
                 duck2rfc(arg_value, time_value);
-                rc = RfcSetTime(container_handle, sap_arg_name.get(), time_value, &error_info);
+                rc = RfcSetTime(container_handle, sap_arg_name, time_value, &error_info);
                 if (rc != RFC_OK)
                 {
                     throw std::runtime_error(StringUtil::Format("Error when putting DuckDB value %s into time field of type %s", arg_value.ToString().c_str(), rfctype2std(_rfc_type)));
@@ -532,7 +550,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
             {
                 RFC_DATE date_value;
                 duck2rfc(arg_value, date_value);
-                rc = RfcSetDate(container_handle, sap_arg_name.get(), date_value, &error_info);
+                rc = RfcSetDate(container_handle, sap_arg_name, date_value, &error_info);
                 if (rc != RFC_OK)
                 {
                     throw std::runtime_error(StringUtil::Format("Error when putting DuckDB value %s into date field of type %s", arg_value.ToString().c_str(), rfctype2std(_rfc_type)));
@@ -551,16 +569,16 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
                 if (arg_value.IsNull()) {
                     break;
                 }
-                auto utc_str = std2uc(timestamp2sap_utc(arg_value));
-                rc = RfcSetString(container_handle, sap_arg_name.get(),
-                                  utc_str.get(), strlenU(utc_str.get()), &error_info);
+                auto utc_str = timestamp2sap_utc(arg_value);
+                auto len = utf82uc(utc_str.data(), utc_str.size(), uc_value_buffer);
+                rc = RfcSetString(container_handle, sap_arg_name, uc_value_buffer.data(), len, &error_info);
                 break;
             }
             // Complex types
             case RFCTYPE_STRUCTURE:
             {
                 RFC_STRUCTURE_HANDLE struct_handle = NULL;
-                rc = RfcGetStructure(container_handle, sap_arg_name.get(), &struct_handle, &error_info);
+                rc = RfcGetStructure(container_handle, sap_arg_name, &struct_handle, &error_info);
                 if (rc != RFC_OK || struct_handle == NULL)
                 {
                     throw std::runtime_error(StringUtil::Format("Failed to get structure %s: %s: %s", arg_name, rfcrc2std(error_info.code), uc2std(error_info.message)));
@@ -572,7 +590,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
             case RFCTYPE_TABLE:
             {
                 RFC_TABLE_HANDLE table_handle = NULL;
-                rc = RfcGetTable(container_handle, sap_arg_name.get(), &table_handle, &error_info);
+                rc = RfcGetTable(container_handle, sap_arg_name, &table_handle, &error_info);
                 if (rc != RFC_OK || table_handle == NULL)
                 {
                     throw std::runtime_error(StringUtil::Format("Failed to get table '%s', got an invalid handle.", arg_name));
@@ -588,10 +606,10 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
                 }
                 break;
             }
+        }
 
-            if (rc != RFC_OK) {
-                throw std::runtime_error(StringUtil::Format("Failed to set argument %s: %s: %s", arg_name, rfcrc2std(error_info.code), uc2std(error_info.message)));
-            }
+        if (rc != RFC_OK) {
+            throw std::runtime_error(StringUtil::Format("Failed to set argument %s: %s: %s", arg_name, rfcrc2std(error_info.code), uc2std(error_info.message)));
         }
     }
 
@@ -1338,15 +1356,32 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
         _function_name(function_name), _connection(connection)
     {
         RFC_ERROR_INFO error_info;
-        _desc_handle = RfcGetFunctionDesc(connection->handle, std2uc(function_name).get(), &error_info);
-        if (_desc_handle == NULL || error_info.code != RFC_OK) {
+        _desc_handle = LookupDescription(connection->handle, function_name, error_info);
+        if (_desc_handle == NULL) {
             throw std::runtime_error(StringUtil::Format("Error getting function description: %s: %s",
                                                         rfcrc2std(error_info.code), uc2std(error_info.message)));
         }
+    }
+
+    RfcFunction::RfcFunction(std::shared_ptr<RfcConnection> &connection, std::string function_name,
+                             RFC_FUNCTION_DESC_HANDLE desc_handle) :
+        _function_name(function_name), _connection(connection), _desc_handle(desc_handle)
+    { }
+
+    RFC_FUNCTION_DESC_HANDLE RfcFunction::LookupDescription(RFC_CONNECTION_HANDLE connection_handle,
+                                                            const std::string &function_name,
+                                                            RFC_ERROR_INFO &error_info)
+    {
+        RfcTraceSpan span("RfcGetFunctionDesc", "metadata", function_name);
+        auto desc_handle = RfcGetFunctionDesc(connection_handle, std2uc(function_name).get(), &error_info);
+        if (desc_handle == NULL || error_info.code != RFC_OK) {
+            return NULL;
+        }
 
         // The SDK has now built its global repository, so its teardown is
         // registered and ours can be ordered ahead of it (issue #112).
         EnsureSdkExitGuardInstalled();
+        return desc_handle;
     }
 
     RfcFunction::~RfcFunction() noexcept
@@ -1593,6 +1628,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
             try {
                 param_type->AdaptValue(_invocation, param_name, arg_value);
+                _invocation.MarkParameterSupplied(param_name);
             } catch (std::exception &ex) {
                 throw std::runtime_error(StringUtil::Format(
                     "Failed to adapt positional argument %u ('%s'): %s",
@@ -1658,6 +1694,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
             }
 
             param_type->AdaptValue(_invocation, param_name, child_value);
+            _invocation.MarkParameterSupplied(param_name);
             return;
         }
 
@@ -1750,6 +1787,10 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
     {
         RFC_ERROR_INFO error_info;
         auto connection = GetFunction()->GetConnection();
+        RfcTraceSpan span("RfcInvoke", "rfc");
+        if (span.Recording()) {
+            span.SetDetail(GetFunction()->GetName());
+        }
 
         RFC_RC rc = RfcInvoke(connection->handle, _handle, &error_info);
         if (rc != RFC_OK) {
@@ -1759,6 +1800,9 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
     std::shared_ptr<RfcResultSet> RfcInvocation::Invoke(std::string path)
     {
+        if (!path.empty()) {
+            DeactivateResultsOutsidePath(path);
+        }
         Execute();
         return std::make_shared<RfcResultSet>(shared_from_this(), path);
     }
@@ -1851,6 +1895,52 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
         SelectResultAndDeactivateOthers(result_info);
     }
 
+    void RfcInvocation::DeactivateResultsOutsidePath(const std::string &path)
+    {
+        auto tokens = ValueHelper::ParseJsonPointer(path);
+        if (tokens.empty()) {
+            return;
+        }
+        DeactivateResultsExcept({ tokens[0] });
+    }
+
+    void RfcInvocation::DeactivateResultsExcept(const std::vector<std::string> &keep)
+    {
+        std::vector<std::string> deactivated;
+        for (auto &result_info : GetFunction()->GetResultInfos()) {
+            auto param_name = result_info.GetName();
+            if (std::find(keep.begin(), keep.end(), param_name) != keep.end() ||
+                _supplied_params.find(param_name) != _supplied_params.end()) {
+                continue;
+            }
+            DeactivateResult(param_name);
+            deactivated.push_back(param_name);
+        }
+
+        if (!deactivated.empty()) {
+            ERPL_TRACE_DEBUG_DATA("RfcInvocation", "Deactivated unused result parameters",
+                                  StringUtil::Join(deactivated, ", "));
+        }
+    }
+
+    void RfcInvocation::MarkParameterSupplied(const std::string &param_name)
+    {
+        _supplied_params.insert(param_name);
+    }
+
+    RFC_TABLE_HANDLE RfcInvocation::GetTableParameter(const std::string &param_name)
+    {
+        RFC_ERROR_INFO error_info;
+        RFC_TABLE_HANDLE table_handle = nullptr;
+        auto rc = RfcGetTable(_handle, std2uc(param_name).get(), &table_handle, &error_info);
+        if (rc != RFC_OK || table_handle == nullptr) {
+            throw std::runtime_error(StringUtil::Format("Failed to get table %s: %s: %s", param_name,
+                                                        rfcrc2std(error_info.code), uc2std(error_info.message)));
+        }
+        MarkParameterSupplied(param_name);
+        return table_handle;
+    }
+
     RFC_FUNCTION_HANDLE RfcInvocation::GetFunctionHandle() const
     {
         return _handle;
@@ -1862,13 +1952,602 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
         return (DATA_CONTAINER_HANDLE)func_handle;
     }
 
+    void RfcInvocation::SetParameter(const std::string &param_name, Value value)
+    {
+        auto param_info = GetFunction()->GetParameterInfo(param_name);
+        auto name = param_info.GetName();
+        param_info.GetRfcType()->AdaptValue(*this, name, value);
+    }
+
+    void RfcInvocation::ClearResultTables(const std::set<std::string> &input_tables)
+    {
+        RFC_ERROR_INFO error_info;
+
+        for (auto &param : GetFunction()->GetParameterInfos()) {
+            if (param.GetDirection() != RFC_TABLES) {
+                continue;
+            }
+            auto param_name = param.GetName();
+            if (input_tables.find(param_name) != input_tables.end()) {
+                continue;
+            }
+
+            RFC_TABLE_HANDLE table_handle = nullptr;
+            auto rc = RfcGetTable(_handle, std2uc(param_name).get(), &table_handle, &error_info);
+            if (rc == RFC_OK && table_handle != nullptr) {
+                rc = RfcDeleteAllRows(table_handle, &error_info);
+            }
+            if (rc != RFC_OK) {
+                throw std::runtime_error(StringUtil::Format("Failed to clear result table %s: %s: %s",
+                                                            param_name, rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+        }
+    }
+
+    bool RfcInvocation::PrepareNextCall(const std::set<std::string> &input_tables,
+                                        const std::vector<std::pair<std::string, Value>> &parameters)
+    {
+        try {
+            ClearResultTables(input_tables);
+            for (auto &parameter : parameters) {
+                SetParameter(parameter.first, parameter.second);
+            }
+            return true;
+        } catch (std::exception &e) {
+            ERPL_TRACE_DEBUG_DATA("RfcInvocation", "Invocation not reusable", std::string(e.what()));
+            return false;
+        }
+    }
+
     // RfcInvocation ------------------------------------------------------------
 
+    // The DuckDB type a column is cast to before it is written with the typed
+    // SDK setter of `rfc_type`.  INVALID for types that take the
+    // RfcType::AdaptValue fallback.
+    static LogicalType StagingType(RFCTYPE rfc_type)
+    {
+        switch (rfc_type) {
+            case RFCTYPE_INT:
+                return LogicalType::INTEGER;
+            case RFCTYPE_INT1:
+                return LogicalType::UTINYINT;
+            case RFCTYPE_INT2:
+                return LogicalType::SMALLINT;
+            case RFCTYPE_INT8:
+                return LogicalType::BIGINT;
+            case RFCTYPE_FLOAT:
+                return LogicalType::DOUBLE;
+            case RFCTYPE_DATE:
+                return LogicalType::DATE;
+            case RFCTYPE_TIME:
+                return LogicalType::TIME;
+            // Packed and decimal floating point numbers travel as their
+            // decimal text, exactly as in RfcType::AdaptValue.
+            case RFCTYPE_CHAR:
+            case RFCTYPE_STRING:
+            case RFCTYPE_NUM:
+            case RFCTYPE_BCD:
+            case RFCTYPE_DECF16:
+            case RFCTYPE_DECF34:
+                return LogicalType::VARCHAR;
+            case RFCTYPE_BYTE:
+            case RFCTYPE_XSTRING:
+                return LogicalType::BLOB;
+            default:
+                return LogicalType::INVALID;
+        }
+    }
+
+    // Writes one cell of a staged column with the typed SDK setter.  Text
+    // goes through `uc_buffer` with its explicit length, so it is
+    // binary-safe and no SAP_UC string is allocated per cell.
+    static RFC_RC SetStagedField(DATA_CONTAINER_HANDLE container, RFCTYPE rfc_type, const SAP_UC *name,
+                                 const UnifiedVectorFormat &format, idx_t idx, std::vector<SAP_UC> &uc_buffer,
+                                 RFC_ERROR_INFO &error_info)
+    {
+        RFC_RC rc = RFC_OK;
+
+        switch (rfc_type) {
+            case RFCTYPE_INT:
+                rc = RfcSetInt(container, name, UnifiedVectorFormat::GetData<int32_t>(format)[idx], &error_info);
+                break;
+            case RFCTYPE_INT1:
+                rc = RfcSetInt1(container, name, UnifiedVectorFormat::GetData<uint8_t>(format)[idx], &error_info);
+                break;
+            case RFCTYPE_INT2:
+                rc = RfcSetInt2(container, name, UnifiedVectorFormat::GetData<int16_t>(format)[idx], &error_info);
+                break;
+            case RFCTYPE_INT8:
+                rc = RfcSetInt8(container, name, UnifiedVectorFormat::GetData<int64_t>(format)[idx], &error_info);
+                break;
+            case RFCTYPE_FLOAT:
+                rc = RfcSetFloat(container, name, UnifiedVectorFormat::GetData<double>(format)[idx], &error_info);
+                break;
+            case RFCTYPE_DATE:
+            {
+                RFC_DATE date_value;
+                duck2rfc(UnifiedVectorFormat::GetData<date_t>(format)[idx], date_value);
+                rc = RfcSetDate(container, name, date_value, &error_info);
+                break;
+            }
+            case RFCTYPE_TIME:
+            {
+                RFC_TIME time_value;
+                duck2rfc(UnifiedVectorFormat::GetData<dtime_t>(format)[idx], time_value);
+                rc = RfcSetTime(container, name, time_value, &error_info);
+                break;
+            }
+            case RFCTYPE_NUM:
+            {
+                auto &str = UnifiedVectorFormat::GetData<string_t>(format)[idx];
+                auto len = utf82uc(str.GetData(), str.GetSize(), uc_buffer);
+                rc = RfcSetNum(container, name, (RFC_NUM *)uc_buffer.data(), len, &error_info);
+                break;
+            }
+            case RFCTYPE_CHAR:
+            case RFCTYPE_STRING:
+            case RFCTYPE_BCD:
+            case RFCTYPE_DECF16:
+            case RFCTYPE_DECF34:
+            {
+                auto &str = UnifiedVectorFormat::GetData<string_t>(format)[idx];
+                auto len = utf82uc(str.GetData(), str.GetSize(), uc_buffer);
+                rc = RfcSetString(container, name, uc_buffer.data(), len, &error_info);
+                break;
+            }
+            case RFCTYPE_BYTE:
+            {
+                auto &bytes = UnifiedVectorFormat::GetData<string_t>(format)[idx];
+                rc = RfcSetBytes(container, name, reinterpret_cast<const SAP_RAW *>(bytes.GetData()),
+                                 static_cast<unsigned int>(bytes.GetSize()), &error_info);
+                break;
+            }
+            case RFCTYPE_XSTRING:
+            {
+                auto &bytes = UnifiedVectorFormat::GetData<string_t>(format)[idx];
+                rc = RfcSetXString(container, name, reinterpret_cast<const SAP_RAW *>(bytes.GetData()),
+                                   static_cast<unsigned int>(bytes.GetSize()), &error_info);
+                break;
+            }
+            default:
+                break;
+        }
+
+        return rc;
+    }
+
+    RfcTableAppender::RfcTableAppender(std::shared_ptr<RfcType> table_type, const std::string &param_name,
+                                       const std::vector<std::string> &column_names,
+                                       const std::vector<LogicalType> &column_types)
+        : _param_name(param_name)
+    {
+        if (table_type->GetRfcTypeAsEnum() != RFCTYPE_TABLE) {
+            throw std::runtime_error(StringUtil::Format("Parameter '%s' is of type '%s', not a table",
+                                                        param_name, table_type->GetName()));
+        }
+
+        auto field_infos = table_type->GetFieldInfos();
+        auto is_elementary_line = field_infos.size() == 1 && field_infos[0].GetName().empty();
+        if (is_elementary_line && column_names.size() != 1) {
+            throw std::runtime_error(StringUtil::Format("Table '%s' has an elementary line type and takes exactly one column, got %llu",
+                                                        param_name, column_names.size()));
+        }
+
+        for (idx_t col_idx = 0; col_idx < column_names.size(); col_idx++) {
+            auto field_it = field_infos.begin();
+            if (!is_elementary_line) {
+                auto name = StringUtil::Upper(column_names[col_idx]);
+                field_it = std::find_if(field_infos.begin(), field_infos.end(), [&](auto &f) {
+                    return f.GetName() == name;
+                });
+                if (field_it == field_infos.end()) {
+                    throw std::runtime_error(StringUtil::Format("Column '%s' is not a field of table '%s'",
+                                                                column_names[col_idx], param_name));
+                }
+            }
+
+            auto field_type = field_it->GetRfcType();
+            auto rfc_type = field_type->GetRfcTypeAsEnum();
+            auto field_name = field_it->GetName();
+            // Same rule as the named adapter: the DuckDB type must be one the
+            // RFC type accepts, checked once here instead of per value.
+            if (!field_type->IsCompatibleType(column_types[col_idx].id())) {
+                throw std::runtime_error(StringUtil::Format("Field '%s' of table '%s' is of type '%s' (RFC) but column is of type '%s' (DuckDB)",
+                                                            field_name, param_name, field_type->GetName(), column_types[col_idx].ToString()));
+            }
+
+            _columns.push_back(Column { col_idx, field_name, std2uc(field_name), rfc_type, field_type, StagingType(rfc_type) });
+        }
+    }
+
+    void RfcTableAppender::Append(RFC_TABLE_HANDLE table_handle, DataChunk &chunk)
+    {
+        auto count = chunk.size();
+        if (count == 0) {
+            return;
+        }
+
+        // Cast each column once per chunk, then read cells through the
+        // unified format so constant and dictionary vectors need no copy.
+        std::vector<unique_ptr<Vector>> staged(_columns.size());
+        std::vector<UnifiedVectorFormat> formats(_columns.size());
+        for (idx_t i = 0; i < _columns.size(); i++) {
+            auto &column = _columns[i];
+            auto &source = chunk.data[column.input_idx];
+            if (column.staging_type.id() == LogicalTypeId::INVALID || source.GetType() == column.staging_type) {
+                source.ToUnifiedFormat(count, formats[i]);
+                continue;
+            }
+            staged[i] = make_uniq<Vector>(column.staging_type, count);
+            VectorOperations::DefaultCast(source, *staged[i], count);
+            staged[i]->ToUnifiedFormat(count, formats[i]);
+        }
+
+        RFC_ERROR_INFO error_info;
+        for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+            auto row_handle = RfcAppendNewRow(table_handle, &error_info);
+            if (row_handle == nullptr) {
+                throw std::runtime_error(StringUtil::Format("Failed to append new row to table %s: %s: %s",
+                                                            _param_name, rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+
+            for (idx_t i = 0; i < _columns.size(); i++) {
+                auto &column = _columns[i];
+                if (column.staging_type.id() == LogicalTypeId::INVALID) {
+                    auto value = chunk.GetValue(column.input_idx, row_idx);
+                    DATA_CONTAINER_HANDLE container = row_handle;
+                    column.type->AdaptValue(container, column.field_name, value);
+                    continue;
+                }
+
+                auto idx = formats[i].sel->get_index(row_idx);
+                if (!formats[i].validity.RowIsValid(idx)) {
+                    continue;
+                }
+                auto rc = SetStagedField(row_handle, column.rfc_type, column.uc_field_name.get(), formats[i], idx,
+                                         _uc_buffer, error_info);
+                if (rc != RFC_OK) {
+                    throw std::runtime_error(StringUtil::Format("Failed to set field %s of table %s: %s: %s", column.field_name,
+                                                                _param_name, rfcrc2std(error_info.code), uc2std(error_info.message)));
+                }
+            }
+        }
+        _row_count += count;
+    }
+
+    idx_t RfcTableAppender::RowCount() const
+    {
+        return _row_count;
+    }
+
+    // RfcTableAppender ---------------------------------------------------------
+
+    RfcImportAdapter::RfcImportAdapter(RfcFunction &function, const std::vector<std::string> &column_names,
+                                       const std::vector<LogicalType> &column_types)
+    {
+        auto param_infos = function.GetParameterInfos();
+        for (idx_t col_idx = 0; col_idx < column_names.size(); col_idx++) {
+            auto name = StringUtil::Upper(column_names[col_idx]);
+            auto param_it = std::find_if(param_infos.begin(), param_infos.end(), [&](auto &p) {
+                return p.GetDirection() != RFC_EXPORT && p.GetName() == name;
+            });
+            if (param_it == param_infos.end()) {
+                throw std::runtime_error(StringUtil::Format("Input column '%s' does not match an import, changing or tables parameter of '%s'",
+                                                            column_names[col_idx], function.GetName()));
+            }
+
+            auto param_type = param_it->GetRfcType();
+            auto rfc_type = param_type->GetRfcTypeAsEnum();
+            // The named adapter's rule, checked once per column.  An untyped
+            // NULL column only ever leaves the parameter at its default.
+            auto column_type = column_types[col_idx].id();
+            if (column_type != LogicalTypeId::SQLNULL && !param_type->IsCompatibleType(column_type)) {
+                throw std::runtime_error(StringUtil::Format("Parameter '%s' is of type '%s' (RFC) but column is of type '%s' (DuckDB)",
+                                                            name, param_type->GetName(), column_types[col_idx].ToString()));
+            }
+
+            _columns.push_back(Column { name, std2uc(name), rfc_type, param_type, StagingType(rfc_type) });
+        }
+    }
+
+    void RfcImportAdapter::Stage(DataChunk &chunk, Batch &batch) const
+    {
+        auto count = chunk.size();
+        batch.chunk = &chunk;
+        batch.staged.clear();
+        batch.staged.resize(_columns.size());
+        batch.formats.clear();
+        batch.formats.resize(_columns.size());
+        for (idx_t i = 0; i < _columns.size(); i++) {
+            auto &column = _columns[i];
+            auto &source = chunk.data[i];
+            if (column.staging_type.id() == LogicalTypeId::INVALID || source.GetType() == column.staging_type) {
+                source.ToUnifiedFormat(count, batch.formats[i]);
+                continue;
+            }
+            batch.staged[i] = make_uniq<Vector>(column.staging_type, count);
+            VectorOperations::DefaultCast(source, *batch.staged[i], count);
+            batch.staged[i]->ToUnifiedFormat(count, batch.formats[i]);
+        }
+    }
+
+    void RfcImportAdapter::Adapt(RfcInvocation &invocation, const Batch &batch, idx_t row_idx) const
+    {
+        // One per worker thread, reused across rows and calls.
+        static thread_local std::vector<SAP_UC> uc_buffer;
+
+        RFC_ERROR_INFO error_info;
+        DATA_CONTAINER_HANDLE container = invocation.GetFunctionHandle();
+        for (idx_t i = 0; i < _columns.size(); i++) {
+            auto &column = _columns[i];
+            auto &format = batch.formats[i];
+            auto idx = format.sel->get_index(row_idx);
+            if (!format.validity.RowIsValid(idx)) {
+                continue;
+            }
+
+            if (column.staging_type.id() == LogicalTypeId::INVALID) {
+                auto value = batch.chunk->GetValue(i, row_idx);
+                auto param_name = column.param_name;
+                column.type->AdaptValue(container, param_name, value);
+            } else {
+                auto rc = SetStagedField(container, column.rfc_type, column.uc_param_name.get(), format, idx,
+                                         uc_buffer, error_info);
+                if (rc != RFC_OK) {
+                    throw std::runtime_error(StringUtil::Format("Failed to set parameter %s: %s: %s", column.param_name,
+                                                                rfcrc2std(error_info.code), uc2std(error_info.message)));
+                }
+            }
+            invocation.MarkParameterSupplied(column.param_name);
+        }
+    }
+
+    // RfcImportAdapter ---------------------------------------------------------
+
+    RfcVectorLayout::RfcVectorLayout(const std::string &field_name, std::shared_ptr<RfcType> rfc_type)
+        : _field_name(field_name), _uc_field_name(std2uc(field_name)), _rfc_type(rfc_type),
+          _rfc_kind(rfc_type->GetRfcTypeAsEnum()), _unwrap_line(false)
+    {
+        if (_rfc_kind != RFCTYPE_STRUCTURE && _rfc_kind != RFCTYPE_TABLE) {
+            return;
+        }
+        for (auto &field_info : _rfc_type->GetFieldInfos()) {
+            _children.emplace_back(field_info.GetName(), field_info.GetRfcType());
+        }
+        _unwrap_line = _rfc_kind == RFCTYPE_TABLE && _children.size() == 1 && _children[0]._field_name.empty();
+    }
+
+    void RfcVectorLayout::Write(DATA_CONTAINER_HANDLE container_handle, Vector &target, idx_t row_idx) const
+    {
+        RFC_ERROR_INFO error_info;
+        switch (_rfc_kind)
+        {
+            case RFCTYPE_STRUCTURE:
+            {
+                RFC_STRUCTURE_HANDLE struct_handle;
+                auto rc = RfcGetStructure(container_handle, _uc_field_name.get(), &struct_handle, &error_info);
+                if (rc != RFC_OK) {
+                    throw std::runtime_error(StringUtil::Format("Failed to get structure %s: %s: %s", _field_name,
+                                                                rfcrc2std(error_info.code), uc2std(error_info.message)));
+                }
+                WriteFields(struct_handle, target, row_idx);
+                return;
+            }
+            case RFCTYPE_TABLE:
+            {
+                RFC_TABLE_HANDLE table_handle;
+                auto rc = RfcGetTable(container_handle, _uc_field_name.get(), &table_handle, &error_info);
+                if (rc != RFC_OK) {
+                    throw std::runtime_error(StringUtil::Format("Failed to get table %s: %s: %s", _field_name,
+                                                                rfcrc2std(error_info.code), uc2std(error_info.message)));
+                }
+                WriteTable(table_handle, target, row_idx);
+                return;
+            }
+            default:
+                WriteElementary(container_handle, target, row_idx);
+                return;
+        }
+    }
+
+    void RfcVectorLayout::WriteElementary(DATA_CONTAINER_HANDLE container_handle, Vector &target, idx_t row_idx) const
+    {
+        RFC_ERROR_INFO error_info;
+        auto rc = RFC_OK;
+
+        // Fixed-width numbers go straight into the flat vector; everything
+        // else keeps the per-type conversion of ConvertRfcValue, one scalar
+        // Value per cell.
+        switch (_rfc_kind)
+        {
+            case RFCTYPE_INT:
+            {
+                RFC_INT int_value;
+                rc = RfcGetInt(container_handle, _uc_field_name.get(), &int_value, &error_info);
+                if (rc != RFC_OK) { break; }
+                FlatVector::GetData<int64_t>(target)[row_idx] = int_value;
+                return;
+            }
+            case RFCTYPE_INT2:
+            {
+                RFC_INT2 int2_value;
+                rc = RfcGetInt2(container_handle, _uc_field_name.get(), &int2_value, &error_info);
+                if (rc != RFC_OK) { break; }
+                FlatVector::GetData<int16_t>(target)[row_idx] = (int16_t)int2_value;
+                return;
+            }
+            case RFCTYPE_INT8:
+            {
+                RFC_INT8 int8_value;
+                rc = RfcGetInt8(container_handle, _uc_field_name.get(), &int8_value, &error_info);
+                if (rc != RFC_OK) { break; }
+                FlatVector::GetData<int64_t>(target)[row_idx] = (int64_t)int8_value;
+                return;
+            }
+            case RFCTYPE_FLOAT:
+            {
+                RFC_FLOAT float_value;
+                rc = RfcGetFloat(container_handle, _uc_field_name.get(), &float_value, &error_info);
+                if (rc != RFC_OK) { break; }
+                FlatVector::GetData<double>(target)[row_idx] = (double)float_value;
+                return;
+            }
+            default:
+                target.SetValue(row_idx, _rfc_type->ConvertRfcValueFromContainer(container_handle, _field_name));
+                return;
+        }
+
+        throw std::runtime_error(StringUtil::Format("Failed to get %s %s: %s: %s", rfctype2std(_rfc_kind), _field_name,
+                                                    rfcrc2std(error_info.code), uc2std(error_info.message)));
+    }
+
+    void RfcVectorLayout::WriteFields(DATA_CONTAINER_HANDLE struct_handle, Vector &target, idx_t row_idx) const
+    {
+        auto &entries = StructVector::GetEntries(target);
+        for (idx_t i = 0; i < _children.size(); i++) {
+            _children[i].Write(struct_handle, *entries[i], row_idx);
+        }
+    }
+
+    void RfcVectorLayout::WriteTable(RFC_TABLE_HANDLE table_handle, Vector &target, idx_t row_idx) const
+    {
+        RFC_ERROR_INFO error_info;
+        unsigned int row_count = 0;
+        auto rc = RfcGetRowCount(table_handle, &row_count, &error_info);
+        if (rc != RFC_OK) {
+            throw std::runtime_error(StringUtil::Format("Failed to get row count: %s: %s",
+                                                        rfcrc2std(error_info.code), uc2std(error_info.message)));
+        }
+
+        // Lines are appended to the list's child vector in place; nested
+        // tables of a line grow their own child vectors the same way.
+        auto offset = ListVector::GetListSize(target);
+        ListVector::Reserve(target, offset + row_count);
+        FlatVector::GetData<list_entry_t>(target)[row_idx] = list_entry_t(offset, row_count);
+        auto &lines = ListVector::GetEntry(target);
+
+        for (unsigned int i = 0; i < row_count; i++) {
+            rc = RfcMoveTo(table_handle, i, &error_info);
+            if (rc != RFC_OK) {
+                throw std::runtime_error(StringUtil::Format("Failed to move to row %d: %s: %s", i,
+                                                            rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+            auto line_handle = RfcGetCurrentRow(table_handle, &error_info);
+            if (line_handle == NULL) {
+                throw std::runtime_error(StringUtil::Format("Failed to get row %d: %s: %s", i,
+                                                            rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+            if (_unwrap_line) {
+                _children[0].Write(line_handle, lines, offset + i);
+            } else {
+                WriteFields(line_handle, lines, offset + i);
+            }
+        }
+        ListVector::SetListSize(target, offset + row_count);
+    }
+
+    // RfcVectorLayout ----------------------------------------------------------
+
     RfcResultSet::RfcResultSet(std::shared_ptr<RfcInvocation> invocation, std::string path) 
-        : _invocation(invocation), _path(path), _total_rows(0), _current_row_idx(0)
+        : _invocation(invocation), _path(path), _total_rows(0), _current_row_idx(0),
+          _table_handle(nullptr), _row_container(nullptr), _materialized(false)
+    {
+        std::tie(_result_names, _result_types) = InferResultSchema(*_invocation->GetFunction(), path);
+        if (!OpenDirectReader(path)) {
+            EnsureMaterialized();
+        }
+    }
+
+    bool RfcResultSet::OpenDirectReader(std::string path)
     {
-        std::tie(_result_names, _result_types) = InferResultSchema(path);
-        _result_data = ConvertValuesAndSelectPath(path);
+        auto tokens = ValueHelper::ParseJsonPointer(path);
+        if (tokens.empty()) {
+            // One row, one column per result parameter.
+            _row_container = _invocation->GetFunctionHandle();
+            for (auto &param_info : _invocation->GetFunction()->GetResultInfos()) {
+                _column_layouts.emplace_back(param_info.GetName(), param_info.GetRfcType());
+            }
+            _total_rows = 1;
+            return true;
+        }
+
+        // InferResultSchema has already validated every token, so this only
+        // has to follow them: through structures, ending on a table or on a
+        // structure.
+        RFC_ERROR_INFO error_info;
+        DATA_CONTAINER_HANDLE container = _invocation->GetFunctionHandle();
+        auto rfc_type = _invocation->GetFunction()->GetResultInfo(tokens[0]).GetRfcType();
+        for (std::size_t i = 0; i < tokens.size(); i++) {
+            if (i > 0) {
+                rfc_type = rfc_type->GetFieldInfo(tokens[i]).GetRfcType();
+            }
+            auto is_last = i + 1 == tokens.size();
+            auto name = std2uc(tokens[i]);
+
+            if (rfc_type->GetRfcTypeAsEnum() == RFCTYPE_TABLE && is_last) {
+                // Tables with an unnamed elementary line type have no field
+                // to read cells by; they stay on the converting path.
+                auto row_fields = rfc_type->GetFieldInfos();
+                if (row_fields.empty() || std::any_of(row_fields.begin(), row_fields.end(),
+                                                      [](auto &f) { return f.GetName().empty(); })) {
+                    return false;
+                }
+
+                RFC_TABLE_HANDLE table_handle = nullptr;
+                auto rc = RfcGetTable(container, name.get(), &table_handle, &error_info);
+                if (rc != RFC_OK) {
+                    throw std::runtime_error(StringUtil::Format("Failed to get table %s: %s: %s", tokens[i],
+                                                                rfcrc2std(error_info.code), uc2std(error_info.message)));
+                }
+                unsigned int row_count = 0;
+                rc = RfcGetRowCount(table_handle, &row_count, &error_info);
+                if (rc != RFC_OK) {
+                    throw std::runtime_error(StringUtil::Format("Failed to get row count: %s: %s",
+                                                                rfcrc2std(error_info.code), uc2std(error_info.message)));
+                }
+                _table_handle = table_handle;
+                for (auto &field : row_fields) {
+                    _column_layouts.emplace_back(field.GetName(), field.GetRfcType());
+                }
+                _total_rows = row_count;
+                return true;
+            }
+            if (rfc_type->GetRfcTypeAsEnum() != RFCTYPE_STRUCTURE) {
+                return false;
+            }
+
+            RFC_STRUCTURE_HANDLE struct_handle = nullptr;
+            auto rc = RfcGetStructure(container, name.get(), &struct_handle, &error_info);
+            if (rc != RFC_OK) {
+                throw std::runtime_error(StringUtil::Format("Failed to get structure %s: %s: %s", tokens[i],
+                                                            rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+            container = struct_handle;
+
+            if (is_last) {
+                _row_container = container;
+                for (auto &field : rfc_type->GetFieldInfos()) {
+                    _column_layouts.emplace_back(field.GetName(), field.GetRfcType());
+                }
+                _total_rows = 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RfcResultSet::EnsureMaterialized()
+    {
+        if (_materialized) {
+            return;
+        }
+        _result_data = ConvertValuesAndSelectPath(_path);
+        _materialized = true;
+    }
+
+    bool RfcResultSet::IsStreaming() const
+    {
+        return _table_handle != nullptr;
     }
 
     std::vector<LogicalType> RfcResultSet::GetResultTypes() 
@@ -1881,10 +2560,10 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
         return _result_names;   
     }
    
-    std::pair<std::vector<std::string>, std::vector<LogicalType>> RfcResultSet::InferResultSchema(std::string path) 
+    std::pair<std::vector<std::string>, std::vector<LogicalType>> RfcResultSet::InferResultSchema(RfcFunction &function, std::string path) 
     {
         auto tokens = ValueHelper::ParseJsonPointer(path);
-        auto param_infos = _invocation->GetFunction()->GetResultInfos();
+        auto param_infos = function.GetResultInfos();
 
         if (tokens.empty()) {
             return std::make_pair(ExtractResultNames(param_infos), ExtractResultTypes(param_infos));
@@ -1892,7 +2571,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
         // On a first level try to get the function parameter.
         auto token_it = tokens.begin();
-        auto param = _invocation->GetFunction()->GetResultInfo(*token_it);
+        auto param = function.GetResultInfo(*token_it);
         auto field_infos = param.GetRfcType()->GetFieldInfos();
 
         for (token_it++; token_it != tokens.end(); token_it++) {
@@ -2075,6 +2754,13 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
     unsigned int RfcResultSet::FetchNextResult(DataChunk &output, std::vector<std::string> selected_fields) 
     {
+        if (IsStreaming()) {
+            return FetchNextStreamedResult(output, selected_fields);
+        }
+        if (_row_container) {
+            return FetchDirectRow(output, selected_fields);
+        }
+
         auto row_count = 0;
 
         for (std::size_t src_col_idx = 0; src_col_idx < _result_data.size(); src_col_idx++) {
@@ -2085,12 +2771,21 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
                 }
             }
             else {
-                auto &out_vec = output.data[src_col_idx];
-                out_vec.SetValue(0, _result_data[src_col_idx]);
+                unsigned int tgt_col_idx = 0;
+                if (MapColumnsByFieldSelection(selected_fields, src_col_idx, tgt_col_idx)) {
+                    output.SetValue(tgt_col_idx, 0, _result_data[src_col_idx]);
+                }
                 output.SetCardinality(1);
-                row_count++;
+                row_count = 1;
             }
         }
+
+        // A projection may select none of the result columns (count(*)); the
+        // rows still have to be counted.
+        if (row_count == 0 && HasMoreResults()) {
+            row_count = std::min<unsigned int>(STANDARD_VECTOR_SIZE, _total_rows - _current_row_idx);
+            output.SetCardinality(row_count);
+        }
         _current_row_idx += row_count;
         return _current_row_idx;
     }
@@ -2113,24 +2808,78 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
     unsigned int RfcResultSet::FetchNextTabularResult(DataChunk &output, unsigned int src_col_idx, unsigned int tgt_col_idx) 
     {
-        unsigned int row_count = 0;
-        auto result_vec = ListValue::GetChildren(_result_data[src_col_idx]);
-        auto res_start = result_vec.begin() + _current_row_idx;
-        auto res_end = res_start + STANDARD_VECTOR_SIZE > result_vec.end() 
-                            ? result_vec.end() : res_start + STANDARD_VECTOR_SIZE;
-        auto res_chunk = std::vector<Value>(res_start, res_end);
-        for (std::size_t j = 0; j < res_chunk.size(); j++) {
-            auto cell_value = res_chunk[j];
-            output.SetValue(tgt_col_idx, j, cell_value);
-        }
-        output.SetCardinality(res_chunk.size());
-        row_count = res_chunk.size();
+        // By reference: copying the whole child list for every window made a
+        // full scan quadratic in the result size.
+        auto &result_vec = ListValue::GetChildren(_result_data[src_col_idx]);
+        auto res_start = std::min<std::size_t>(_current_row_idx, result_vec.size());
+        auto res_end = std::min<std::size_t>(res_start + STANDARD_VECTOR_SIZE, result_vec.size());
+        for (std::size_t j = res_start; j < res_end; j++) {
+            output.SetValue(tgt_col_idx, j - res_start, result_vec[j]);
+        }
+        unsigned int row_count = res_end - res_start;
+        output.SetCardinality(row_count);
 
         return row_count;
     }
 
+    unsigned int RfcResultSet::FetchNextStreamedResult(DataChunk &output, std::vector<std::string> &selected_fields)
+    {
+        // Resolve the output columns once per window, not once per cell.
+        std::vector<std::pair<const RfcVectorLayout *, idx_t>> columns;
+        for (unsigned int src_col_idx = 0; src_col_idx < _column_layouts.size(); src_col_idx++) {
+            unsigned int tgt_col_idx = 0;
+            if (MapColumnsByFieldSelection(selected_fields, src_col_idx, tgt_col_idx)) {
+                columns.emplace_back(&_column_layouts[src_col_idx], tgt_col_idx);
+            }
+        }
+
+        RFC_ERROR_INFO error_info;
+        auto window_start = _current_row_idx;
+        auto window_end = std::min<unsigned int>(window_start + STANDARD_VECTOR_SIZE, _total_rows);
+        for (auto row_idx = window_start; row_idx < window_end; row_idx++) {
+            auto rc = RfcMoveTo(_table_handle, row_idx, &error_info);
+            if (rc != RFC_OK) {
+                throw std::runtime_error(StringUtil::Format("Failed to move to row %d: %s: %s", row_idx,
+                                                            rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+            auto row_handle = RfcGetCurrentRow(_table_handle, &error_info);
+            if (row_handle == NULL) {
+                throw std::runtime_error(StringUtil::Format("Failed to get row %d: %s: %s", row_idx,
+                                                            rfcrc2std(error_info.code), uc2std(error_info.message)));
+            }
+            for (auto &column : columns) {
+                column.first->Write(row_handle, output.data[column.second], row_idx - window_start);
+            }
+        }
+        output.SetCardinality(window_end - window_start);
+
+        _current_row_idx = window_end;
+        return _current_row_idx;
+    }
+
+    unsigned int RfcResultSet::FetchDirectRow(DataChunk &output, std::vector<std::string> &selected_fields)
+    {
+        if (!HasMoreResults()) {
+            output.SetCardinality(0);
+            return _current_row_idx;
+        }
+        // Unselected columns are never read, so parameters deactivated
+        // before the call are not touched either.
+        for (unsigned int src_col_idx = 0; src_col_idx < _column_layouts.size(); src_col_idx++) {
+            unsigned int tgt_col_idx = 0;
+            if (MapColumnsByFieldSelection(selected_fields, src_col_idx, tgt_col_idx)) {
+                _column_layouts[src_col_idx].Write(_row_container, output.data[tgt_col_idx], 0);
+            }
+        }
+        output.SetCardinality(1);
+
+        _current_row_idx = 1;
+        return _current_row_idx;
+    }
+
     Value RfcResultSet::GetResultValue() 
     {
+        EnsureMaterialized();
         child_list_t<Value> value_list;
         for (idx_t i=0; i < _result_data.size(); i++) {
             value_list.push_back(std::make_pair(_result_names[i], _result_data[i]));
@@ -2141,6 +2890,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
 
     Value RfcResultSet::GetResultValue(unsigned int col_idx) 
     {
+        EnsureMaterialized();
         return _result_data[col_idx];
     }
 
@@ -2170,6 +2920,12 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
     }
 
     bool RfcResultSet::IsTabularResult() {
+        if (IsStreaming()) {
+            return true;
+        }
+        if (_row_container) {
+            return false;
+        }
         auto all_lists = std::all_of(_result_data.begin(), _result_data.end(), [](Value &v) {
             return v.type().id() == LogicalTypeId::LIST;
         });
@@ -2193,7 +2949,7 @@ RfcFieldDesc::RfcFieldDesc(const RFC_FIELD_DESC& sap_desc) : _desc_handle(sap_de
                                                                std::vector<Value> &function_arguments,
                                                                std::string result_path)
     {
-        auto func = std::make_shared<RfcFunction>(connection, function_name);
+        auto func = RfcMetadataCache::Get().GetFunction(connection, function_name);
         auto invocation = function_arguments.size() > 0 
                             ? func->BeginInvocation(function_arguments) 
                             : func->BeginInvocation();
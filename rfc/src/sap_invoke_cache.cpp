@@ -0,0 +1,216 @@
+#include <atomic>
+
+#include "sap_invoke_cache.hpp"
+#include "sap_metadata_cache.hpp"
+#include "duckdb_serialization_helper.hpp"
+#include "erpl_tracing.hpp"
+
+namespace duckdb
+{
+    static std::atomic<unsigned int> g_rfc_invoke_cache_ttl{0};
+    void SetRfcInvokeCacheTtl(unsigned int seconds)
+    {
+        g_rfc_invoke_cache_ttl.store(seconds, std::memory_order_relaxed);
+        if (seconds == 0) {
+            RfcInvokeCache::Get().Clear();
+        }
+    }
+    unsigned int GetRfcInvokeCacheTtl() { return g_rfc_invoke_cache_ttl.load(std::memory_order_relaxed); }
+
+    static std::atomic<idx_t> g_rfc_invoke_cache_max_memory{RfcInvokeCache::DEFAULT_MAX_MEMORY};
+    void SetRfcInvokeCacheMaxMemory(idx_t bytes) { g_rfc_invoke_cache_max_memory.store(bytes, std::memory_order_relaxed); }
+    idx_t GetRfcInvokeCacheMaxMemory() { return g_rfc_invoke_cache_max_memory.load(std::memory_order_relaxed); }
+
+    static std::mutex g_rfc_invoke_cache_functions_lock;
+    static std::string g_rfc_invoke_cache_functions = RfcInvokeCache::DEFAULT_FUNCTIONS;
+    void SetRfcInvokeCacheFunctions(const std::string &patterns)
+    {
+        {
+            std::lock_guard<std::mutex> guard(g_rfc_invoke_cache_functions_lock);
+            g_rfc_invoke_cache_functions = patterns;
+        }
+        // Results of functions no longer allowed must not be served again.
+        RfcInvokeCache::Get().Clear();
+    }
+    std::string GetRfcInvokeCacheFunctions()
+    {
+        std::lock_guard<std::mutex> guard(g_rfc_invoke_cache_functions_lock);
+        return g_rfc_invoke_cache_functions;
+    }
+
+    // RfcInvokeCache -------------------------------------------------------------
+
+    RfcInvokeCache &RfcInvokeCache::Get()
+    {
+        static RfcInvokeCache instance;
+        return instance;
+    }
+
+    static bool MatchesPattern(const char *pattern, const char *name)
+    {
+        if (*pattern == '\0') {
+            return *name == '\0';
+        }
+        if (*pattern == '*') {
+            for (;; name++) {
+                if (MatchesPattern(pattern + 1, name)) {
+                    return true;
+                }
+                if (*name == '\0') {
+                    return false;
+                }
+            }
+        }
+        return *pattern == *name && MatchesPattern(pattern + 1, name + 1);
+    }
+
+    bool RfcInvokeCache::MatchesAllowList(const std::string &patterns, const std::string &function_name)
+    {
+        auto name = StringUtil::Upper(function_name);
+        for (auto &pattern : StringUtil::Split(patterns, ',')) {
+            StringUtil::Trim(pattern);
+            if (!pattern.empty() && MatchesPattern(StringUtil::Upper(pattern).c_str(), name.c_str())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool RfcInvokeCache::IsCacheable(const std::string &function_name)
+    {
+        return GetRfcInvokeCacheTtl() > 0 && MatchesAllowList(GetRfcInvokeCacheFunctions(), function_name);
+    }
+
+    std::string RfcInvokeCache::Key(const RfcConnectionAttributes &attributes, const std::string &function_name,
+                                    const std::string &path, const std::vector<Value> &arguments)
+    {
+        auto system_key = RfcMetadataCache::SystemKey(attributes);
+        if (system_key.empty()) {
+            return "";
+        }
+        auto key = system_key + "/" + attributes.client + "/" + StringUtil::Upper(attributes.user) + "|" +
+                   StringUtil::Upper(function_name) + "|" + path;
+        for (auto &argument : arguments) {
+            key += "|" + ErplSerializer::SerializeJson(argument, true);
+        }
+        return key;
+    }
+
+    RfcInvokeCache::Result RfcInvokeCache::GetOrInvoke(const std::string &key, const std::string &function_name,
+                                                       const std::function<Result()> &invoke)
+    {
+        std::promise<Result> promise;
+        idx_t started_generation;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            Result result;
+            if (TryGet(key, result)) {
+                ERPL_TRACE_DEBUG_DATA("invoke_cache", "Cache hit", key);
+                return result;
+            }
+            auto flight = in_flight.find(key);
+            if (flight != in_flight.end()) {
+                auto future = flight->second;
+                guard.unlock();
+                ERPL_TRACE_DEBUG_DATA("invoke_cache", "Joining in-flight call", key);
+                // Rethrows the leader's error.
+                return future.get();
+            }
+            in_flight.emplace(key, promise.get_future().share());
+            started_generation = generation;
+        }
+
+        Result result;
+        try {
+            result = invoke();
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> guard(lock);
+            if (generation == started_generation) {
+                in_flight.erase(key);
+            }
+            throw;
+        }
+
+        promise.set_value(result);
+        std::lock_guard<std::mutex> guard(lock);
+        if (generation == started_generation) {
+            in_flight.erase(key);
+            Insert(key, function_name, result);
+        }
+        return result;
+    }
+
+    bool RfcInvokeCache::TryGet(const std::string &key, Result &result)
+    {
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return false;
+        }
+        if (Clock::now() >= it->second.expires) {
+            Erase(it);
+            return false;
+        }
+        lru.splice(lru.begin(), lru, it->second.lru_position);
+        result = it->second.result;
+        return true;
+    }
+
+    void RfcInvokeCache::Insert(const std::string &key, const std::string &function_name, Result result)
+    {
+        auto ttl = GetRfcInvokeCacheTtl();
+        auto max_memory = GetRfcInvokeCacheMaxMemory();
+        auto size = result->AllocationSize();
+        // The TTL or the allow-list may have changed while the call was in
+        // flight.
+        if (!IsCacheable(function_name) || size > max_memory) {
+            return;
+        }
+
+        auto existing = entries.find(key);
+        if (existing != entries.end()) {
+            Erase(existing);
+        }
+        while (!lru.empty() && memory_usage + size > max_memory) {
+            Erase(entries.find(lru.back()));
+        }
+
+        lru.push_front(key);
+        Entry entry;
+        entry.result = std::move(result);
+        entry.size = size;
+        entry.expires = Clock::now() + std::chrono::seconds(ttl);
+        entry.lru_position = lru.begin();
+        entries.emplace(key, std::move(entry));
+        memory_usage += size;
+    }
+
+    void RfcInvokeCache::Erase(std::map<std::string, Entry>::iterator it)
+    {
+        memory_usage -= it->second.size;
+        lru.erase(it->second.lru_position);
+        entries.erase(it);
+    }
+
+    void RfcInvokeCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        entries.clear();
+        lru.clear();
+        in_flight.clear();
+        memory_usage = 0;
+        generation++;
+    }
+
+    idx_t RfcInvokeCache::Size()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return entries.size();
+    }
+
+    idx_t RfcInvokeCache::MemoryUsage()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return memory_usage;
+    }
+} // namespace duckdb
@@ -0,0 +1,196 @@
+#include <atomic>
+
+#include "sap_metadata_cache.hpp"
+#include "sap_type_conversion.hpp"
+#include "erpl_tracing.hpp"
+
+namespace duckdb
+{
+    static std::atomic<bool> g_rfc_metadata_cache{true};
+    void SetRfcMetadataCache(bool enabled)
+    {
+        g_rfc_metadata_cache.store(enabled, std::memory_order_relaxed);
+        if (!enabled) {
+            RfcMetadataCache::Get().Clear();
+        }
+    }
+    bool GetRfcMetadataCache() { return g_rfc_metadata_cache.load(std::memory_order_relaxed); }
+
+    // RfcReadTableCapabilities ---------------------------------------------------
+
+    RfcReadTableCapabilities RfcReadTableCapabilities::FromFunction(RfcFunction &function)
+    {
+        RfcReadTableCapabilities caps;
+        caps.function_name = function.GetName();
+
+        for (auto &param : function.GetParameterInfos()) {
+            if (param.GetDirection() == RFC_EXPORT) {
+                continue;
+            }
+            caps.import_params.insert(param.GetName());
+        }
+
+        std::set<std::string> result_names;
+        for (auto &name : function.GetResultNames()) {
+            result_names.insert(name);
+        }
+
+        caps.has_et_data = result_names.find("ET_DATA") != result_names.end();
+        caps.has_et_data_switch = caps.has_et_data &&
+                                  caps.import_params.find("USE_ET_DATA_4_RETURN") != caps.import_params.end();
+        caps.result_path = SelectResultPath(result_names);
+
+        return caps;
+    }
+
+    std::string RfcReadTableCapabilities::SelectResultPath(const std::set<std::string> &result_names)
+    {
+        // /SAPDS RFC_READ_TABLE2 returns its rows in width-bucketed tables;
+        // the widest one present carries every row.
+        static const std::vector<std::string> table_candidates = {
+            "TBLOUT30000",
+            "TBLOUT8192",
+            "TBLOUT2048",
+            "TBLOUT512",
+            "TBLOUT128"
+        };
+
+        for (auto &candidate : table_candidates) {
+            if (result_names.find(candidate) != result_names.end()) {
+                return "/" + candidate;
+            }
+        }
+        if (result_names.find("DATA") != result_names.end()) {
+            return "/DATA";
+        }
+        return "";
+    }
+
+    // RfcMetadataCache -----------------------------------------------------------
+
+    RfcMetadataCache &RfcMetadataCache::Get()
+    {
+        static RfcMetadataCache instance;
+        return instance;
+    }
+
+    std::string RfcMetadataCache::SystemKey(const RfcConnectionAttributes &attributes)
+    {
+        auto system = attributes.sys_id.empty() ? attributes.partner_host : attributes.sys_id;
+        if (system.empty()) {
+            return "";
+        }
+        return system + "/" + attributes.partner_release + "/" + attributes.language;
+    }
+
+    std::string RfcMetadataCache::TrySystemKey(RfcConnection &connection)
+    {
+        // An empty key disables caching for this connection; attribute
+        // retrieval is a local SDK call, so a failure here says nothing about
+        // the function lookup that follows.
+        try {
+            return SystemKey(connection.ConnectionAttributes());
+        } catch (std::exception &) {
+            return "";
+        }
+    }
+
+    std::shared_ptr<RfcFunction> RfcMetadataCache::GetFunction(std::shared_ptr<RfcConnection> &connection,
+                                                               const std::string &function_name)
+    {
+        if (!GetRfcMetadataCache()) {
+            return std::make_shared<RfcFunction>(connection, function_name);
+        }
+
+        auto system_key = TrySystemKey(*connection);
+        if (system_key.empty()) {
+            return std::make_shared<RfcFunction>(connection, function_name);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            auto &descriptors = systems[system_key].descriptors;
+            auto it = descriptors.find(function_name);
+            if (it != descriptors.end()) {
+                if (it->second.error.empty()) {
+                    return std::make_shared<RfcFunction>(connection, function_name, it->second.handle);
+                }
+                if (!NegativeEntryExpired(it->second.cached_at, std::chrono::steady_clock::now())) {
+                    throw std::runtime_error(it->second.error);
+                }
+                descriptors.erase(it);
+            }
+        }
+
+        // The lookup itself runs unlocked: it is a network round-trip, and two
+        // threads racing on the same name just get the same SDK-owned handle.
+        RFC_ERROR_INFO error_info;
+        auto desc_handle = RfcFunction::LookupDescription(connection->handle, function_name, error_info);
+        if (desc_handle == NULL) {
+            auto message = StringUtil::Format("Error getting function description: %s: %s",
+                                              rfcrc2std(error_info.code), uc2std(error_info.message));
+            // Only a definite "no such function" is remembered; anything
+            // else may be transient and must be retried by the next caller.
+            if (error_info.code == RFC_NOT_FOUND || error_info.code == RFC_ABAP_EXCEPTION) {
+                std::lock_guard<std::mutex> guard(lock);
+                systems[system_key].descriptors[function_name] =
+                    DescriptorEntry { nullptr, message, std::chrono::steady_clock::now() };
+            }
+            throw std::runtime_error(message);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            systems[system_key].descriptors[function_name] =
+                DescriptorEntry { desc_handle, "", std::chrono::steady_clock::now() };
+        }
+        ERPL_TRACE_DEBUG_DATA("metadata_cache", "Cached function descriptor", function_name);
+
+        return std::make_shared<RfcFunction>(connection, function_name, desc_handle);
+    }
+
+    RfcReadTableCapabilities RfcMetadataCache::GetReadTableCapabilities(std::shared_ptr<RfcConnection> &connection,
+                                                                         const std::string &function_name)
+    {
+        auto system_key = GetRfcMetadataCache() ? TrySystemKey(*connection) : std::string();
+        if (!system_key.empty()) {
+            std::lock_guard<std::mutex> guard(lock);
+            auto &read_table = systems[system_key].read_table;
+            auto it = read_table.find(function_name);
+            if (it != read_table.end()) {
+                return it->second;
+            }
+        }
+
+        auto func = GetFunction(connection, function_name);
+        auto caps = RfcReadTableCapabilities::FromFunction(*func);
+
+        if (!system_key.empty()) {
+            std::lock_guard<std::mutex> guard(lock);
+            systems[system_key].read_table[function_name] = caps;
+        }
+        return caps;
+    }
+
+    bool RfcMetadataCache::NegativeEntryExpired(std::chrono::steady_clock::time_point cached_at,
+                                                std::chrono::steady_clock::time_point now)
+    {
+        return now - cached_at >= NEGATIVE_TTL;
+    }
+
+    void RfcMetadataCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        systems.clear();
+    }
+
+    idx_t RfcMetadataCache::Size()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        idx_t n = 0;
+        for (auto &system : systems) {
+            n += system.second.descriptors.size();
+        }
+        return n;
+    }
+} // namespace duckdb
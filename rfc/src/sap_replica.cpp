@@ -0,0 +1,385 @@
+#include "sap_replica.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/pending_query_result.hpp"
+
+#include "erpl_tracing.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace duckdb {
+
+static std::mutex g_replicas_lock;
+static vector<std::weak_ptr<SapReplica>> g_replicas;
+
+SapReplica::SapReplica(string catalog_name_p, string path_p, string secret_name_p, vector<string> table_names,
+                       int64_t refresh_micros_p)
+    : catalog_name(std::move(catalog_name_p)), replica_name(catalog_name + "_replica"), path(std::move(path_p)),
+      secret_name(std::move(secret_name_p)), refresh_micros(refresh_micros_p) {
+	for (auto &name : table_names) {
+		SapReplicaTableStatus status;
+		status.table_name = name;
+		status.refreshed_at = timestamp_t(0);
+		// Due at once; Open() pushes this out for copies that are still fresh.
+		status.next_refresh_at = timestamp_t(0);
+		tables.push_back(std::move(status));
+	}
+}
+
+std::shared_ptr<SapReplica> SapReplica::Create(string catalog_name, string path, string secret_name,
+                                               vector<string> tables, int64_t refresh_micros) {
+	auto replica = std::shared_ptr<SapReplica>(new SapReplica(std::move(catalog_name), std::move(path),
+	                                                          std::move(secret_name), std::move(tables),
+	                                                          refresh_micros));
+	std::lock_guard<std::mutex> guard(g_replicas_lock);
+	g_replicas.push_back(replica);
+	return replica;
+}
+
+vector<std::shared_ptr<SapReplica>> SapReplica::All() {
+	std::lock_guard<std::mutex> guard(g_replicas_lock);
+	vector<std::shared_ptr<SapReplica>> result;
+	vector<std::weak_ptr<SapReplica>> alive;
+	for (auto &weak : g_replicas) {
+		auto replica = weak.lock();
+		if (replica) {
+			result.push_back(replica);
+			alive.push_back(weak);
+		}
+	}
+	g_replicas = std::move(alive);
+	return result;
+}
+
+optional_ptr<TableCatalogEntry> SapReplica::TryGetTable(ClientContext &context, const string &table,
+                                                        const ColumnList &columns) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto it = std::find_if(tables.begin(), tables.end(), [&](const SapReplicaTableStatus &status) {
+			return StringUtil::CIEquals(status.table_name, table);
+		});
+		if (it == tables.end() || !it->loaded) {
+			return nullptr;
+		}
+	}
+
+	try {
+		auto entry = Catalog::GetEntry<TableCatalogEntry>(context, replica_name, DEFAULT_SCHEMA, table,
+		                                                  OnEntryNotFound::RETURN_NULL);
+		if (!entry) {
+			return nullptr;
+		}
+		// A copy taken before the DDIC definition changed no longer matches
+		// the catalog entry's columns; SAP is read until the next refresh.
+		auto &local_columns = entry->GetColumns();
+		if (local_columns.LogicalColumnCount() != columns.LogicalColumnCount()) {
+			return nullptr;
+		}
+		for (idx_t i = 0; i < columns.LogicalColumnCount(); i++) {
+			auto &local = local_columns.GetColumn(LogicalIndex(i));
+			auto &remote = columns.GetColumn(LogicalIndex(i));
+			if (!StringUtil::CIEquals(local.Name(), remote.Name()) || local.Type() != remote.Type()) {
+				return nullptr;
+			}
+		}
+		return entry;
+	} catch (std::exception &ex) {
+		// E.g. the replica database was detached by hand.
+		ERPL_TRACE_DEBUG_DATA("sap_replica", StringUtil::Format("Replica of '%s' not usable", table),
+		                      string(ex.what()));
+		return nullptr;
+	}
+}
+
+vector<SapReplicaTableStatus> SapReplica::Status() {
+	std::lock_guard<std::mutex> guard(lock);
+	return tables;
+}
+
+static unique_ptr<MaterializedQueryResult> RunReplicaQuery(Connection &conn, const string &sql) {
+	auto result = conn.Query(sql);
+	if (result->HasError()) {
+		throw std::runtime_error(result->GetError());
+	}
+	return result;
+}
+
+// Runs `sql` task by task, and interrupts it once the refresh's connection
+// holds the last reference to the database, i.e. it was closed meanwhile.
+static unique_ptr<MaterializedQueryResult> RunReplicaQuery(Connection &conn, const string &sql,
+                                                           const weak_ptr<DatabaseInstance> &weak_db) {
+	auto pending = conn.PendingQuery(sql);
+	if (pending->HasError()) {
+		throw std::runtime_error(pending->GetError());
+	}
+	auto interrupted = false;
+	PendingExecutionResult state;
+	do {
+		if (!interrupted && weak_db.use_count() <= 1) {
+			conn.Interrupt();
+			interrupted = true;
+		}
+		state = pending->ExecuteTask();
+		if (state == PendingExecutionResult::BLOCKED || state == PendingExecutionResult::NO_TASKS_AVAILABLE) {
+			pending->WaitForTask();
+		}
+	} while (!PendingQueryResult::IsResultReady(state));
+	if (state == PendingExecutionResult::EXECUTION_ERROR) {
+		throw std::runtime_error(pending->GetError());
+	}
+	auto result = pending->Execute();
+	if (result->HasError()) {
+		throw std::runtime_error(result->GetError());
+	}
+	return unique_ptr_cast<QueryResult, MaterializedQueryResult>(std::move(result));
+}
+
+void SapReplica::Open(DatabaseInstance &db) {
+	Connection conn(db);
+	RunReplicaQuery(conn, StringUtil::Format("ATTACH IF NOT EXISTS %s AS %s", SQLString(path), SQLIdentifier(replica_name)));
+	RunReplicaQuery(conn, StringUtil::Format("CREATE TABLE IF NOT EXISTS %s.main.%s "
+	                                         "(table_name VARCHAR PRIMARY KEY, refreshed_at TIMESTAMP, row_count BIGINT)",
+	                                         SQLIdentifier(replica_name), SQLIdentifier(STATE_TABLE)));
+	auto state = RunReplicaQuery(conn, StringUtil::Format("SELECT table_name, refreshed_at, row_count FROM %s.main.%s",
+	                                                      SQLIdentifier(replica_name), SQLIdentifier(STATE_TABLE)));
+
+	std::lock_guard<std::mutex> guard(lock);
+	for (idx_t row = 0; row < state->RowCount(); row++) {
+		auto name = state->GetValue(0, row).ToString();
+		for (auto &table : tables) {
+			if (!StringUtil::CIEquals(table.table_name, name)) {
+				continue;
+			}
+			table.loaded = true;
+			table.refreshed_at = state->GetValue(1, row).GetValue<timestamp_t>();
+			table.row_count = state->GetValue(2, row).GetValue<int64_t>();
+			table.next_refresh_at = timestamp_t(table.refreshed_at.value + refresh_micros);
+		}
+	}
+	opened = true;
+	ERPL_TRACE_INFO_DATA("sap_replica", "Opened replica " + replica_name,
+	                     StringUtil::Format("%s, %llu loaded tables", path, (idx_t)state->RowCount()));
+}
+
+void SapReplica::Refresh(const weak_ptr<DatabaseInstance> &weak_db, const string &table) {
+	auto started = std::chrono::steady_clock::now();
+	unique_ptr<Connection> conn;
+	idx_t row_count = 0;
+	auto refreshed_at = Timestamp::GetCurrentTimestamp();
+	string error;
+
+	try {
+		{
+			auto db = weak_db.lock();
+			if (!db) {
+				return;
+			}
+			conn = make_uniq<Connection>(*db);
+		}
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (cancelled) {
+				return;
+			}
+			active = conn.get();
+			for (auto &status : tables) {
+				status.refreshing = StringUtil::CIEquals(status.table_name, table);
+			}
+		}
+
+		// Through the regular scan path, so the copy has exactly the
+		// columns SapTableEntry declares for the table.
+		auto source = secret_name.empty()
+		                  ? StringUtil::Format("sap_read_table(%s)", SQLString(table))
+		                  : StringUtil::Format("sap_read_table(%s, secret=%s)", SQLString(table), SQLString(secret_name));
+		RunReplicaQuery(*conn, "BEGIN TRANSACTION", weak_db);
+		RunReplicaQuery(*conn,
+		                StringUtil::Format("CREATE OR REPLACE TABLE %s.main.%s AS SELECT * FROM %s",
+		                                   SQLIdentifier(replica_name), SQLIdentifier(table), source),
+		                weak_db);
+		auto count = RunReplicaQuery(*conn,
+		                             StringUtil::Format("SELECT count(*) FROM %s.main.%s",
+		                                                SQLIdentifier(replica_name), SQLIdentifier(table)),
+		                             weak_db);
+		row_count = count->GetValue(0, 0).GetValue<int64_t>();
+		RunReplicaQuery(*conn,
+		                StringUtil::Format("INSERT OR REPLACE INTO %s.main.%s VALUES (%s, %s::TIMESTAMP, %llu)",
+		                                   SQLIdentifier(replica_name), SQLIdentifier(STATE_TABLE), SQLString(table),
+		                                   SQLString(Timestamp::ToString(refreshed_at)), row_count),
+		                weak_db);
+		RunReplicaQuery(*conn, "COMMIT", weak_db);
+	} catch (std::exception &ex) {
+		error = ex.what();
+	}
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		active = nullptr;
+		for (auto &status : tables) {
+			if (!StringUtil::CIEquals(status.table_name, table)) {
+				continue;
+			}
+			status.refreshing = false;
+			status.refresh_ms = elapsed.count();
+			status.last_error = error;
+			status.attempts++;
+			if (error.empty()) {
+				status.loaded = true;
+				status.refreshed_at = refreshed_at;
+				status.row_count = row_count;
+				status.next_refresh_at = timestamp_t(refreshed_at.value + refresh_micros);
+			} else {
+				status.next_refresh_at = timestamp_t(Timestamp::GetCurrentTimestamp().value +
+				                                     MinValue<int64_t>(refresh_micros, RETRY_MICROS));
+			}
+			if (status.rerun) {
+				status.rerun = false;
+				status.next_refresh_at = timestamp_t(0);
+			}
+		}
+	}
+	cv.notify_all();
+	// Rolls back whatever a failed refresh left open.
+	conn.reset();
+
+	if (error.empty()) {
+		ERPL_TRACE_INFO_DATA("sap_replica", StringUtil::Format("Refreshed '%s'", table),
+		                     StringUtil::Format("%llu rows in %lld ms", row_count, (int64_t)elapsed.count()));
+	} else {
+		ERPL_TRACE_WARN_DATA("sap_replica", StringUtil::Format("Refresh of '%s' failed", table), error);
+	}
+}
+
+void SapReplica::Run(weak_ptr<DatabaseInstance> weak_db) {
+	std::unique_lock<std::mutex> guard(lock);
+	while (!cancelled) {
+		if (!opened) {
+			guard.unlock();
+			try {
+				auto db = weak_db.lock();
+				if (!db) {
+					return;
+				}
+				Open(*db);
+			} catch (std::exception &ex) {
+				ERPL_TRACE_WARN_DATA("sap_replica", "Could not open replica " + replica_name, string(ex.what()));
+				{
+					std::lock_guard<std::mutex> error_guard(lock);
+					for (auto &status : tables) {
+						status.last_error = ex.what();
+						status.attempts++;
+					}
+				}
+				cv.notify_all();
+			}
+			guard.lock();
+			if (!opened) {
+				refresh_requested = false;
+				cv.wait_for(guard, std::chrono::microseconds(RETRY_MICROS),
+				            [&]() { return cancelled || refresh_requested; });
+			}
+			continue;
+		}
+		refresh_requested = false;
+
+		auto now = Timestamp::GetCurrentTimestamp();
+		string due;
+		auto wait_micros = NumericLimits<int64_t>::Maximum();
+		for (auto &status : tables) {
+			auto remaining = status.next_refresh_at.value - now.value;
+			if (remaining <= 0) {
+				due = status.table_name;
+				break;
+			}
+			wait_micros = MinValue<int64_t>(wait_micros, remaining);
+		}
+
+		if (due.empty()) {
+			cv.wait_for(guard, std::chrono::microseconds(wait_micros),
+			            [&]() { return cancelled || refresh_requested; });
+			continue;
+		}
+
+		guard.unlock();
+		if (weak_db.expired()) {
+			return;
+		}
+		Refresh(weak_db, due);
+		guard.lock();
+	}
+}
+
+void SapReplica::RefreshNow(ClientContext &context) {
+	std::unique_lock<std::mutex> guard(lock);
+	vector<idx_t> targets;
+	for (auto &status : tables) {
+		// A refresh already running started before this request.
+		targets.push_back(status.attempts + (status.refreshing ? 2 : 1));
+		if (status.refreshing) {
+			status.rerun = true;
+		} else {
+			status.next_refresh_at = timestamp_t(0);
+		}
+	}
+	refresh_requested = true;
+	cv.notify_all();
+
+	while (true) {
+		if (cancelled) {
+			throw InvalidInputException("The replica of '%s' was detached", catalog_name);
+		}
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		auto done = true;
+		for (idx_t i = 0; i < tables.size(); i++) {
+			done = done && tables[i].attempts >= targets[i];
+		}
+		if (done) {
+			return;
+		}
+		cv.wait_for(guard, std::chrono::milliseconds(100));
+	}
+}
+
+void SapReplica::Stop() {
+	std::lock_guard<std::mutex> guard(lock);
+	cancelled = true;
+	if (active) {
+		active->Interrupt();
+	}
+	cv.notify_all();
+}
+
+bool SapReplica::Stopped() {
+	std::lock_guard<std::mutex> guard(lock);
+	return cancelled;
+}
+
+// SapReplicaRefresher ----------------------------------------------------------
+
+SapReplicaRefresher::SapReplicaRefresher(DatabaseInstance &db, std::shared_ptr<SapReplica> replica_p)
+    : replica(std::move(replica_p)) {
+	// The thread keeps its own reference: it may outlive this object when
+	// the database is closed from inside a refresh.
+	weak_ptr<DatabaseInstance> weak_db = db.shared_from_this();
+	auto thread_replica = replica;
+	thread = std::thread([thread_replica, weak_db]() { thread_replica->Run(weak_db); });
+}
+
+SapReplicaRefresher::~SapReplicaRefresher() {
+	replica->Stop();
+	if (!thread.joinable()) {
+		return;
+	}
+	if (thread.get_id() == std::this_thread::get_id()) {
+		thread.detach();
+	} else {
+		thread.join();
+	}
+}
+
+} // namespace duckdb
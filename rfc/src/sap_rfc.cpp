@@ -23,8 +23,10 @@
 
 #include "sap_rfc.hpp"
 #include "sap_function.hpp"
+#include "sap_metadata_cache.hpp"
 #include "duckdb_argument_helper.hpp"
 #include "erpl_tracing.hpp"
+#include "sap_trace_spans.hpp"
 
 namespace duckdb
 {
@@ -183,10 +185,14 @@ namespace duckdb
 
     std::shared_ptr<RfcConnection> RfcReadTableBindData::OpenNewConnection()
     {
-        if (!secret_name.empty()) {
-            return RfcAuthParams::FromContext(client_context, secret_name).Connect();
+        auto connection = !secret_name.empty() ? RfcAuthParams::FromContext(client_context, secret_name).Connect()
+                                               : connection_factory(client_context);
+        if (connection && connection->reused_from_pool) {
+            stats.connections_reused++;
+        } else {
+            stats.connections_opened++;
         }
-        return connection_factory(client_context);
+        return connection;
     }
 
     std::string RfcReadTableBindData::GetReadTableFunctionName()
@@ -241,30 +247,17 @@ namespace duckdb
         }
     }
 
+    // The capability probes below all read from one cached record per
+    // (system, function) — see RfcMetadataCache — so after the first bind
+    // against a system they cost no RFC round-trip at all.
     bool RfcReadTableBindData::ReadTableFunctionSupportsEtData(std::shared_ptr<RfcConnection> connection, const std::string &function_name)
     {
-        auto func = std::make_shared<RfcFunction>(connection, function_name);
-        auto result_infos = func->GetResultInfos();
-        auto it = std::find_if(result_infos.begin(), result_infos.end(), [](auto &param) {
-            return param.GetName() == "ET_DATA";
-        });
-        return it != result_infos.end();
+        return RfcMetadataCache::Get().GetReadTableCapabilities(connection, function_name).has_et_data;
     }
 
     bool RfcReadTableBindData::ReadTableSupportsEtDataSwitch(std::shared_ptr<RfcConnection> connection, const std::string &function_name)
     {
-        auto func = std::make_shared<RfcFunction>(connection, function_name);
-        bool has_param = false;
-        for (auto &param : func->GetParameterInfos()) {
-            if (param.GetName() == "USE_ET_DATA_4_RETURN") {
-                has_param = true;
-                break;
-            }
-        }
-        if (!has_param) {
-            return false;
-        }
-        return ReadTableFunctionSupportsEtData(connection, function_name);
+        return RfcMetadataCache::Get().GetReadTableCapabilities(connection, function_name).has_et_data_switch;
     }
 
     void RfcReadTableBindData::ResolveReadTableFunctionForStringTypes(std::shared_ptr<RfcConnection> connection)
@@ -338,33 +331,7 @@ namespace duckdb
             return;
         }
 
-        auto func = std::make_shared<RfcFunction>(connection, read_table_function);
-        auto result_infos = func->GetResultInfos();
-        static const std::vector<std::string> table_candidates = {
-            "TBLOUT30000",
-            "TBLOUT8192",
-            "TBLOUT2048",
-            "TBLOUT512",
-            "TBLOUT128"
-        };
-
-        for (auto &candidate : table_candidates) {
-            auto it = std::find_if(result_infos.begin(), result_infos.end(), [&](auto &param) {
-                return param.GetName() == candidate;
-            });
-            if (it != result_infos.end()) {
-                read_table_result_path = "/" + candidate;
-                return;
-            }
-        }
-
-        // fallback to DATA if present
-        auto it = std::find_if(result_infos.begin(), result_infos.end(), [&](auto &param) {
-            return param.GetName() == "DATA";
-        });
-        if (it != result_infos.end()) {
-            read_table_result_path = "/DATA";
-        }
+        read_table_result_path = RfcMetadataCache::Get().GetReadTableCapabilities(connection, read_table_function).result_path;
     }
 
     void RfcReadTableBindData::ResolveReadTableImportParams(std::shared_ptr<RfcConnection> connection)
@@ -373,14 +340,7 @@ namespace duckdb
             return;
         }
 
-        auto func = std::make_shared<RfcFunction>(connection, read_table_function);
-        for (auto &param : func->GetParameterInfos()) {
-            auto direction = param.GetDirection();
-            if (direction == RFC_EXPORT) {
-                continue;
-            }
-            read_table_import_params.insert(param.GetName());
-        }
+        read_table_import_params = RfcMetadataCache::Get().GetReadTableCapabilities(connection, read_table_function).import_params;
     }
 
     bool RfcReadTableBindData::ReadTableHasParam(const std::string &param_name)
@@ -425,6 +385,11 @@ namespace duckdb
     }
 
     void RfcReadTableBindData::InitAndVerifyFields(std::vector<std::string> req_fields)
+    {
+        InitAndVerifyFields(std::move(req_fields), {});
+    }
+
+    void RfcReadTableBindData::InitAndVerifyFields(std::vector<std::string> req_fields, std::vector<Value> available_fields)
     {
         if (read_table_function.empty()) {
             read_table_function = "RFC_READ_TABLE";
@@ -432,7 +397,9 @@ namespace duckdb
         ValidateReadTableFunctionName();
 
         auto connection = OpenNewConnection();
-        auto available_fields = GetTableFieldMetas(connection, table_name);
+        if (available_fields.empty()) {
+            available_fields = GetTableFieldMetas(connection, table_name);
+        }
         auto req_field_metas = std::map<std::string, Value>();
 
         if (req_fields.empty()) {
@@ -687,7 +654,7 @@ namespace duckdb
     std::vector<Value> RfcReadTableBindData::GetTableFieldMetas(std::shared_ptr<RfcConnection> connection, std::string table_name)
     {
         auto args = ArgBuilder().Add("TABNAME", Value(table_name));
-        auto func = std::make_shared<RfcFunction>(connection, "DDIF_FIELDINFO_GET");
+        auto func = RfcMetadataCache::Get().GetFunction(connection, "DDIF_FIELDINFO_GET");
         auto func_args = args.BuildArgList();
         auto invocation = func->BeginInvocation(func_args);
         auto result_set = invocation->Invoke();
@@ -707,6 +674,17 @@ namespace duckdb
         return field_metas;
     }
 
+    void RfcReadTableBindData::GetSchemaForFieldMetas(std::vector<Value> &field_metas, std::vector<std::string> &names,
+                                                      std::vector<LogicalType> &types)
+    {
+        names.clear();
+        types.clear();
+        for (auto &fm : field_metas) {
+            names.push_back(ValueHelper(fm)["FIELDNAME"].ToString());
+            types.push_back(GetRfcTypeForFieldMeta(fm).CreateDuckDbType());
+        }
+    }
+
     RfcType RfcReadTableBindData::GetRfcTypeForFieldMeta(Value &DFIES_entry) 
     {
         auto entry_helper = ValueHelper(DFIES_entry);
@@ -731,6 +709,15 @@ namespace duckdb
     void RfcReadTableBindData::Step(ClientContext &context, DataChunk &output)
     {
         auto &scheduler = TaskScheduler::GetScheduler(context);
+        if (IsCancelled()) {
+            throw InterruptException();
+        }
+        StartWatchdog();
+        RfcSpanContext span_context(spans.get(), span_scan_id, std::string());
+        RfcTraceSpan step_span("Step", "scan");
+        if (step_span.Recording()) {
+            step_span.SetDetail(row_offset > 0 ? StringUtil::Format("%s at row %u", table_name, row_offset) : table_name);
+        }
 
         // Snapshot the active state machines so we can throttle scheduling
         // without iterating column_state_machines twice.
@@ -775,6 +762,8 @@ namespace duckdb
                 auto task = sm.CreateTaskForNextStep(executor, output.data[sm.GetProjectedColumnIndex()]);
                 executor.ScheduleTask(std::move(task));
             }
+            // The barrier: a round ends with its slowest column.
+            RfcTraceSpan wait_span("WaitForColumns", "scan");
             executor.WorkOnTasks();
         }
 
@@ -836,6 +825,35 @@ namespace duckdb
                                     StringUtil::Join(column_types, column_types.size(), ", ", [](auto &o) { return o.GetName(); }));
     }
 
+    InsertionOrderPreservingMap<string> RfcReadTableBindData::ExplainParams(bool analyze)
+    {
+        InsertionOrderPreservingMap<string> result;
+        result["Table"] = table_name;
+        result["Function"] = read_table_function;
+        if (!options.empty()) {
+            // The parts were split at white space, which they keep.
+            result["Options"] = StringUtil::Join(options, "");
+        }
+        if (row_offset > 0) {
+            result["Row Offset"] = std::to_string(row_offset);
+        }
+        if (limit > 0) {
+            result["Max Rows"] = std::to_string(limit);
+        }
+        result["Threads"] = max_threads > 0 ? std::to_string(max_threads) : "all columns";
+        if (!analyze) {
+            result["Batch Budget"] = StringUtil::Format("%u rows x columns", GetRfcReadTableBatchBudget());
+            return result;
+        }
+        // One RFC call per column and batch, so the column count is the
+        // number of calls per round trip.
+        result["Column Tasks"] = std::to_string(NActiveStateMachines());
+        result["Batch Size"] = StringUtil::Format("%u doubling to %u rows", (unsigned int)STANDARD_VECTOR_SIZE,
+                                                  effective_max_batch_size);
+        stats.AddTo(result);
+        return result;
+    }
+
     double RfcReadTableBindData::GetProgress()
     {
         auto batch_sum = std::accumulate(column_state_machines.begin(), column_state_machines.end(), 0, 
@@ -844,6 +862,112 @@ namespace duckdb
         return progress * 1.0; 
     }
 
+    RfcReadTableBindData::~RfcReadTableBindData()
+    {
+        StopWatchdog();
+    }
+
+    void RfcReadTableBindData::Cancel()
+    {
+        std::lock_guard<std::mutex> guard(cancel_lock);
+        if (cancel_requested.exchange(true)) {
+            return;
+        }
+        ERPL_TRACE_DEBUG_DATA("sap_rfc", StringUtil::Format("Cancelling sap_read_table('%s')", table_name),
+                              StringUtil::Format("%d calls in flight", (int)in_flight_calls.size()));
+        for (auto &connection : in_flight_calls) {
+            connection->Cancel();
+        }
+        cancel_cv.notify_all();
+    }
+
+    bool RfcReadTableBindData::IsCancelled()
+    {
+        return cancel_requested.load() || client_context.interrupted.load();
+    }
+
+    bool RfcReadTableBindData::WaitUnlessCancelled(std::chrono::milliseconds delay)
+    {
+        // An interrupt does not notify cancel_cv by itself; the watchdog
+        // converts it into Cancel() within CANCEL_POLL_INTERVAL.
+        std::unique_lock<std::mutex> guard(cancel_lock);
+        return !cancel_cv.wait_for(guard, delay, [this]() { return IsCancelled(); });
+    }
+
+    void RfcReadTableBindData::BeginCall(std::shared_ptr<RfcConnection> connection)
+    {
+        std::lock_guard<std::mutex> guard(cancel_lock);
+        if (IsCancelled()) {
+            throw InterruptException();
+        }
+        in_flight_calls.push_back(std::move(connection));
+    }
+
+    void RfcReadTableBindData::EndCall(const std::shared_ptr<RfcConnection> &connection)
+    {
+        std::lock_guard<std::mutex> guard(cancel_lock);
+        auto it = std::find(in_flight_calls.begin(), in_flight_calls.end(), connection);
+        if (it != in_flight_calls.end()) {
+            in_flight_calls.erase(it);
+        }
+    }
+
+    void RfcReadTableBindData::BeginScan()
+    {
+        stats.Reset();
+        spans = RfcSpanBuffer::ForQuery(client_context);
+        span_scan_id = spans ? spans->NextScanId() : 0;
+        // Bind data outlives one execution (prepared statements re-run the
+        // same plan), so a cancellation must not stick to the next run.
+        StopWatchdog();
+        std::lock_guard<std::mutex> guard(cancel_lock);
+        cancel_requested = false;
+        watchdog_stop = false;
+    }
+
+    void RfcReadTableBindData::FinishScan()
+    {
+        StopWatchdog();
+        // After a cancellation a cached connection may have had RfcCancel
+        // race with the end of its call, leaving it closed on the SDK side;
+        // only connections of an uncancelled scan are known to be reusable.
+        auto reusable = !IsCancelled();
+        for (auto &sm : column_state_machines) {
+            sm.ReleaseResources(reusable);
+        }
+    }
+
+    void RfcReadTableBindData::StartWatchdog()
+    {
+        std::lock_guard<std::mutex> guard(cancel_lock);
+        if (watchdog.joinable() || watchdog_stop) {
+            return;
+        }
+        watchdog = std::thread([this]() {
+            std::unique_lock<std::mutex> lock(cancel_lock);
+            while (!watchdog_stop) {
+                cancel_cv.wait_for(lock, CANCEL_POLL_INTERVAL);
+                if (!watchdog_stop && !cancel_requested.load() && client_context.interrupted.load()) {
+                    lock.unlock();
+                    Cancel();
+                    lock.lock();
+                }
+            }
+        });
+    }
+
+    void RfcReadTableBindData::StopWatchdog()
+    {
+        {
+            std::lock_guard<std::mutex> guard(cancel_lock);
+            watchdog_stop = true;
+        }
+        cancel_cv.notify_all();
+        if (watchdog.joinable()) {
+            watchdog.join();
+        }
+    }
+
     // --------------------------------------------------------------------------------------------
 
     static bool IsRetryableRfcError(const std::string &error_message)
@@ -1063,13 +1187,13 @@ namespace duckdb
         const bool persistent = GetRfcPersistentConnections() &&
                                 persistent_decision == PersistentDecision::APPROVED;
         if (!persistent) {
-            return std::make_shared<RfcFunction>(connection, function_name);
+            return RfcMetadataCache::Get().GetFunction(connection, function_name);
         }
         if (cached_function && cached_function_name == function_name &&
             cached_connection && cached_connection->handle != NULL) {
             return cached_function;
         }
-        cached_function = std::make_shared<RfcFunction>(connection, function_name);
+        cached_function = RfcMetadataCache::Get().GetFunction(connection, function_name);
         cached_function_name = function_name;
         return cached_function;
     }
@@ -1077,6 +1201,8 @@ namespace duckdb
     void RfcReadColumnStateMachine::InvalidateCachedConnection()
     {
         // Caller already holds thread_lock.
+        prepared_invocation.reset();
+        prepared_invocation_key.clear();
         cached_function.reset();
         cached_function_name.clear();
         if (cached_connection) {
@@ -1090,6 +1216,35 @@ namespace duckdb
         cached_connection_thread.reset();
     }
 
+    void RfcReadColumnStateMachine::ReleaseCachedConnection()
+    {
+        // Caller already holds thread_lock.  Drop everything that references
+        // the connection first, so the pool holds the only reference.
+        prepared_invocation.reset();
+        prepared_invocation_key.clear();
+        current_invocation.reset();
+        current_table_handle = nullptr;
+        cached_function.reset();
+        cached_function_name.clear();
+        if (cached_connection && cached_connection->handle != NULL) {
+            RfcConnectionPool::Get().Release(std::move(cached_connection));
+        }
+        cached_connection.reset();
+        cached_connection_thread.reset();
+    }
+
+    void RfcReadColumnStateMachine::ReleaseResources(bool reusable)
+    {
+        std::lock_guard<mutex> t(thread_lock);
+        if (reusable) {
+            ReleaseCachedConnection();
+            return;
+        }
+        InvalidateCachedConnection();
+        current_invocation.reset();
+        current_table_handle = nullptr;
+    }
+
     std::string RfcReadColumnStateMachine::ToString()
     {
         return StringUtil::Format("ReadColumn(\n\tcolumn_idx=%d, \n\tcurrent_state=%s, \n\tdesired_batch_size=%d, \n\tpending_records=%d, \n\tcardinality=%d, \n\tbatch_count=%d, \n\tduck_count=%d\n)\n", 
@@ -1115,6 +1270,15 @@ namespace duckdb
     void RfcReadColumnTask::ExecuteTask() 
     {
         std::lock_guard<mutex> t(owning_state_machine->thread_lock);
+        auto bind_data = owning_state_machine->bind_data;
+        std::string span_column;
+        if (bind_data->spans) {
+            auto names = bind_data->GetRfcColumnNames();
+            auto column_idx = owning_state_machine->column_idx;
+            span_column = owning_state_machine->row_id_column_id || column_idx >= names.size() ? "rowid" : names[column_idx];
+        }
+        RfcSpanContext span_context(bind_data->spans.get(), bind_data->span_scan_id, span_column);
+        RfcTraceSpan task_span("ColumnTask", "scan");
 
         auto &current_state = owning_state_machine->current_state;
         auto &desired_batch_size = owning_state_machine->desired_batch_size;
@@ -1177,10 +1341,16 @@ namespace duckdb
                                         : ReadTableStates::FINISHED;
 
                     if (current_state == ReadTableStates::FINISHED) {
-                        // No more batches will run on this state machine — release
-                        // the cached RFC connection so we don't hold a SAP work
-                        // process reservation until query teardown.
-                        owning_state_machine->InvalidateCachedConnection();
+                        // No more batches will run on this state machine — hand
+                        // the cached RFC connection back to the pool so we don't
+                        // hold a SAP work process reservation until query
+                        // teardown, and the next scan skips the logon.  See
+                        // FinishScan for why a cancelled scan closes instead.
+                        if (owning_state_machine->bind_data->IsCancelled()) {
+                            owning_state_machine->InvalidateCachedConnection();
+                        } else {
+                            owning_state_machine->ReleaseCachedConnection();
+                        }
                         // Drop the last batch's SDK function handle now so its
                         // (potentially large) result-table buffer is freed at
                         // end-of-column instead of at query teardown (#69).
@@ -1215,6 +1385,9 @@ namespace duckdb
         int max_attempts = 5;
         int initial_delay = 10000; // milliseconds
         while (attempt < max_attempts) {
+            if (bind_data->IsCancelled()) {
+                throw InterruptException();
+            }
             std::shared_ptr<RfcConnection> connection;
             // Whether this batch's connection is owned by the state machine
             // (don't close on success) vs. per-batch (close on success).
@@ -1249,14 +1422,24 @@ namespace duckdb
                 }
 
                 auto func = owning_state_machine->AcquireFunction(connection, read_table_function);
-                auto func_args = CreateFunctionArguments(read_table_delimiter, use_et_data);
-                auto invocation = func->BeginInvocation(func_args);
+                auto invocation = PrepareInvocation(func, read_table_delimiter, use_et_data);
                 // Execute the RFC call but do NOT materialise the result as a
                 // duckdb::Value tree (issue #69 — that layer drove ~95% of all
                 // heap allocations).  Resolve the SDK result-table handle
                 // instead and stream rows straight into the output Vector
                 // during LoadNextBatchToDuckDBColumn.
-                invocation->Execute();
+                bind_data->stats.RecordBatchSize(NextBatchRowCount());
+                auto call_started = std::chrono::steady_clock::now();
+                bind_data->BeginCall(connection);
+                try {
+                    invocation->Execute();
+                } catch (...) {
+                    bind_data->EndCall(connection);
+                    bind_data->stats.RecordCall(call_started);
+                    throw;
+                }
+                bind_data->EndCall(connection);
+                bind_data->stats.RecordCall(call_started);
                 auto extracted = ResolveResultTable(invocation, data_path);
 
                 if (!persistent_for_this_batch) {
@@ -1279,6 +1462,11 @@ namespace duckdb
                 if (!persistent_for_this_batch && connection) {
                     try { connection->Close(); } catch (...) {}
                 }
+                if (bind_data->IsCancelled()) {
+                    // Whatever failed, it failed because the call was
+                    // aborted (RFC_CANCELED) or is no longer wanted.
+                    throw InterruptException();
+                }
                 std::string err_msg(e.what());
                 if (!IsRetryableRfcError(err_msg)) {
                     if (rfc_type.IsStringType() && err_msg.find("TABLE_WITHOUT_DATA") != std::string::npos) {
@@ -1287,6 +1475,7 @@ namespace duckdb
                         fallback_connection->Close();
                         if (fallback_selected) {
                             // retry immediately with the fallback function
+                            bind_data->stats.retries++;
                             continue;
                         }
                     }
@@ -1295,7 +1484,11 @@ namespace duckdb
 
                 int delay = initial_delay * std::pow(2, attempt);
                 ERPL_TRACE_WARN_DATA("sap_rfc", StringUtil::Format("Warning during fetching next batch. Attempt: %d, Delay: %ds", attempt + 1, (int)(delay / 1000.)), err_msg);
-                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+                RfcTraceSpan backoff_span("RetryBackoff", "rfc", err_msg);
+                if (!bind_data->WaitUnlessCancelled(std::chrono::milliseconds(delay))) {
+                    throw InterruptException();
+                }
+                bind_data->stats.retries++;
                 attempt++;
             }
         }
@@ -1310,16 +1503,8 @@ namespace duckdb
         auto options = bind_data->GetOptions();
         auto fields = bind_data->GetRfcColumnName(owning_state_machine->column_idx);
 
-        auto &desired_batch_size = owning_state_machine->desired_batch_size;
         auto &total_rows = owning_state_machine->total_rows;
-        auto &limit = owning_state_machine->limit;
-
-        // Divisibility-aware trim — see RfcReadColumnStateMachine::TrimmedActualBatchSize.
-        // When MAX_ROWS would force a final batch with an illegal ROWCOUNT,
-        // we over-fetch and let LoadNextBatchToDuckDBColumn() clip the
-        // surplus client-side.
-        auto actual_batch_size = RfcReadColumnStateMachine::TrimmedActualBatchSize(
-            desired_batch_size, total_rows, limit);
+        auto actual_batch_size = NextBatchRowCount();
 
         if (!bind_data->options.empty()) {
             auto options_str = StringUtil::Join(bind_data->options, bind_data->options.size(), " | ", [](auto &o) { return o; });
@@ -1335,7 +1520,12 @@ namespace duckdb
             // We satisfy that by only doubling desired_batch_size when
             // total_rows is divisible by the new size, so total_rows is
             // always a valid (multiple-of-current-ROWCOUNT) offset.
-            args.Add("ROWSKIPS", Value::CreateValue<int32_t>(total_rows));
+            // row_offset is a multiple of MAX_BATCH_SIZE, which every
+            // ROWCOUNT divides, so adding it keeps the invariant.
+            args.Add("ROWSKIPS", Value::CreateValue<int32_t>(bind_data->row_offset + total_rows));
+        } else if (bind_data->row_offset > 0) {
+            throw std::runtime_error(StringUtil::Format("%s has no ROWSKIPS parameter, so ROW_OFFSET cannot be applied",
+                                                        bind_data->GetReadTableFunctionName()));
         }
         if (bind_data->ReadTableHasParam("ROWCOUNT")) {
             args.Add("ROWCOUNT", Value::CreateValue<int32_t>(actual_batch_size));
@@ -1361,8 +1551,58 @@ namespace duckdb
         return args.BuildArgList();
     }
 
+    unsigned int RfcReadColumnTask::NextBatchRowCount() const
+    {
+        // Divisibility-aware trim — see RfcReadColumnStateMachine::TrimmedActualBatchSize.
+        // When MAX_ROWS would force a final batch with an illegal ROWCOUNT,
+        // we over-fetch and let LoadNextBatchToDuckDBColumn() clip the
+        // surplus client-side.
+        return RfcReadColumnStateMachine::TrimmedActualBatchSize(
+            owning_state_machine->desired_batch_size, owning_state_machine->total_rows, owning_state_machine->limit);
+    }
+
+    std::shared_ptr<RfcInvocation> RfcReadColumnTask::PrepareInvocation(std::shared_ptr<RfcFunction> func,
+                                                                        const std::string &delimiter, bool use_et_data)
+    {
+        // Caller already holds thread_lock.  Only the persistent path hands
+        // out the same RfcFunction twice, so a per-batch (non-persistent)
+        // scan never matches and keeps building a fresh handle each time.
+        auto sm = owning_state_machine;
+        auto bind_data = sm->bind_data;
+        auto key = delimiter + (use_et_data ? "|ET_DATA" : "");
+
+        if (sm->prepared_invocation && sm->prepared_invocation->GetFunction() == func &&
+            sm->prepared_invocation_key == key) {
+            std::vector<std::pair<std::string, Value>> paging;
+            if (bind_data->ReadTableHasParam("ROWSKIPS")) {
+                paging.emplace_back("ROWSKIPS", Value::CreateValue<int32_t>(bind_data->row_offset + sm->total_rows));
+            }
+            if (bind_data->ReadTableHasParam("ROWCOUNT")) {
+                paging.emplace_back("ROWCOUNT", Value::CreateValue<int32_t>(NextBatchRowCount()));
+            }
+            // FIELDS and OPTIONS are the only input tables; everything else
+            // (DATA, ET_DATA, TBLOUTxxxx) holds the last batch.  When the
+            // handle cannot be reused, rebuilding it is always correct, just
+            // slower.
+            if (sm->prepared_invocation->PrepareNextCall({"FIELDS", "OPTIONS"}, paging)) {
+                return sm->prepared_invocation;
+            }
+        }
+
+        sm->current_invocation.reset();
+        sm->current_table_handle = nullptr;
+        sm->prepared_invocation.reset();
+
+        auto func_args = CreateFunctionArguments(delimiter, use_et_data);
+        auto invocation = func->BeginInvocation(func_args);
+        sm->prepared_invocation = invocation;
+        sm->prepared_invocation_key = key;
+        return invocation;
+    }
+
     unsigned int RfcReadColumnTask::ResolveResultTable(std::shared_ptr<RfcInvocation> invocation, std::string data_path)
     {
+        RfcTraceSpan span("ResolveResult", "decode", data_path);
         auto sm = owning_state_machine;
         // Keep the invocation alive: it owns the SDK function handle, and the
         // result-table handle resolved below points into that handle's
@@ -1452,6 +1692,7 @@ namespace duckdb
 
     unsigned int RfcReadColumnTask::LoadNextBatchToDuckDBColumn()
     {
+        RfcTraceSpan span("Decode", "decode");
         auto sm = owning_state_machine;
         auto &duck_count = sm->duck_count;
         auto &total_rows = sm->total_rows;
@@ -1480,6 +1721,8 @@ namespace duckdb
         const auto wa_name = sm->wa_field_name;
         const bool is_row_id = sm->row_id_column_id;
 
+        auto decode_started = std::chrono::steady_clock::now();
+        idx_t payload_bytes = 0;
         RFC_ERROR_INFO error_info;
         idx_t row_idx = 0;
         for (idx_t i = batch_start; i < batch_end; ++i, ++row_idx) {
@@ -1498,8 +1741,18 @@ namespace duckdb
             // it to the column's type, write into the output Vector.  No
             // whole-batch duckdb::Value materialisation (issue #69).
             auto wa_value = wa_type->ConvertRfcValueFromContainer(row_handle, wa_name);
+            if (!wa_value.IsNull() && wa_value.type().id() == LogicalTypeId::VARCHAR) {
+                payload_bytes += StringValue::Get(wa_value).size();
+            }
             current_column_output.SetValue(row_idx, ParseCsvValue(rfc_type, wa_value));
         }
+        auto &stats = sm->bind_data->stats;
+        // Every column task decodes the same rows; count them once.
+        if (sm->projected_column_idx == 0) {
+            stats.rows_decoded += row_idx;
+        }
+        stats.payload_bytes += payload_bytes;
+        stats.decode_time_us += RfcReadTableStats::MicrosecondsSince(decode_started);
         return row_idx;
     }
 
@@ -1511,6 +1764,53 @@ namespace duckdb
         return rfc_type.ConvertCsvValue(orig);
     }
     
+    // --------------------------------------------------------------------------------------------
+
+    void RfcReadTableStats::Reset()
+    {
+        rfc_calls = 0;
+        rfc_time_us = 0;
+        payload_bytes = 0;
+        rows_decoded = 0;
+        decode_time_us = 0;
+        connections_opened = 0;
+        connections_reused = 0;
+        retries = 0;
+        max_batch_rows = 0;
+    }
+
+    idx_t RfcReadTableStats::MicrosecondsSince(std::chrono::steady_clock::time_point started)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    void RfcReadTableStats::RecordCall(std::chrono::steady_clock::time_point started)
+    {
+        rfc_calls++;
+        rfc_time_us += MicrosecondsSince(started);
+    }
+
+    void RfcReadTableStats::RecordBatchSize(idx_t rows)
+    {
+        auto max = max_batch_rows.load();
+        while (rows > max && !max_batch_rows.compare_exchange_weak(max, rows)) {
+        }
+    }
+
+    void RfcReadTableStats::AddTo(InsertionOrderPreservingMap<string> &result) const
+    {
+        // Times are summed over the column tasks, which run in parallel, so
+        // they can exceed the query's wall time.
+        result["RFC Calls"] = std::to_string(rfc_calls.load());
+        result["RFC Time"] = StringUtil::Format("%.1f ms", rfc_time_us.load() / 1000.0);
+        result["Payload Received"] = StringUtil::BytesToHumanReadableString(payload_bytes.load());
+        result["Rows Decoded"] = std::to_string(rows_decoded.load());
+        result["Decode Time"] = StringUtil::Format("%.1f ms", decode_time_us.load() / 1000.0);
+        result["Connections"] = StringUtil::Format("%llu opened, %llu reused", connections_opened.load(),
+                                                   connections_reused.load());
+        result["Retries"] = std::to_string(retries.load());
+    }
+
     // --------------------------------------------------------------------------------------------
     std::string ReadTableStatesToString(ReadTableStates &state) 
     {
@@ -5,8 +5,11 @@
 
 #include "erpl_tracing.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <mutex>
+#include <type_traits>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -307,6 +310,125 @@ const ResolvedBackend &Resolve() {
 	return resolved;
 }
 
+// The instrumented table. Each slot is a wrapper that times the call, forwards it to the
+// resolved entry point and tallies the outcome in that slot's counters. Which slot a
+// wrapper belongs to is a template argument, so a call costs two clock reads and a few
+// relaxed atomic adds, and no lookup.
+
+enum RfcApiEntry : idx_t {
+#define ERPL_RFC_API_ENTRY_INDEX(name) RFC_API_ENTRY_##name,
+	ERPL_RFC_API_ENTRY_POINTS(ERPL_RFC_API_ENTRY_INDEX)
+#undef ERPL_RFC_API_ENTRY_INDEX
+	RFC_API_ENTRY_COUNT
+};
+
+const char *const RFC_API_ENTRY_NAMES[] = {
+#define ERPL_RFC_API_ENTRY_NAME(name) #name,
+    ERPL_RFC_API_ENTRY_POINTS(ERPL_RFC_API_ENTRY_NAME)
+#undef ERPL_RFC_API_ENTRY_NAME
+};
+
+// RFC_RC is a small enum; anything past this is tallied in the last slot.
+constexpr idx_t RFC_API_ERROR_CODES = 64;
+
+struct RfcApiEntryCounters {
+	std::atomic<uint64_t> calls {0};
+	std::atomic<uint64_t> errors {0};
+	std::atomic<uint64_t> total_ns {0};
+	std::atomic<uint64_t> max_ns {0};
+	std::atomic<uint64_t> latency[RfcApiEntryStats::LATENCY_BUCKETS] = {};
+	std::atomic<uint64_t> error_codes[RFC_API_ERROR_CODES] = {};
+};
+
+RfcApiEntryCounters g_rfc_api_counters[RFC_API_ENTRY_COUNT];
+std::atomic<bool> g_rfc_api_instrumented {false};
+std::atomic<const RfcApi *> g_rfc_api_override {nullptr};
+
+void RecordRfcApiCall(idx_t entry, std::chrono::steady_clock::time_point start, RFC_RC rc) {
+	auto ns = static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	auto &counters = g_rfc_api_counters[entry];
+	counters.calls.fetch_add(1, std::memory_order_relaxed);
+	counters.total_ns.fetch_add(ns, std::memory_order_relaxed);
+	auto max = counters.max_ns.load(std::memory_order_relaxed);
+	while (ns > max && !counters.max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+	}
+
+	idx_t bucket = 0;
+	for (auto us = ns / 1000; us > 0 && bucket + 1 < RfcApiEntryStats::LATENCY_BUCKETS; us >>= 1) {
+		bucket++;
+	}
+	counters.latency[bucket].fetch_add(1, std::memory_order_relaxed);
+
+	if (rc != RFC_OK) {
+		counters.errors.fetch_add(1, std::memory_order_relaxed);
+		auto code = MinValue<idx_t>(static_cast<idx_t>(rc), RFC_API_ERROR_CODES - 1);
+		counters.error_codes[code].fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+// How a call went, from its return value: entry points either return an RFC_RC, or a
+// handle that is null on failure with the reason in their RFC_ERROR_INFO argument. The
+// few that return a string cannot fail.
+struct RfcCallOutcome {
+	static RFC_ERROR_INFO *ErrorInfo() {
+		return nullptr;
+	}
+
+	template <class T, class... REST>
+	static RFC_ERROR_INFO *ErrorInfo(T arg, REST... rest) {
+		if constexpr (std::is_same<T, RFC_ERROR_INFO *>::value) {
+			return arg;
+		} else {
+			return ErrorInfo(rest...);
+		}
+	}
+
+	template <class R, class... ARGS>
+	static RFC_RC Of(R result, ARGS... args) {
+		if constexpr (std::is_same<R, RFC_RC>::value) {
+			return result;
+		} else if constexpr (std::is_pointer<R>::value && !std::is_same<R, const SAP_UC *>::value) {
+			if (result) {
+				return RFC_OK;
+			}
+			auto *info = ErrorInfo(args...);
+			return info ? info->code : RFC_UNKNOWN_ERROR;
+		} else {
+			return RFC_OK;
+		}
+	}
+};
+
+template <idx_t ENTRY, class F>
+struct InstrumentedSlot;
+
+template <idx_t ENTRY, class R, class... ARGS>
+struct InstrumentedSlot<ENTRY, R(SAP_API *)(ARGS...)> {
+	static inline R(SAP_API *target)(ARGS...) = nullptr;
+
+	static R SAP_API Call(ARGS... args) {
+		auto start = std::chrono::steady_clock::now();
+		R result = target(args...);
+		RecordRfcApiCall(ENTRY, start, RfcCallOutcome::Of(result, args...));
+		return result;
+	}
+};
+
+const RfcApi &InstrumentedApi() {
+	static RfcApi instrumented = [] {
+		auto &api = Resolve().api;
+		RfcApi table {};
+#define ERPL_RFC_API_INSTRUMENT_SLOT(name)                                                                             \
+	InstrumentedSlot<RFC_API_ENTRY_##name, decltype(api.name)>::target = api.name;                                     \
+	table.name = &InstrumentedSlot<RFC_API_ENTRY_##name, decltype(api.name)>::Call;
+		ERPL_RFC_API_ENTRY_POINTS(ERPL_RFC_API_INSTRUMENT_SLOT)
+#undef ERPL_RFC_API_INSTRUMENT_SLOT
+		return table;
+	}();
+	return instrumented;
+}
+
 } // namespace
 
 const char *RfcBackendName(RfcBackend backend) {
@@ -346,9 +468,85 @@ void SetRfcBackendLibraryPath(const string &path) {
 }
 
 const RfcApi &GetRfcApi() {
+	if (auto *override_api = g_rfc_api_override.load(std::memory_order_acquire)) {
+		return *override_api;
+	}
+	if (g_rfc_api_instrumented.load(std::memory_order_relaxed)) {
+		return InstrumentedApi();
+	}
 	return Resolve().api;
 }
 
+void SetRfcApiInstrumentation(bool enabled) {
+	if (enabled && !g_rfc_api_instrumented.load(std::memory_order_relaxed)) {
+		ResetRfcApiStats();
+	}
+	g_rfc_api_instrumented.store(enabled, std::memory_order_relaxed);
+}
+
+void SetRfcApiOverride(const RfcApi *api) {
+	g_rfc_api_override.store(api, std::memory_order_release);
+}
+
+bool IsRfcApiInstrumented() {
+	return g_rfc_api_instrumented.load(std::memory_order_relaxed);
+}
+
+vector<RfcApiEntryStats> GetRfcApiStats() {
+	vector<RfcApiEntryStats> result;
+	for (idx_t entry = 0; entry < RFC_API_ENTRY_COUNT; entry++) {
+		auto &counters = g_rfc_api_counters[entry];
+		RfcApiEntryStats stats;
+		stats.name = RFC_API_ENTRY_NAMES[entry];
+		stats.calls = counters.calls.load(std::memory_order_relaxed);
+		stats.errors = counters.errors.load(std::memory_order_relaxed);
+		stats.total_ns = counters.total_ns.load(std::memory_order_relaxed);
+		stats.max_ns = counters.max_ns.load(std::memory_order_relaxed);
+		for (idx_t bucket = 0; bucket < RfcApiEntryStats::LATENCY_BUCKETS; bucket++) {
+			stats.latency[bucket] = counters.latency[bucket].load(std::memory_order_relaxed);
+		}
+		for (idx_t code = 0; code < RFC_API_ERROR_CODES; code++) {
+			auto count = counters.error_codes[code].load(std::memory_order_relaxed);
+			if (count > 0) {
+				stats.error_codes.emplace_back(static_cast<RFC_RC>(code), count);
+			}
+		}
+		result.push_back(std::move(stats));
+	}
+	return result;
+}
+
+void ResetRfcApiStats() {
+	for (auto &counters : g_rfc_api_counters) {
+		counters.calls.store(0, std::memory_order_relaxed);
+		counters.errors.store(0, std::memory_order_relaxed);
+		counters.total_ns.store(0, std::memory_order_relaxed);
+		counters.max_ns.store(0, std::memory_order_relaxed);
+		for (auto &bucket : counters.latency) {
+			bucket.store(0, std::memory_order_relaxed);
+		}
+		for (auto &code : counters.error_codes) {
+			code.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+double RfcApiEntryStats::LatencyPercentileUs(double p) const {
+	if (calls == 0) {
+		return 0;
+	}
+	auto max_us = static_cast<double>(max_ns) / 1000.0;
+	auto rank = static_cast<uint64_t>(p * static_cast<double>(calls) + 0.5);
+	uint64_t seen = 0;
+	for (idx_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+		seen += latency[bucket];
+		if (seen >= rank && seen > 0) {
+			return MinValue<double>(static_cast<double>(uint64_t(1) << bucket), max_us);
+		}
+	}
+	return max_us;
+}
+
 RfcBackend GetResolvedRfcBackend() {
 	return Resolve().backend;
 }
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "sap_scan_history.hpp"
+#include "erpl_tracing.hpp"
+
+namespace duckdb
+{
+    static std::mutex g_rfc_scan_history_lock;
+    static std::string g_rfc_scan_history_path;
+    // Read at the end of every scan; the path itself only under the lock.
+    static std::atomic<bool> g_rfc_scan_history_enabled{false};
+
+    void SetRfcScanHistoryPath(const std::string &path)
+    {
+        std::lock_guard<std::mutex> guard(g_rfc_scan_history_lock);
+        g_rfc_scan_history_path = path;
+        g_rfc_scan_history_enabled.store(!path.empty(), std::memory_order_relaxed);
+    }
+
+    std::string GetRfcScanHistoryPath()
+    {
+        std::lock_guard<std::mutex> guard(g_rfc_scan_history_lock);
+        return g_rfc_scan_history_path;
+    }
+
+    std::string RfcScanHistory::Fingerprint(const std::string &value)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (auto c : value) {
+            hash ^= (unsigned char)c;
+            hash *= 1099511628211ULL;
+        }
+        return StringUtil::Format("%016llx", (unsigned long long)hash);
+    }
+
+    std::string RfcScanHistory::ObjectFingerprint(const std::string &name)
+    {
+        auto normalized = StringUtil::Upper(name);
+        StringUtil::Trim(normalized);
+        return Fingerprint(normalized);
+    }
+
+    int64_t RfcScanHistory::NowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::string RfcScanHistory::FormatRecord(const RfcScanRecord &r)
+    {
+        return StringUtil::Format("%s\t%lld\t%s\t%s\t%s\t%s\t%s\t%.3f\t%llu\t%llu\t%llu\t%.3f\t%llu\t%llu\t%llu\t%llu\t%llu\t%llu",
+                                  LINE_VERSION, (long long)r.finished_at_ms, r.function, r.status, r.source, r.system,
+                                  r.object, r.duration_ms, r.rows, r.payload_bytes, r.rfc_calls, r.rfc_time_ms,
+                                  r.retries, r.connections_opened, r.connections_reused, r.columns, r.threads,
+                                  r.max_batch_rows);
+    }
+
+    bool RfcScanHistory::ParseRecord(const std::string &line, RfcScanRecord &r)
+    {
+        auto fields = StringUtil::Split(line, '\t');
+        if (fields.size() != 18 || fields[0] != LINE_VERSION) {
+            return false;
+        }
+        try {
+            r.finished_at_ms = std::stoll(fields[1]);
+            r.function = fields[2];
+            r.status = fields[3];
+            r.source = fields[4];
+            r.system = fields[5];
+            r.object = fields[6];
+            r.duration_ms = std::stod(fields[7]);
+            r.rows = std::stoull(fields[8]);
+            r.payload_bytes = std::stoull(fields[9]);
+            r.rfc_calls = std::stoull(fields[10]);
+            r.rfc_time_ms = std::stod(fields[11]);
+            r.retries = std::stoull(fields[12]);
+            r.connections_opened = std::stoull(fields[13]);
+            r.connections_reused = std::stoull(fields[14]);
+            r.columns = std::stoull(fields[15]);
+            r.threads = std::stoull(fields[16]);
+            r.max_batch_rows = std::stoull(fields[17]);
+        } catch (std::exception &) {
+            return false;
+        }
+        return true;
+    }
+
+    void RfcScanHistory::Append(FileSystem &fs, const RfcScanRecord &record)
+    {
+        if (!g_rfc_scan_history_enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            std::lock_guard<std::mutex> guard(g_rfc_scan_history_lock);
+            if (g_rfc_scan_history_path.empty()) {
+                return;
+            }
+            // One write of the whole line to a file opened for appending:
+            // lines of other processes land before or after it, not inside.
+            auto line = FormatRecord(record) + "\n";
+            auto handle = fs.OpenFile(g_rfc_scan_history_path, FileFlags::FILE_FLAGS_WRITE |
+                                                               FileFlags::FILE_FLAGS_FILE_CREATE |
+                                                               FileFlags::FILE_FLAGS_APPEND);
+            handle->Write((void *)line.data(), line.size());
+            handle->Close();
+        } catch (std::exception &ex) {
+            ERPL_TRACE_WARN_DATA("sap_scan_history", "Could not record the scan", ex.what());
+        }
+    }
+
+    std::vector<RfcScanRecord> RfcScanHistory::Read(FileSystem &fs, const std::string &path)
+    {
+        std::vector<RfcScanRecord> records;
+        if (!fs.FileExists(path)) {
+            // Nothing recorded yet.
+            return records;
+        }
+        auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+        std::string text(handle->GetFileSize(), '\0');
+        handle->Read((void *)text.data(), text.size());
+        for (auto &line : StringUtil::Split(text, '\n')) {
+            RfcScanRecord record;
+            if (ParseRecord(line, record)) {
+                records.push_back(std::move(record));
+            }
+        }
+        return records;
+    }
+} // namespace duckdb
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <atomic>
+
+#include "sap_shared_scan.hpp"
+#include "erpl_tracing.hpp"
+
+namespace duckdb
+{
+    static std::atomic<idx_t> g_rfc_shared_scan_buffer{RfcSharedScan::DEFAULT_BUFFER};
+    void SetRfcSharedScanBuffer(idx_t bytes) { g_rfc_shared_scan_buffer.store(bytes, std::memory_order_relaxed); }
+    idx_t GetRfcSharedScanBuffer() { return g_rfc_shared_scan_buffer.load(std::memory_order_relaxed); }
+
+    // Scans by key.  Entries of finished or closed scans are left to expire
+    // and swept by Join(): the scans themselves never take this lock, so it
+    // is always acquired before a scan's own.
+    static std::mutex g_shared_scans_lock;
+    static std::map<std::string, std::weak_ptr<RfcSharedScan>> g_shared_scans;
+
+    // RfcSharedScan --------------------------------------------------------------
+
+    RfcSharedScan::RfcSharedScan(ClientContext &producer_context)
+        : producer_context(&producer_context), idle_since(Clock::now())
+    { }
+
+    std::string RfcSharedScan::Key(const std::string &system, const RfcReadTableBindData &bind_data,
+                                   const std::vector<std::string> &columns)
+    {
+        if (system.empty()) {
+            return std::string();
+        }
+        // Sections are newline-separated; option lines and columns use a unit
+        // separator, which neither a where clause nor a column name contains.
+        return StringUtil::Format("%s\n%s\n%s\n%s\n%u\n%u\n%s\n%s", system, StringUtil::Upper(bind_data.table_name),
+                                  bind_data.read_table_function, bind_data.read_table_delimiter, bind_data.limit,
+                                  bind_data.row_offset, StringUtil::Join(bind_data.options, "\x1f"),
+                                  StringUtil::Join(columns, "\x1f"));
+    }
+
+    std::shared_ptr<RfcSharedScan> RfcSharedScan::Join(const std::string &key, ClientContext &context,
+                                                       bool &producer, idx_t &reader_id)
+    {
+        producer = false;
+        reader_id = DConstants::INVALID_INDEX;
+        if (key.empty() || GetRfcSharedScanBuffer() == 0) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> guard(g_shared_scans_lock);
+        for (auto it = g_shared_scans.begin(); it != g_shared_scans.end();) {
+            auto running = it->second.lock();
+            if (!running) {
+                it = g_shared_scans.erase(it);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> scan_guard(running->lock);
+                if (!running->open) {
+                    it = g_shared_scans.erase(it);
+                    continue;
+                }
+            }
+            ++it;
+        }
+
+        auto it = g_shared_scans.find(key);
+        auto running = it != g_shared_scans.end() ? it->second.lock() : nullptr;
+        if (running) {
+            std::lock_guard<std::mutex> scan_guard(running->lock);
+            // Checked again: the producer may have closed the scan since the sweep.
+            if (running->open) {
+                if (running->producer_context == &context) {
+                    return nullptr;
+                }
+                reader_id = running->next_reader_id++;
+                running->readers[reader_id] = running->first_batch;
+                ERPL_TRACE_DEBUG("sap_shared_scan",
+                                 StringUtil::Format("Joined a running scan as reader %llu, %llu batches spooled",
+                                                    reader_id, (idx_t)running->spool.size()));
+                return running;
+            }
+        }
+
+        auto scan = std::shared_ptr<RfcSharedScan>(new RfcSharedScan(context));
+        g_shared_scans[key] = scan;
+        producer = true;
+        return scan;
+    }
+
+    idx_t RfcSharedScan::RunningCount()
+    {
+        std::lock_guard<std::mutex> guard(g_shared_scans_lock);
+        idx_t count = 0;
+        for (auto &entry : g_shared_scans) {
+            auto running = entry.second.lock();
+            if (!running) {
+                continue;
+            }
+            std::lock_guard<std::mutex> scan_guard(running->lock);
+            if (running->open) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void RfcSharedScan::BeginStep()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        producing = true;
+    }
+
+    void RfcSharedScan::Publish(const DataChunk &chunk)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            producing = false;
+            idle_since = Clock::now();
+            if (chunk.size() == 0) {
+                return;
+            }
+            if (open || !readers.empty()) {
+                auto copy = make_uniq<DataChunk>();
+                copy->Initialize(Allocator::DefaultAllocator(), chunk.GetTypes(),
+                                 MaxValue<idx_t>(chunk.size(), STANDARD_VECTOR_SIZE));
+                chunk.Copy(*copy);
+                spool_bytes += copy->GetAllocationSize();
+                spool.push_back(std::move(copy));
+                Trim();
+            } else {
+                // Nobody can read it; only the numbering moves on.
+                first_batch++;
+            }
+        }
+        cv.notify_all();
+    }
+
+    void RfcSharedScan::Finish()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            finished = true;
+            open = false;
+            producing = false;
+            Trim();
+        }
+        cv.notify_all();
+    }
+
+    void RfcSharedScan::Abandon()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (finished) {
+                return;
+            }
+            abandoned = true;
+            open = false;
+            producing = false;
+            if (!readers.empty()) {
+                ERPL_TRACE_DEBUG("sap_shared_scan", StringUtil::Format("Producer stopped early; %llu readers continue alone",
+                                                                       (idx_t)readers.size()));
+            }
+            Trim();
+        }
+        cv.notify_all();
+    }
+
+    RfcSharedScan::ReadResult RfcSharedScan::Read(ClientContext &context, idx_t reader_id, DataChunk &output)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+            auto reader = readers.find(reader_id);
+            if (reader == readers.end()) {
+                return ReadResult::DETACHED;
+            }
+            if (reader->second < first_batch + spool.size()) {
+                spool[reader->second - first_batch]->Copy(output);
+                reader->second++;
+                Trim();
+                return ReadResult::CHUNK;
+            }
+            if (finished) {
+                readers.erase(reader);
+                return ReadResult::FINISHED;
+            }
+            if (abandoned || (!producing && Clock::now() - idle_since > PRODUCER_IDLE_TIMEOUT)) {
+                readers.erase(reader);
+                Trim();
+                return ReadResult::DETACHED;
+            }
+            if (context.interrupted.load()) {
+                throw InterruptException();
+            }
+            // Woken by Publish(); the timeout only serves the idle and
+            // interrupt checks above.
+            cv.wait_for(guard, std::chrono::milliseconds(100));
+        }
+    }
+
+    void RfcSharedScan::Leave(idx_t reader_id)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        readers.erase(reader_id);
+        Trim();
+    }
+
+    void RfcSharedScan::Trim()
+    {
+        auto budget = GetRfcSharedScanBuffer();
+        auto drop_passed = [&]() {
+            auto needed = first_batch + spool.size();
+            for (auto &reader : readers) {
+                needed = MinValue<idx_t>(needed, reader.second);
+            }
+            while (first_batch < needed) {
+                spool_bytes -= spool.front()->GetAllocationSize();
+                spool.pop_front();
+                first_batch++;
+            }
+        };
+
+        // While open, the spool is kept from the first batch for late readers.
+        if (open && spool_bytes <= budget) {
+            return;
+        }
+        if (open) {
+            open = false;
+            ERPL_TRACE_DEBUG("sap_shared_scan", StringUtil::Format("Spool full at %llu bytes; closed to new readers",
+                                                                   spool_bytes));
+        }
+        drop_passed();
+        while (spool_bytes > budget && !readers.empty()) {
+            auto slowest = std::min_element(readers.begin(), readers.end(),
+                                            [](const std::pair<const idx_t, idx_t> &a,
+                                               const std::pair<const idx_t, idx_t> &b) { return a.second < b.second; });
+            ERPL_TRACE_DEBUG("sap_shared_scan", StringUtil::Format("Reader %llu fell %llu batches behind; it continues alone",
+                                                                   slowest->first,
+                                                                   first_batch + spool.size() - slowest->second));
+            readers.erase(slowest);
+            drop_passed();
+        }
+    }
+} // namespace duckdb
@@ -30,10 +30,144 @@
 #endif
 
 #include "sap_storage.hpp"
+#include "sap_attach_warmup.hpp"
 #include "sap_connection.hpp"
+#include "sap_replica.hpp"
+
+#include <atomic>
 
 namespace duckdb {
 
+static std::atomic<unsigned int> g_rfc_catalog_discovery_threads{3};
+void SetRfcCatalogDiscoveryThreads(unsigned int n) {
+	g_rfc_catalog_discovery_threads.store(n, std::memory_order_relaxed);
+}
+unsigned int GetRfcCatalogDiscoveryThreads() {
+	return g_rfc_catalog_discovery_threads.load(std::memory_order_relaxed);
+}
+
+// SapAttachWarmup ------------------------------------------------------------
+
+SapAttachWarmup::SapAttachWarmup(RfcAuthParams auth_params_p, idx_t warm_connections,
+                                 const vector<string> &prefetch_tables, SchemaLookup lookup_p)
+    : auth_params(std::move(auth_params_p)), pool_key(auth_params.PoolKey()), lookup(std::move(lookup_p)) {
+	// More than the pool keeps would be logged on only to be closed.
+	warm_connections = MinValue<idx_t>(warm_connections, RfcConnectionPool::MAX_PARKED_PER_KEY);
+	for (idx_t i = 0; i < warm_connections; i++) {
+		threads.emplace_back([this]() { WarmConnection(); });
+	}
+	Prefetch(prefetch_tables, MAX_PREFETCH_THREADS);
+}
+
+SapAttachWarmup::~SapAttachWarmup() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		cancelled = true;
+		queue.clear();
+		pending.clear();
+	}
+	cv.notify_all();
+	for (auto &thread : threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+}
+
+void SapAttachWarmup::Prefetch(const vector<string> &tables, idx_t max_threads) {
+	std::lock_guard<std::mutex> guard(lock);
+	if (cancelled) {
+		return;
+	}
+	for (auto &table : tables) {
+		if (schemas.find(table) == schemas.end() && pending.insert(table).second) {
+			queue.push_back(table);
+		}
+	}
+	auto target = MinValue<idx_t>(MinValue<idx_t>(max_threads, MAX_DISCOVERY_THREADS), queue.size());
+	while (prefetch_workers < target) {
+		prefetch_workers++;
+		threads.emplace_back([this]() { PrefetchSchemas(); });
+	}
+}
+
+bool SapAttachWarmup::TryGetSchema(const string &table, SapTableSchema &schema) {
+	std::unique_lock<std::mutex> guard(lock);
+	cv.wait(guard, [&]() { return pending.find(table) == pending.end(); });
+	auto it = schemas.find(table);
+	if (it == schemas.end()) {
+		return false;
+	}
+	schema = it->second;
+	return true;
+}
+
+SapTableSchema SapAttachWarmup::LookupDdicSchema(RfcAuthParams &auth_params,
+                                                 std::shared_ptr<RfcConnection> &connection, const string &table) {
+	// Connect() serves from the pool first, so warm connections and those
+	// parked by earlier workers skip the logon.
+	if (!connection) {
+		connection = auth_params.Connect();
+	}
+	SapTableSchema schema;
+	schema.field_metas = RfcReadTableBindData::GetTableFieldMetas(connection, table);
+	RfcReadTableBindData::GetSchemaForFieldMetas(schema.field_metas, schema.names, schema.types);
+	return schema;
+}
+
+void SapAttachWarmup::WarmConnection() {
+	try {
+		auto connection = auth_params.OpenConnection();
+		RfcConnectionPool::Get().Park(pool_key, std::move(connection));
+	} catch (std::exception &ex) {
+		ERPL_TRACE_WARN_DATA("sap_storage", "Connection warm-up failed", string(ex.what()));
+	}
+}
+
+void SapAttachWarmup::PrefetchSchemas() {
+	std::shared_ptr<RfcConnection> connection;
+	while (true) {
+		string table;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (cancelled || queue.empty()) {
+				prefetch_workers--;
+				break;
+			}
+			table = queue.front();
+			queue.pop_front();
+		}
+
+		SapTableSchema schema;
+		bool ok = false;
+		try {
+			schema = lookup(auth_params, connection, table);
+			ok = true;
+		} catch (std::exception &ex) {
+			// Left to the foreground lookup, which has the context to
+			// turn the failure into an actionable error.
+			ERPL_TRACE_DEBUG_DATA("sap_storage", StringUtil::Format("Schema prefetch for '%s' failed", table),
+			                      string(ex.what()));
+			connection.reset();
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (ok && !cancelled) {
+				schemas[table] = std::move(schema);
+			}
+			pending.erase(table);
+		}
+		cv.notify_all();
+	}
+
+	// The connection is logged on and idle now — exactly what the pool
+	// is for.
+	if (connection && !cancelled) {
+		RfcConnectionPool::Get().Park(pool_key, std::move(connection));
+	}
+}
+
 // ---------------------------------------------------------------------------
 // SapDefaultGenerator — lazy on-demand SAP table entries
 //
@@ -49,9 +183,13 @@ namespace duckdb {
 class SapDefaultGenerator : public DefaultGenerator {
 public:
 	SapDefaultGenerator(Catalog &catalog, SchemaCatalogEntry &schema, string secret_name,
-	                    vector<string> allowed_tables)
+	                    vector<string> allowed_tables, unique_ptr<SapAttachWarmup> warmup = nullptr,
+	                    std::shared_ptr<SapReplica> replica = nullptr)
 	    : DefaultGenerator(catalog), schema(schema), secret_name(std::move(secret_name)),
-	      allowed_tables(std::move(allowed_tables)) {
+	      allowed_tables(std::move(allowed_tables)), warmup(std::move(warmup)), replica(std::move(replica)) {
+		if (this->replica) {
+			refresher = make_uniq<SapReplicaRefresher>(catalog.GetDatabase(), this->replica);
+		}
 	}
 
 	unique_ptr<CatalogEntry> CreateDefaultEntry(ClientContext &context, const string &entry_name) override {
@@ -84,18 +222,16 @@ public:
 		//     truth is "no auth") or violates DuckDB's contract when the
 		//     name is in our explicit GetDefaultEntries() list, which
 		//     surfaces as an INTERNAL assertion further up the stack.
-		vector<string> names;
-		vector<LogicalType> types;
+		SapTableSchema table_schema;
 		try {
-			auto bind_data = make_uniq<RfcReadTableBindData>(
-			    entry_name, /*max_read_threads=*/0, /*limit=*/0, "RFC_READ_TABLE", "",
-			    /*read_table_function_user_set=*/false, &DefaultRfcConnectionFactory, context);
-			if (!secret_name.empty()) {
-				bind_data->SetSecretName(secret_name);
+			auto discovery = StartBulkDiscovery(context);
+			if (!discovery || !discovery->TryGetSchema(entry_name, table_schema)) {
+				auto connection = secret_name.empty() ? DefaultRfcConnectionFactory(context)
+				                                      : RfcAuthParams::FromContext(context, secret_name).Connect();
+				table_schema.field_metas = RfcReadTableBindData::GetTableFieldMetas(connection, entry_name);
+				RfcReadTableBindData::GetSchemaForFieldMetas(table_schema.field_metas, table_schema.names,
+				                                             table_schema.types);
 			}
-			bind_data->InitAndVerifyFields({});
-			names = bind_data->GetRfcColumnNames();
-			types = bind_data->GetReturnTypes();
 		} catch (std::exception &ex) {
 			const std::string err_msg(ex.what());
 			ERPL_TRACE_DEBUG_DATA("sap_storage",
@@ -135,21 +271,62 @@ public:
 		info.catalog = catalog.GetName();
 		info.schema = DEFAULT_SCHEMA;
 		info.table = entry_name;
-		for (idx_t i = 0; i < names.size(); i++) {
-			info.columns.AddColumn(ColumnDefinition(names[i], types[i]));
+		for (idx_t i = 0; i < table_schema.names.size(); i++) {
+			info.columns.AddColumn(ColumnDefinition(table_schema.names[i], table_schema.types[i]));
 		}
 
-		return make_uniq_base<CatalogEntry, SapTableEntry>(catalog, schema, info, entry_name, secret_name);
+		return make_uniq_base<CatalogEntry, SapTableEntry>(catalog, schema, info, entry_name, secret_name,
+		                                                   std::move(table_schema.field_metas), replica);
 	}
 
 	vector<string> GetDefaultEntries() override {
+		// Only called when the whole catalog set is enumerated, which is
+		// followed by one CreateDefaultEntry() per missing name.  The first
+		// of those starts discovery for all of them.
+		if (!allowed_tables.empty()) {
+			enumerating = true;
+		}
 		return allowed_tables;
 	}
 
 private:
+	// Once the catalog has been enumerated, queues every TABLES entry for
+	// concurrent discovery (once per attach) and returns the discovery
+	// workers; null when there is nothing to wait for.  Single-table lookups
+	// before that only use what PREFETCH_SCHEMA fetched, so a `SELECT` from
+	// one table never triggers discovery of the whole allow-list.
+	SapAttachWarmup *StartBulkDiscovery(ClientContext &context) {
+		std::lock_guard<std::mutex> guard(discovery_lock);
+		auto threads = GetRfcCatalogDiscoveryThreads();
+		if (enumerating && !bulk_discovery_started && threads > 0) {
+			if (!warmup) {
+				auto auth_params =
+				    RfcAuthParams::FromContext(context, secret_name.empty() ? SAP_SECRET_DEFAULT_PATH : secret_name);
+				warmup = make_uniq<SapAttachWarmup>(std::move(auth_params), 0, vector<string>());
+			}
+			warmup->Prefetch(allowed_tables, threads);
+			bulk_discovery_started = true;
+			ERPL_TRACE_INFO_DATA("sap_storage", "Started bulk catalog discovery",
+			                     StringUtil::Format("%llu tables, %u threads", (idx_t)allowed_tables.size(), threads));
+		}
+		return warmup.get();
+	}
+
 	SchemaCatalogEntry &schema;
 	string secret_name;
 	vector<string> allowed_tables;
+
+	std::mutex discovery_lock;
+	// Created lazily by StartBulkDiscovery() unless ATTACH already asked for
+	// WARM_CONNECTIONS or PREFETCH_SCHEMA.
+	unique_ptr<SapAttachWarmup> warmup;
+	std::atomic<bool> enumerating {false};
+	bool bulk_discovery_started = false;
+
+	// CACHE: the local copy the table entries read from, and the thread
+	// keeping it fresh.  Declared last so the thread stops first.
+	std::shared_ptr<SapReplica> replica;
+	unique_ptr<SapReplicaRefresher> refresher;
 };
 
 #else
@@ -158,9 +335,9 @@ private:
 class SapDefaultGenerator : public DefaultGenerator {
 public:
 	SapDefaultGenerator(Catalog &catalog, SchemaCatalogEntry &schema, string secret_name,
-	                    vector<string> allowed_tables)
+	                    vector<string> allowed_tables, unique_ptr<SapAttachWarmup> warmup = nullptr)
 	    : DefaultGenerator(catalog), schema(schema), secret_name(std::move(secret_name)),
-	      allowed_tables(std::move(allowed_tables)) {
+	      allowed_tables(std::move(allowed_tables)), warmup(std::move(warmup)) {
 	}
 
 	unique_ptr<CatalogEntry> CreateDefaultEntry(ClientContext &context, const string &entry_name) override {
@@ -199,6 +376,8 @@ private:
 	SchemaCatalogEntry &schema;
 	string secret_name;
 	vector<string> allowed_tables;
+	// Only WARM_CONNECTIONS is meaningful here; views bind lazily.
+	unique_ptr<SapAttachWarmup> warmup;
 };
 
 #endif
@@ -266,9 +445,23 @@ public:
 		view_generator_ = gen;
 	}
 
+	void SetReplica(std::shared_ptr<SapReplica> replica) {
+		replica_ = std::move(replica);
+	}
+
+	// DETACH stops the replica's refresh at once.  The generator owning its
+	// thread is only destroyed with the catalog, which may be later.
+	void OnDetach(ClientContext &context) override {
+		if (replica_) {
+			replica_->Stop();
+		}
+		DuckCatalog::OnDetach(context);
+	}
+
 private:
 	// Non-owning pointer; generator is owned by the CatalogSet inside this catalog.
 	SapDefaultGenerator *view_generator_;
+	std::shared_ptr<SapReplica> replica_;
 
 	CatalogEntryLookup TryLookupEntryInternal(CatalogTransaction transaction, const string &schema_name,
 	                                          const EntryLookupInfo &lookup_info) override {
@@ -376,10 +569,30 @@ static unique_ptr<Catalog> SapStorageAttach(optional_ptr<StorageExtensionInfo> s
 	string secret_name;
 	vector<string> allowed_tables;
 	vector<string> table_patterns;
+	int64_t warm_connections = 0;
+	bool prefetch_schema = false;
+	string cache_path;
+	int64_t refresh_micros = -1;
 
 	for (auto &entry : attach_options.options) {
 		auto lower_name = StringUtil::Lower(entry.first);
-		if (lower_name == "secret") {
+		if (lower_name == "warm_connections") {
+			warm_connections = entry.second.DefaultCastAs(LogicalType::BIGINT).GetValue<int64_t>();
+			if (warm_connections < 0 || warm_connections > (int64_t)SapAttachWarmup::MAX_WARM_CONNECTIONS) {
+				throw InvalidInputException("WARM_CONNECTIONS must be between 0 and %llu, got %lld",
+				                            SapAttachWarmup::MAX_WARM_CONNECTIONS, warm_connections);
+			}
+		} else if (lower_name == "prefetch_schema") {
+			prefetch_schema = entry.second.DefaultCastAs(LogicalType::BOOLEAN).GetValue<bool>();
+		} else if (lower_name == "cache") {
+			cache_path = entry.second.ToString();
+		} else if (lower_name == "refresh") {
+			auto interval = entry.second.DefaultCastAs(LogicalType::INTERVAL).GetValue<interval_t>();
+			refresh_micros = Interval::GetMicro(interval);
+			if (refresh_micros < Interval::MICROS_PER_MINUTE) {
+				throw InvalidInputException("REFRESH must be at least 1 minute, got '%s'", entry.second.ToString());
+			}
+		} else if (lower_name == "secret") {
 			secret_name = entry.second.ToString();
 		} else if (lower_name == "tables") {
 			auto tables_str = entry.second.ToString();
@@ -401,6 +614,10 @@ static unique_ptr<Catalog> SapStorageAttach(optional_ptr<StorageExtensionInfo> s
 	// Remove consumed options so SingleFileStorageManager doesn't reject them
 	attach_options.options.erase("secret");
 	attach_options.options.erase("tables");
+	attach_options.options.erase("warm_connections");
+	attach_options.options.erase("prefetch_schema");
+	attach_options.options.erase("cache");
+	attach_options.options.erase("refresh");
 
 	// Validate secret exists if specified
 	if (!secret_name.empty()) {
@@ -440,6 +657,32 @@ static unique_ptr<Catalog> SapStorageAttach(optional_ptr<StorageExtensionInfo> s
 		}
 	}
 
+	if (prefetch_schema && allowed_tables.empty()) {
+		throw InvalidInputException(
+		    "PREFETCH_SCHEMA needs a TABLES list to prefetch; without TABLES, tables are resolved on demand.");
+	}
+	if (refresh_micros >= 0 && cache_path.empty()) {
+		throw InvalidInputException("REFRESH only applies to a replica; add CACHE '<file>.duckdb'.");
+	}
+	if (!cache_path.empty() && allowed_tables.empty()) {
+		throw InvalidInputException(
+		    "CACHE mirrors the tables listed in TABLES; add TABLES 'T001,MARA,...' to choose them.");
+	}
+#if DUCKDB_MINOR_VERSION < 5
+	if (!cache_path.empty()) {
+		throw InvalidInputException("CACHE requires DuckDB 1.5 or later.");
+	}
+#endif
+
+	// Started only after the allow-list is final, so a rejected ATTACH never
+	// leaves threads behind.
+	unique_ptr<SapAttachWarmup> warmup;
+	if (warm_connections > 0 || prefetch_schema) {
+		auto auth_params = RfcAuthParams::FromContext(context, secret_name.empty() ? SAP_SECRET_DEFAULT_PATH : secret_name);
+		warmup = make_uniq<SapAttachWarmup>(std::move(auth_params), (idx_t)warm_connections,
+		                                    prefetch_schema ? allowed_tables : vector<string>());
+	}
+
 	// Create an in-memory catalog
 	info.path = ":memory:";
 
@@ -451,9 +694,18 @@ static unique_ptr<Catalog> SapStorageAttach(optional_ptr<StorageExtensionInfo> s
 	auto &schema = sap_catalog->GetSchema(system_transaction, DEFAULT_SCHEMA);
 	auto &duck_schema = schema.Cast<DuckSchemaEntry>();
 
+	// ── Local replica (CACHE / REFRESH) ──────────────────────────────────────
+	std::shared_ptr<SapReplica> replica;
+	if (!cache_path.empty()) {
+		replica = SapReplica::Create(name, cache_path, secret_name, allowed_tables,
+		                             refresh_micros >= 0 ? refresh_micros : SapReplica::DEFAULT_REFRESH_MICROS);
+	}
+
 	// ── Table generator (on-demand SapTableEntry per SAP table, issue #63) ─
 	auto &table_catalog_set = duck_schema.GetCatalogSet(CatalogType::TABLE_ENTRY);
-	auto table_gen = make_uniq<SapDefaultGenerator>(*sap_catalog, schema, secret_name, allowed_tables);
+	sap_catalog->SetReplica(replica);
+	auto table_gen = make_uniq<SapDefaultGenerator>(*sap_catalog, schema, secret_name, allowed_tables,
+	                                                std::move(warmup), std::move(replica));
 	sap_catalog->SetViewGenerator(table_gen.get());
 	table_catalog_set.SetDefaultGenerator(std::move(table_gen));
 
@@ -493,8 +745,8 @@ static unique_ptr<Catalog> SapStorageAttach(optional_ptr<StorageExtensionInfo> s
 	auto &schema = catalog->GetSchema(system_transaction, DEFAULT_SCHEMA);
 	auto &duck_schema = schema.Cast<DuckSchemaEntry>();
 	auto &catalog_set = duck_schema.GetCatalogSet(CatalogType::VIEW_ENTRY);
-	auto default_generator =
-	    make_uniq<SapDefaultGenerator>(*catalog, schema, std::move(secret_name), std::move(allowed_tables));
+	auto default_generator = make_uniq<SapDefaultGenerator>(*catalog, schema, std::move(secret_name),
+	                                                        std::move(allowed_tables), std::move(warmup));
 	catalog_set.SetDefaultGenerator(std::move(default_generator));
 
 	return std::move(catalog);
@@ -8,12 +8,22 @@
 namespace duckdb {
 
 SapTableEntry::SapTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info,
-                             string sap_table_name_p, string secret_name_p)
+                             string sap_table_name_p, string secret_name_p, vector<Value> field_metas_p,
+                             std::shared_ptr<SapReplica> replica_p)
     : TableCatalogEntry(catalog, schema, info), sap_table_name(std::move(sap_table_name_p)),
-      secret_name(std::move(secret_name_p)) {
+      secret_name(std::move(secret_name_p)), field_metas(std::move(field_metas_p)), replica(std::move(replica_p)) {
 }
 
 TableFunction SapTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
+	// A loaded replica is served as a plain DuckDB table scan, with its
+	// own filter pushdown and statistics; no RFC call is made.
+	if (replica) {
+		auto local = replica->TryGetTable(context, sap_table_name, GetColumns());
+		if (local) {
+			return local->GetScanFunction(context, bind_data);
+		}
+	}
+
 	auto fn = CreateRfcReadTableScanFunction();
 
 	// We deliberately bind with limit=0 even when the wrapping SQL has a
@@ -34,7 +44,8 @@ TableFunction SapTableEntry::GetScanFunction(ClientContext &context, unique_ptr<
 	}
 	// Discover all fields — the catalog entry's ColumnList was populated at
 	// creation, so this must agree on the projected return types and order.
-	data->InitAndVerifyFields({});
+	// Re-using the DDIC rows the entry was built from guarantees that.
+	data->InitAndVerifyFields({}, field_metas);
 
 	bind_data = std::move(data);
 	return fn;
@@ -0,0 +1,232 @@
+#include <atomic>
+#include <sstream>
+
+#include "duckdb/common/file_system.hpp"
+
+#include "sap_trace_spans.hpp"
+#include "erpl_tracing.hpp"
+
+namespace duckdb
+{
+    static std::mutex g_rfc_trace_spans_lock;
+    static std::string g_rfc_trace_spans_directory;
+    // Read on every scan start; the directory itself only under the lock.
+    static std::atomic<bool> g_rfc_trace_spans_enabled{false};
+
+    void SetRfcTraceSpansDirectory(const std::string &directory)
+    {
+        std::lock_guard<std::mutex> guard(g_rfc_trace_spans_lock);
+        g_rfc_trace_spans_directory = directory;
+        g_rfc_trace_spans_enabled.store(!directory.empty(), std::memory_order_relaxed);
+    }
+
+    std::string GetRfcTraceSpansDirectory()
+    {
+        std::lock_guard<std::mutex> guard(g_rfc_trace_spans_lock);
+        return g_rfc_trace_spans_directory;
+    }
+
+    static std::string JsonEscape(const std::string &value)
+    {
+        std::string result;
+        result.reserve(value.size());
+        for (auto c : value) {
+            switch (c) {
+                case '"': result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n"; break;
+                case '\r': result += "\\r"; break;
+                case '\t': result += "\\t"; break;
+                default:
+                    if ((unsigned char)c < 0x20) {
+                        result += StringUtil::Format("\\u%04x", (int)c);
+                    } else {
+                        result += c;
+                    }
+            }
+        }
+        return result;
+    }
+
+    // RfcSpanBuffer -------------------------------------------------------------
+
+    RfcSpanBuffer::RfcSpanBuffer()
+        : origin(std::chrono::steady_clock::now()), wall_origin(std::chrono::system_clock::now())
+    { }
+
+    std::shared_ptr<RfcSpanBuffer> RfcSpanBuffer::ForQuery(ClientContext &context)
+    {
+        if (!g_rfc_trace_spans_enabled.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        auto state = context.registered_state->GetOrCreate<RfcSpanState>("erpl_rfc_spans");
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (!state->buffer) {
+            state->buffer = std::make_shared<RfcSpanBuffer>();
+        }
+        return state->buffer;
+    }
+
+    idx_t RfcSpanBuffer::NextScanId()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return next_scan_id++;
+    }
+
+    void RfcSpanBuffer::Add(RfcSpan span)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (spans.size() >= MAX_SPANS) {
+            dropped++;
+            return;
+        }
+        spans.push_back(std::move(span));
+    }
+
+    idx_t RfcSpanBuffer::Size()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return spans.size();
+    }
+
+    idx_t RfcSpanBuffer::Dropped()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return dropped;
+    }
+
+    std::string RfcSpanBuffer::ToChromeTraceJson()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto micros = [&](std::chrono::steady_clock::time_point t) {
+            return (long long)std::chrono::duration_cast<std::chrono::microseconds>(t - origin).count();
+        };
+
+        // Chrome wants small integer thread ids; number them in order of
+        // appearance and name the tracks after them.
+        std::unordered_map<std::thread::id, idx_t> thread_ids;
+        std::stringstream events;
+        for (auto &span : spans) {
+            auto inserted = thread_ids.emplace(span.thread, thread_ids.size() + 1);
+            auto tid = inserted.first->second;
+            if (inserted.second) {
+                events << StringUtil::Format("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,"
+                                             "\"args\":{\"name\":\"thread %llu\"}},\n", tid, tid);
+            }
+            events << StringUtil::Format("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,"
+                                         "\"pid\":1,\"tid\":%llu,\"args\":{\"scan\":%llu",
+                                         span.name, span.category, micros(span.start),
+                                         micros(span.end) - micros(span.start), tid, span.scan_id);
+            if (!span.column.empty()) {
+                events << ",\"column\":\"" << JsonEscape(span.column) << "\"";
+            }
+            if (!span.detail.empty()) {
+                events << ",\"detail\":\"" << JsonEscape(span.detail) << "\"";
+            }
+            events << "}},\n";
+        }
+
+        auto json = events.str();
+        if (!json.empty()) {
+            json.resize(json.size() - 2);
+        }
+        auto start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(wall_origin.time_since_epoch()).count();
+        return StringUtil::Format("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"start_epoch_ms\":%lld,"
+                                  "\"dropped_spans\":%llu},\"traceEvents\":[\n%s\n]}\n",
+                                  (long long)start_ms, dropped, json);
+    }
+
+    std::string RfcSpanBuffer::WriteTo(FileSystem &fs, const std::string &directory)
+    {
+        static std::atomic<idx_t> file_counter{0};
+        auto start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(wall_origin.time_since_epoch()).count();
+
+        if (!fs.DirectoryExists(directory)) {
+            fs.CreateDirectory(directory);
+        }
+        auto path = fs.JoinPath(directory, StringUtil::Format("erpl_rfc_spans_%lld_%llu.json", (long long)start_ms,
+                                                              file_counter++));
+        auto json = ToChromeTraceJson();
+        auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+        handle->Write((void *)json.data(), json.size());
+        handle->Close();
+        return path;
+    }
+
+    // RfcSpanContext ------------------------------------------------------------
+
+    static thread_local RfcSpanContext *t_span_context = nullptr;
+
+    RfcSpanContext::RfcSpanContext(RfcSpanBuffer *buffer, idx_t scan_id, std::string column)
+        : buffer(buffer), scan_id(scan_id), column(std::move(column)), previous(t_span_context)
+    {
+        if (buffer) {
+            t_span_context = this;
+        }
+    }
+
+    RfcSpanContext::~RfcSpanContext()
+    {
+        if (buffer) {
+            t_span_context = previous;
+        }
+    }
+
+    RfcSpanContext *RfcSpanContext::Current()
+    {
+        return t_span_context;
+    }
+
+    // RfcTraceSpan --------------------------------------------------------------
+
+    RfcTraceSpan::RfcTraceSpan(const char *name, const char *category)
+        : context(t_span_context), name(name), category(category)
+    {
+        if (context) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    RfcTraceSpan::RfcTraceSpan(const char *name, const char *category, const std::string &detail)
+        : RfcTraceSpan(name, category)
+    {
+        if (context) {
+            this->detail = detail;
+        }
+    }
+
+    RfcTraceSpan::~RfcTraceSpan()
+    {
+        if (!context) {
+            return;
+        }
+        context->buffer->Add(RfcSpan { name, category, start, std::chrono::steady_clock::now(),
+                                       std::this_thread::get_id(), context->scan_id, context->column, detail });
+    }
+
+    // RfcSpanState --------------------------------------------------------------
+
+    void RfcSpanState::QueryEnd(ClientContext &context)
+    {
+        std::shared_ptr<RfcSpanBuffer> finished;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            finished = std::move(buffer);
+        }
+        auto directory = GetRfcTraceSpansDirectory();
+        if (!finished || finished->Size() == 0 || directory.empty()) {
+            return;
+        }
+        try {
+            // Through the query's file system, so enable_external_access and
+            // allowed_directories apply.
+            auto path = finished->WriteTo(FileSystem::GetFileSystem(context), directory);
+            ERPL_TRACE_DEBUG("sap_trace_spans", StringUtil::Format("Wrote %llu spans (%llu dropped) to %s",
+                                                                   finished->Size(), finished->Dropped(), path));
+        } catch (std::exception &ex) {
+            // The query itself is done; a trace that cannot be written must
+            // not turn it into a failure.
+            ERPL_TRACE_WARN_DATA("sap_trace_spans", "Could not write the span trace", ex.what());
+        }
+    }
+} // namespace duckdb
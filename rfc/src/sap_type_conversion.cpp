@@ -788,11 +788,7 @@ namespace duckdb
      */
     void duck2rfc(Value &value, RFC_DATE &rfc_date) 
     {
-        int32_t year, month, day;
-        Date::Convert(value.GetValue<date_t>(), year, month, day);
-
-        auto uc_date = std2uc(StringUtil::Format("%04d%02d%02d", year, month, day));
-        memcpy((char *)rfc_date, (char *)uc_date.get(), SAP_DATE_LN * 2);
+        duck2rfc(value.GetValue<date_t>(), rfc_date);
     }
 
     /**
@@ -806,12 +802,50 @@ namespace duckdb
      * @note The DuckDB TIME value is stored in the format HH:MM:SS:MS.
      */
     void duck2rfc(Value &value, RFC_TIME &rfc_time) 
+    {
+        duck2rfc(value.GetValue<dtime_t>(), rfc_time);
+    }
+
+    static void put_digits(SAP_UC *dst, unsigned int width, int32_t value)
+    {
+        for (unsigned int i = width; i > 0; i--) {
+            dst[i - 1] = (SAP_UC)('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    void duck2rfc(date_t date, RFC_DATE &rfc_date)
+    {
+        int32_t year, month, day;
+        Date::Convert(date, year, month, day);
+        put_digits(rfc_date, 4, year);
+        put_digits(rfc_date + 4, 2, month);
+        put_digits(rfc_date + 6, 2, day);
+    }
+
+    void duck2rfc(dtime_t time, RFC_TIME &rfc_time)
     {
         int32_t hour, minute, second, ms;
-        Time::Convert(value.GetValue<dtime_t>(), hour, minute, second, ms);
+        Time::Convert(time, hour, minute, second, ms);
+        put_digits(rfc_time, 2, hour);
+        put_digits(rfc_time + 2, 2, minute);
+        put_digits(rfc_time + 4, 2, second);
+    }
 
-        auto uc_time = std2uc(StringUtil::Format("%02d%02d%02d", hour, minute, second));
-        memcpy((char *)rfc_time, (char *)uc_time.get(), SAP_TIME_LN * 2);
+    unsigned int utf82uc(const char *utf8, idx_t utf8_len, std::vector<SAP_UC> &buffer)
+    {
+        // One SAP_UC per UTF-8 byte is always enough, plus the terminator.
+        if (buffer.size() < utf8_len + 1) {
+            buffer.resize(utf8_len + 1);
+        }
+        unsigned int buffer_size = buffer.size();
+        unsigned int result_len = 0;
+        RFC_ERROR_INFO error_info;
+        auto rc = RfcUTF8ToSAPUC((RFC_BYTE *)utf8, utf8_len, buffer.data(), &buffer_size, &result_len, &error_info);
+        if (rc != RFC_OK) {
+            throw std::runtime_error("Error converting string to SAP_UC");
+        }
+        return result_len;
     }
 
     /**
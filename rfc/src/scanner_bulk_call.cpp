@@ -0,0 +1,673 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
+#include "duckdb.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+
+#include "scanner_bulk_call.hpp"
+#include "sap_secret.hpp"
+#include "sap_metadata_cache.hpp"
+#include "sap_trace_spans.hpp"
+#include "erpl_tracing.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    static constexpr idx_t MAX_BULK_CALL_THREADS = 64;
+    static constexpr idx_t DEFAULT_BULK_CALL_THREADS = 4;
+    static constexpr idx_t DEFAULT_BULK_CALL_BATCH_SIZE = 1000;
+    static const char *BAPI_COMMIT_FUNCTION = "BAPI_TRANSACTION_COMMIT";
+    static const char *BAPI_ROLLBACK_FUNCTION = "BAPI_TRANSACTION_ROLLBACK";
+
+    struct RfcBulkCallBindData : public TableFunctionData
+    {
+        RfcAuthParams auth_params;
+        std::string func_name;
+        // Empty: one call per input row, columns are import parameters.
+        // Set: up to `batch_size` rows per call, appended to this table.
+        std::string table_param;
+        idx_t batch_size = 1;
+        // Extra arguments for every call, as the single STRUCT sap_rfc_invoke takes.
+        std::vector<Value> func_args;
+        // End the LUW after this many calls on a connection; 0 never commits,
+        // every connection's calls are rolled back at the end.
+        idx_t commit_every = 1;
+        idx_t threads = DEFAULT_BULK_CALL_THREADS;
+        std::string return_param = "RETURN";
+        std::vector<std::string> input_names;
+        std::vector<LogicalType> input_types;
+    };
+
+    /**
+     * @brief Binds `sap_rfc_bulk_call(function_name, (subquery), ...)`.
+     *
+     * Validates the input columns, the RETURN parameter and the commit and
+     * rollback BAPIs against the descriptors; no call is made.  The output is fixed: one
+     * row per RETURN message, per call or commit.
+    */
+    static unique_ptr<FunctionData> RfcBulkCallBind(ClientContext &context,
+                                                    TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types,
+                                                    vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_bulk_call");
+
+        auto &named_params = input.named_parameters;
+        auto bind_data = make_uniq<RfcBulkCallBindData>();
+        bind_data->auth_params = GetAuthParamsFromContext(context, input);
+        bind_data->func_name = input.inputs[0].GetValue<string>();
+        bind_data->input_names = std::vector<std::string>(input.input_table_names.begin(), input.input_table_names.end());
+        bind_data->input_types = std::vector<LogicalType>(input.input_table_types.begin(), input.input_table_types.end());
+
+        if (named_params.find("parameter") != named_params.end()) {
+            bind_data->table_param = StringUtil::Upper(named_params["parameter"].GetValue<string>());
+            bind_data->batch_size = DEFAULT_BULK_CALL_BATCH_SIZE;
+        }
+        if (named_params.find("batch_size") != named_params.end()) {
+            if (bind_data->table_param.empty()) {
+                throw std::runtime_error("sap_rfc_bulk_call: batch_size requires parameter := '<table parameter>'");
+            }
+            bind_data->batch_size = std::max<idx_t>(1, named_params["batch_size"].GetValue<uint32_t>());
+        }
+        if (named_params.find("arguments") != named_params.end()) {
+            auto &arguments = named_params["arguments"];
+            if (arguments.type().id() != LogicalTypeId::STRUCT) {
+                throw std::runtime_error("sap_rfc_bulk_call expects arguments := {...} as a STRUCT");
+            }
+            bind_data->func_args.push_back(arguments);
+        }
+        if (named_params.find("commit_every") != named_params.end()) {
+            bind_data->commit_every = named_params["commit_every"].GetValue<uint32_t>();
+        }
+        if (named_params.find("threads") != named_params.end()) {
+            auto threads = named_params["threads"].GetValue<uint32_t>();
+            bind_data->threads = std::max<idx_t>(1, std::min<idx_t>(threads, MAX_BULK_CALL_THREADS));
+        }
+        if (named_params.find("return_parameter") != named_params.end()) {
+            bind_data->return_param = StringUtil::Upper(named_params["return_parameter"].GetValue<string>());
+        }
+
+        auto connection = bind_data->auth_params.Connect();
+        {
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data->func_name);
+            auto result_names = func->GetResultNames();
+            if (std::find(result_names.begin(), result_names.end(), bind_data->return_param) == result_names.end()) {
+                throw std::runtime_error(StringUtil::Format("'%s' has no result parameter '%s'; set return_parameter",
+                                                            bind_data->func_name, bind_data->return_param));
+            }
+
+            if (!bind_data->table_param.empty()) {
+                auto param = func->GetParameterInfo(bind_data->table_param);
+                if (param.GetDirection() != RFC_TABLES && param.GetDirection() != RFC_CHANGING) {
+                    throw std::runtime_error(StringUtil::Format("Parameter '%s' of '%s' is %s; only TABLES and CHANGING tables take a relation",
+                                                                bind_data->table_param, bind_data->func_name,
+                                                                param.GetDirectionAsString()));
+                }
+                RfcTableAppender column_check(param.GetRfcType(), bind_data->table_param,
+                                              bind_data->input_names, bind_data->input_types);
+            } else {
+                auto settable = std::set<std::string>();
+                for (auto &param : func->GetParameterInfos()) {
+                    if (param.GetDirection() != RFC_EXPORT) {
+                        settable.insert(param.GetName());
+                    }
+                }
+                for (auto &column_name : bind_data->input_names) {
+                    if (settable.find(StringUtil::Upper(column_name)) == settable.end()) {
+                        throw std::runtime_error(StringUtil::Format(
+                            "Input column '%s' does not match an import, changing or tables parameter of '%s'",
+                            column_name, bind_data->func_name));
+                    }
+                }
+            }
+
+            if (bind_data->commit_every > 0) {
+                RfcMetadataCache::Get().GetFunction(connection, BAPI_COMMIT_FUNCTION);
+            }
+            RfcMetadataCache::Get().GetFunction(connection, BAPI_ROLLBACK_FUNCTION);
+        }
+        RfcConnectionPool::Get().Release(std::move(connection));
+
+        names = { "call_id", "luw_id", "first_row_id", "row_count", "source", "type", "id", "number", "message" };
+        return_types = { LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT,
+                         LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                         LogicalType::VARCHAR };
+
+        return std::move(bind_data);
+    }
+
+    // One logon used for several calls in a row.  The commit BAPI commits
+    // the LUW of the session it runs in, so a session's calls and its
+    // commits must share a connection; that is why sessions, not single
+    // calls, are handed out.
+    struct RfcBulkCallSession
+    {
+        std::shared_ptr<RfcConnection> connection;
+        idx_t uncommitted_calls = 0;
+        // Number of the open LUW, taken by its first call; ties the calls to
+        // the COMMIT or ROLLBACK that ended them.
+        idx_t luw_id = 0;
+        // A call of the open LUW returned an E or A message.
+        bool luw_failed = false;
+        bool busy = false;
+    };
+
+    static Value InvokeAndGetReturn(RfcInvocation &invocation, const std::string &return_param)
+    {
+        invocation.DeactivateResultsExcept({ return_param });
+        auto result_set = invocation.Invoke();
+        return result_set->GetResultValue("/" + return_param);
+    }
+
+    static Value RollbackLuw(const std::shared_ptr<RfcConnection> &connection)
+    {
+        auto func = RfcMetadataCache::Get().GetFunction(connection, BAPI_ROLLBACK_FUNCTION);
+        auto invocation = func->BeginInvocation();
+        return InvokeAndGetReturn(*invocation, "RETURN");
+    }
+
+    // Rolls back the session's open LUW, ignoring errors, and tells whether
+    // its connection is clean enough to go back to the pool.
+    static bool TryRollbackLuw(RfcBulkCallSession &session)
+    {
+        if (!session.connection) {
+            return false;
+        }
+        try {
+            RollbackLuw(session.connection);
+            session.uncommitted_calls = 0;
+            session.luw_failed = false;
+            return true;
+        } catch (std::exception &ex) {
+            ERPL_TRACE_WARN("sap_rfc_bulk_call", StringUtil::Format("BAPI_TRANSACTION_ROLLBACK failed: %s", ex.what()));
+            return false;
+        }
+    }
+
+    /**
+     * Statement-wide state: `threads` sessions shared by all pipeline
+     * threads, and the final commit.  The final commit is made by the thread
+     * that finalizes last among those that had started (the same rule as
+     * sap_rfc_invoke_table); by then every call has returned.
+     */
+    struct RfcBulkCallGlobalState : public GlobalTableFunctionState
+    {
+        explicit RfcBulkCallGlobalState(idx_t threads) : sessions(threads) {}
+
+        std::atomic<idx_t> next_row_id{0};
+        std::atomic<idx_t> next_call_id{0};
+        std::atomic<idx_t> next_luw_id{0};
+        // Where the calls' spans go; null when span recording is off.
+        std::shared_ptr<RfcSpanBuffer> spans;
+        idx_t span_scan_id = 0;
+
+        std::mutex lock;
+        std::condition_variable session_free;
+        std::vector<RfcBulkCallSession> sessions;
+        idx_t active_threads = 0;
+        bool finalized = false;
+
+        RfcBulkCallSession &AcquireSession()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (true) {
+                for (auto &session : sessions) {
+                    if (!session.busy) {
+                        session.busy = true;
+                        return session;
+                    }
+                }
+                session_free.wait(guard);
+            }
+        }
+
+        void ReleaseSession(RfcBulkCallSession &session)
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                session.busy = false;
+            }
+            session_free.notify_one();
+        }
+
+        ~RfcBulkCallGlobalState() override
+        {
+            // A session with uncommitted calls belongs to a failed or
+            // interrupted statement (RfcBulkCallFinal ends all others): roll
+            // its LUW back before the connection is pooled.  If that fails,
+            // closing it lets the server roll back.
+            for (auto &session : sessions) {
+                if (!session.connection) {
+                    continue;
+                }
+                if (session.uncommitted_calls == 0 || TryRollbackLuw(session)) {
+                    RfcConnectionPool::Get().Release(std::move(session.connection));
+                } else {
+                    session.connection.reset();
+                }
+            }
+        }
+    };
+
+    // Rows destined for one call.
+    struct RfcBulkCallBatch
+    {
+        std::vector<unique_ptr<DataChunk>> chunks;
+        idx_t row_count = 0;
+        idx_t first_row_id = 0;
+    };
+
+    struct RfcBulkCallLocalState : public LocalTableFunctionState
+    {
+        RfcBulkCallBatch open_batch;
+        std::vector<RfcBulkCallBatch> ready_batches;
+        std::vector<std::vector<Value>> pending_rows;
+        idx_t emitted = 0;
+        bool input_processed = false;
+        bool final_dispatched = false;
+    };
+
+    static unique_ptr<GlobalTableFunctionState> RfcBulkCallInitGlobalState(ClientContext &context,
+                                                                           TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->Cast<RfcBulkCallBindData>();
+        auto global_state = make_uniq<RfcBulkCallGlobalState>(bind_data.threads);
+        global_state->spans = RfcSpanBuffer::ForQuery(context);
+        global_state->span_scan_id = global_state->spans ? global_state->spans->NextScanId() : 0;
+        return std::move(global_state);
+    }
+
+    static unique_ptr<LocalTableFunctionState> RfcBulkCallInitLocalState(ExecutionContext &context,
+                                                                         TableFunctionInitInput &input,
+                                                                         GlobalTableFunctionState *global_state)
+    {
+        auto &gstate = global_state->Cast<RfcBulkCallGlobalState>();
+        std::lock_guard<std::mutex> guard(gstate.lock);
+        gstate.active_threads++;
+        return make_uniq<RfcBulkCallLocalState>();
+    }
+
+    static Value GetStructField(const Value &struct_value, const std::string &name)
+    {
+        auto &child_types = StructType::GetChildTypes(struct_value.type());
+        auto &children = StructValue::GetChildren(struct_value);
+        for (idx_t i = 0; i < child_types.size(); i++) {
+            if (child_types[i].first == name) {
+                if (children[i].IsNull()) {
+                    return Value();
+                }
+                auto str = children[i].ToString();
+                StringUtil::Trim(str);
+                return str.empty() ? Value() : Value(str);
+            }
+        }
+        return Value();
+    }
+
+    /**
+     * @brief Turns a RETURN parameter (BAPIRET2/BAPIRET1/BAPIRETURN structure
+     *        or table) into output rows.  A call without messages still gets
+     *        one row, so every call is accounted for.
+     * @return Whether a message has type E or A.
+    */
+    static bool AppendReturnRows(const Value &return_value, const Value &call_id, idx_t luw_id,
+                                 const Value &first_row_id, idx_t row_count, const std::string &source,
+                                 std::vector<std::vector<Value>> &rows)
+    {
+        std::vector<Value> messages;
+        if (!return_value.IsNull() && return_value.type().id() == LogicalTypeId::LIST) {
+            messages = ListValue::GetChildren(return_value);
+        } else if (!return_value.IsNull() && return_value.type().id() == LogicalTypeId::STRUCT) {
+            messages.push_back(return_value);
+        }
+
+        auto prefix = std::vector<Value> { call_id, Value::BIGINT(luw_id), first_row_id, Value::BIGINT(row_count),
+                                           Value(source) };
+        auto any = false;
+        auto has_error = false;
+        for (auto &message : messages) {
+            if (message.type().id() != LogicalTypeId::STRUCT) {
+                continue;
+            }
+            auto type = GetStructField(message, "TYPE");
+            auto text = GetStructField(message, "MESSAGE");
+            // An initial RETURN structure means "no message".
+            if (type.IsNull() && text.IsNull()) {
+                continue;
+            }
+            // BAPIRETURN has a combined CODE instead of ID / NUMBER.
+            auto id = GetStructField(message, "ID");
+            if (id.IsNull()) {
+                id = GetStructField(message, "CODE");
+            }
+            auto row = prefix;
+            row.push_back(type);
+            row.push_back(id);
+            row.push_back(GetStructField(message, "NUMBER"));
+            row.push_back(text);
+            if (!type.IsNull() && (type.ToString() == "E" || type.ToString() == "A")) {
+                has_error = true;
+            }
+            rows.push_back(std::move(row));
+            any = true;
+        }
+        if (!any) {
+            auto row = prefix;
+            row.insert(row.end(), 4, Value(LogicalType::VARCHAR));
+            rows.push_back(std::move(row));
+        }
+        return has_error;
+    }
+
+    /**
+     * @brief Ends the session's LUW: BAPI_TRANSACTION_COMMIT if all its calls
+     *        succeeded, BAPI_TRANSACTION_ROLLBACK if one returned an E or A
+     *        message, so a failed call never has its partial work committed.
+     *        Without `commit`, always rolls back.
+    */
+    static void EndLuw(RfcBulkCallSession &session, bool commit, std::vector<std::vector<Value>> &rows)
+    {
+        Value return_value;
+        std::string source;
+        if (session.luw_failed || !commit) {
+            return_value = RollbackLuw(session.connection);
+            source = "ROLLBACK";
+        } else {
+            auto func = RfcMetadataCache::Get().GetFunction(session.connection, BAPI_COMMIT_FUNCTION);
+            child_list_t<Value> wait;
+            wait.emplace_back("WAIT", Value("X"));
+            auto args = std::vector<Value> { Value::STRUCT(std::move(wait)) };
+            auto invocation = func->BeginInvocation(args);
+            return_value = InvokeAndGetReturn(*invocation, "RETURN");
+            source = "COMMIT";
+        }
+        AppendReturnRows(return_value, Value(LogicalType::BIGINT), session.luw_id, Value(LogicalType::BIGINT),
+                         session.uncommitted_calls, source, rows);
+        session.uncommitted_calls = 0;
+        session.luw_failed = false;
+    }
+
+    static void RunBatch(const RfcBulkCallBindData &bind_data, RfcBulkCallGlobalState &global_state,
+                         RfcBulkCallSession &session, RfcBulkCallBatch &batch,
+                         std::vector<std::vector<Value>> &rows)
+    {
+        if (!session.connection) {
+            auto auth_params = bind_data.auth_params;
+            session.connection = auth_params.Connect();
+        }
+
+        auto func = RfcMetadataCache::Get().GetFunction(session.connection, bind_data.func_name);
+        std::shared_ptr<RfcInvocation> invocation;
+        if (bind_data.table_param.empty()) {
+            // Per-row mode: the single row's columns and the extra arguments
+            // go through the named adapter as one STRUCT.
+            child_list_t<Value> params;
+            if (!bind_data.func_args.empty()) {
+                auto &arg_types = StructType::GetChildTypes(bind_data.func_args[0].type());
+                auto &arg_values = StructValue::GetChildren(bind_data.func_args[0]);
+                for (idx_t i = 0; i < arg_types.size(); i++) {
+                    params.emplace_back(arg_types[i].first, arg_values[i]);
+                }
+            }
+            auto &chunk = *batch.chunks[0];
+            for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+                params.emplace_back(StringUtil::Upper(bind_data.input_names[col_idx]), chunk.GetValue(col_idx, 0));
+            }
+            auto args = std::vector<Value> { Value::STRUCT(std::move(params)) };
+            invocation = func->BeginInvocation(args);
+        } else {
+            auto args = bind_data.func_args;
+            invocation = args.empty() ? func->BeginInvocation() : func->BeginInvocation(args);
+            auto param = func->GetParameterInfo(bind_data.table_param);
+            RfcTableAppender appender(param.GetRfcType(), bind_data.table_param,
+                                      bind_data.input_names, bind_data.input_types);
+            auto table_handle = invocation->GetTableParameter(bind_data.table_param);
+            for (auto &chunk : batch.chunks) {
+                appender.Append(table_handle, *chunk);
+            }
+        }
+
+        auto call_id = Value::BIGINT(global_state.next_call_id.fetch_add(1));
+        if (session.uncommitted_calls == 0) {
+            session.luw_id = global_state.next_luw_id.fetch_add(1);
+        }
+        auto return_value = InvokeAndGetReturn(*invocation, bind_data.return_param);
+        session.uncommitted_calls++;
+        if (AppendReturnRows(return_value, call_id, session.luw_id, Value::BIGINT(batch.first_row_id),
+                             batch.row_count, "CALL", rows)) {
+            session.luw_failed = true;
+        }
+
+        if (bind_data.commit_every > 0 && session.uncommitted_calls >= bind_data.commit_every) {
+            EndLuw(session, true, rows);
+        }
+    }
+
+    // The batches of one input chunk: those still to call and the rows of
+    // those called, shared by the tasks working on the chunk.
+    struct RfcBulkCallChunkBatches
+    {
+        RfcBulkCallChunkBatches(ClientContext &context, TaskExecutor &executor, const RfcBulkCallBindData &bind_data,
+                                RfcBulkCallGlobalState &global_state, std::vector<RfcBulkCallBatch> &batches)
+            : context(context), executor(executor), bind_data(bind_data), global_state(global_state),
+              batches(batches), results(batches.size())
+        { }
+
+        void Work()
+        {
+            RfcSpanContext span_context(global_state.spans.get(), global_state.span_scan_id, std::string());
+            while (!executor.HasError() && !context.interrupted) {
+                auto batch_idx = next_batch.fetch_add(1);
+                if (batch_idx >= batches.size()) {
+                    return;
+                }
+                auto &session = global_state.AcquireSession();
+                try {
+                    RunBatch(bind_data, global_state, session, batches[batch_idx], results[batch_idx]);
+                } catch (std::exception &ex) {
+                    // The session's LUW is in an unknown state: roll it back
+                    // and drop the connection, whose close rolls back anything
+                    // the rollback could not reach.
+                    TryRollbackLuw(session);
+                    session.connection.reset();
+                    session.uncommitted_calls = 0;
+                    session.luw_failed = false;
+                    global_state.ReleaseSession(session);
+                    throw std::runtime_error(StringUtil::Format("Call of '%s' for input rows from %llu failed: %s",
+                                                                bind_data.func_name, batches[batch_idx].first_row_id,
+                                                                ex.what()));
+                }
+                global_state.ReleaseSession(session);
+            }
+        }
+
+        ClientContext &context;
+        TaskExecutor &executor;
+        const RfcBulkCallBindData &bind_data;
+        RfcBulkCallGlobalState &global_state;
+        std::vector<RfcBulkCallBatch> &batches;
+
+        std::vector<std::vector<std::vector<Value>>> results;
+        std::atomic<idx_t> next_batch{0};
+    };
+
+    class RfcBulkCallTask : public BaseExecutorTask
+    {
+        public:
+            RfcBulkCallTask(TaskExecutor &executor, RfcBulkCallChunkBatches &calls)
+                : BaseExecutorTask(executor), calls(calls)
+            { }
+
+            void ExecuteTask() override
+            {
+                calls.Work();
+            }
+
+        private:
+            RfcBulkCallChunkBatches &calls;
+    };
+
+    /**
+     * @brief Runs the batches on up to `threads` sessions at once and appends
+     *        their RETURN rows to the local output queue in batch order.  The
+     *        calls run as tasks on DuckDB's scheduler; the first failure
+     *        stops the others and is rethrown here.
+    */
+    static void DispatchBatches(ClientContext &context, const RfcBulkCallBindData &bind_data,
+                                RfcBulkCallGlobalState &global_state, RfcBulkCallLocalState &local_state,
+                                std::vector<RfcBulkCallBatch> &batches)
+    {
+        if (batches.empty()) {
+            return;
+        }
+
+        TaskExecutor executor(TaskScheduler::GetScheduler(context));
+        RfcBulkCallChunkBatches calls(context, executor, bind_data, global_state, batches);
+        auto n_tasks = std::min<idx_t>(bind_data.threads, batches.size());
+        for (idx_t i = 0; i < n_tasks; i++) {
+            executor.ScheduleTask(make_uniq<RfcBulkCallTask>(executor, calls));
+        }
+        executor.WorkOnTasks();
+        batches.clear();
+
+        if (context.interrupted) {
+            throw InterruptException();
+        }
+
+        for (auto &batch_rows : calls.results) {
+            for (auto &row : batch_rows) {
+                local_state.pending_rows.push_back(std::move(row));
+            }
+        }
+    }
+
+    // Splits `input` into the open batch, moving every full batch to
+    // `ready_batches`.
+    static void BufferInput(const RfcBulkCallBindData &bind_data, RfcBulkCallGlobalState &global_state,
+                            RfcBulkCallLocalState &local_state, DataChunk &input)
+    {
+        auto first_row_id = global_state.next_row_id.fetch_add(input.size());
+        idx_t offset = 0;
+        while (offset < input.size()) {
+            auto &batch = local_state.open_batch;
+            if (batch.row_count == 0) {
+                batch.first_row_id = first_row_id + offset;
+            }
+            auto take = std::min<idx_t>(input.size() - offset, bind_data.batch_size - batch.row_count);
+
+            SelectionVector sel(take);
+            for (idx_t i = 0; i < take; i++) {
+                sel.set_index(i, offset + i);
+            }
+            auto chunk = make_uniq<DataChunk>();
+            chunk->Initialize(Allocator::DefaultAllocator(), input.GetTypes(), take);
+            input.Copy(*chunk, sel, take);
+            batch.chunks.push_back(std::move(chunk));
+            batch.row_count += take;
+            offset += take;
+
+            if (batch.row_count == bind_data.batch_size) {
+                local_state.ready_batches.push_back(std::move(batch));
+                local_state.open_batch = RfcBulkCallBatch();
+            }
+        }
+    }
+
+    static idx_t EmitPending(RfcBulkCallLocalState &local_state, DataChunk &output)
+    {
+        idx_t out_idx = 0;
+        while (local_state.emitted < local_state.pending_rows.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &row = local_state.pending_rows[local_state.emitted++];
+            for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, out_idx, row[col_idx]);
+            }
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+        if (local_state.emitted < local_state.pending_rows.size()) {
+            return out_idx;
+        }
+        local_state.pending_rows.clear();
+        local_state.emitted = 0;
+        return out_idx;
+    }
+
+    static OperatorResultType RfcBulkCallFunction(ExecutionContext &context,
+                                                  TableFunctionInput &data,
+                                                  DataChunk &input,
+                                                  DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<RfcBulkCallBindData>();
+        auto &global_state = data.global_state->Cast<RfcBulkCallGlobalState>();
+        auto &local_state = data.local_state->Cast<RfcBulkCallLocalState>();
+
+        if (!local_state.input_processed) {
+            BufferInput(bind_data, global_state, local_state, input);
+            DispatchBatches(context.client, bind_data, global_state, local_state, local_state.ready_batches);
+            local_state.input_processed = true;
+        }
+
+        EmitPending(local_state, output);
+        if (!local_state.pending_rows.empty()) {
+            return OperatorResultType::HAVE_MORE_OUTPUT;
+        }
+        local_state.input_processed = false;
+        return OperatorResultType::NEED_MORE_INPUT;
+    }
+
+    static OperatorFinalizeResultType RfcBulkCallFinal(ExecutionContext &context,
+                                                       TableFunctionInput &data,
+                                                       DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<RfcBulkCallBindData>();
+        auto &global_state = data.global_state->Cast<RfcBulkCallGlobalState>();
+        auto &local_state = data.local_state->Cast<RfcBulkCallLocalState>();
+
+        if (!local_state.final_dispatched) {
+            local_state.final_dispatched = true;
+            if (local_state.open_batch.row_count > 0) {
+                local_state.ready_batches.push_back(std::move(local_state.open_batch));
+                local_state.open_batch = RfcBulkCallBatch();
+            }
+            DispatchBatches(context.client, bind_data, global_state, local_state, local_state.ready_batches);
+
+            std::lock_guard<std::mutex> guard(global_state.lock);
+            global_state.active_threads--;
+            if (global_state.active_threads == 0 && !global_state.finalized) {
+                global_state.finalized = true;
+                RfcSpanContext span_context(global_state.spans.get(), global_state.span_scan_id, std::string());
+                // With commit_every = 0 the open LUWs are rolled back here,
+                // where their ROLLBACK rows can still be returned.
+                for (auto &session : global_state.sessions) {
+                    if (session.connection && session.uncommitted_calls > 0) {
+                        EndLuw(session, bind_data.commit_every > 0, local_state.pending_rows);
+                    }
+                }
+            }
+        }
+
+        EmitPending(local_state, output);
+        return local_state.pending_rows.empty() ? OperatorFinalizeResultType::FINISHED
+                                                : OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+    }
+
+    TableFunction CreateRfcBulkCallScanFunction()
+    {
+        auto fun = TableFunction("sap_rfc_bulk_call", { LogicalType::VARCHAR, LogicalType::TABLE }, nullptr,
+                                 RfcBulkCallBind, RfcBulkCallInitGlobalState, RfcBulkCallInitLocalState);
+        fun.in_out_function = RfcBulkCallFunction;
+        fun.in_out_function_final = RfcBulkCallFinal;
+        fun.named_parameters["parameter"] = LogicalType::VARCHAR;
+        fun.named_parameters["batch_size"] = LogicalType::UINTEGER;
+        fun.named_parameters["arguments"] = LogicalType::ANY;
+        fun.named_parameters["commit_every"] = LogicalType::UINTEGER;
+        fun.named_parameters["threads"] = LogicalType::UINTEGER;
+        fun.named_parameters["return_parameter"] = LogicalType::VARCHAR;
+        fun.named_parameters["secret"] = LogicalType::VARCHAR;
+
+        return fun;
+    }
+} // namespace duckdb
@@ -0,0 +1,518 @@
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/connection.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <set>
+#include <thread>
+
+#include "scanner_extract.hpp"
+#include "duckdb_argument_helper.hpp"
+#include "sap_extract_manifest.hpp"
+#include "sap_rfc.hpp"
+#include "erpl_tracing.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    // 32 x RfcReadColumnStateMachine::MAX_BATCH_SIZE: big enough that the
+    // per-file overhead does not matter, small enough that a lost partition
+    // is minutes of work, not hours.
+    static constexpr unsigned int DEFAULT_PARTITION_ROWS = 32 * RfcReadColumnStateMachine::MAX_BATCH_SIZE;
+    static constexpr unsigned int DEFAULT_PARALLEL_PARTITIONS = 4;
+    static constexpr unsigned int DEFAULT_PARTITION_RETRIES = 3;
+
+    struct SapExtractBindData : public TableFunctionData
+    {
+        string table_name;
+        string target;
+        vector<string> columns;
+        string filter;
+        string secret_name;
+        string read_table_function;
+        unsigned int partition_rows = DEFAULT_PARTITION_ROWS;
+        unsigned int parallel = DEFAULT_PARALLEL_PARTITIONS;
+        unsigned int threads = 0;
+        unsigned int retries = DEFAULT_PARTITION_RETRIES;
+    };
+
+    struct SapExtractGlobalState : public GlobalTableFunctionState
+    {
+        bool done = false;
+        std::vector<std::vector<Value>> rows;
+        idx_t emitted = 0;
+    };
+
+    static unique_ptr<MaterializedQueryResult> RunExtractQuery(Connection &conn, const string &sql)
+    {
+        auto result = conn.Query(sql);
+        if (result->HasError()) {
+            throw std::runtime_error(result->GetError());
+        }
+        return result;
+    }
+
+    /**
+     * @brief One run of a sap_extract job.  Partition k holds the rows
+     *        [k * PARTITION_ROWS, (k + 1) * PARTITION_ROWS) of the table, read
+     *        with sap_read_table's ROW_OFFSET and MAX_ROWS and streamed by
+     *        COPY into its own Parquet file, so memory stays at what
+     *        PARALLEL scans hold at once.  Workers claim partitions from the
+     *        manifest, so other processes running the same job on the same
+     *        directory take partitions of their own, until one comes back
+     *        short: that one is the last.  The run ends when every partition
+     *        is recorded, by whichever process.
+    */
+    class SapExtractJob
+    {
+        public:
+            SapExtractJob(ClientContext &context, const SapExtractBindData &bind_data)
+                : context(context), bind_data(bind_data), fs(FileSystem::GetFileSystem(context)),
+                  manifest(fs, bind_data.target), owner(UUID::ToString(UUID::GenerateRandomUUID()))
+            { }
+
+            std::vector<std::vector<Value>> Run()
+            {
+                if (!fs.DirectoryExists(bind_data.target)) {
+                    fs.CreateDirectory(bind_data.target);
+                }
+                manifest.Open(SapExtractManifest::FormatJob(bind_data.table_name, bind_data.partition_rows,
+                                                            bind_data.columns, bind_data.filter));
+                std::set<idx_t> resumed;
+                for (auto &partition : manifest.Partitions()) {
+                    resumed.insert(partition.index);
+                }
+                if (!resumed.empty()) {
+                    ERPL_TRACE_INFO_DATA("sap_extract", StringUtil::Format("Resuming extraction of '%s'", bind_data.table_name),
+                                         StringUtil::Format("%llu partitions already in %s", (idx_t)resumed.size(),
+                                                            bind_data.target));
+                }
+
+                std::vector<std::thread> workers;
+                for (unsigned int i = 0; i < bind_data.parallel; i++) {
+                    workers.emplace_back([this]() { Work(); });
+                }
+                auto renewed = std::chrono::steady_clock::now();
+                while (true) {
+                    std::vector<idx_t> to_renew;
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        cv.wait_for(guard, std::chrono::milliseconds(100));
+                        if (finished_workers == workers.size()) {
+                            break;
+                        }
+                        if (context.interrupted.load() && !stop) {
+                            stop = true;
+                            for (auto conn : active) {
+                                conn->Interrupt();
+                            }
+                            cv.notify_all();
+                        }
+                        if (std::chrono::steady_clock::now() - renewed > std::chrono::milliseconds(CLAIM_LEASE_MS / 3)) {
+                            to_renew.assign(claimed.begin(), claimed.end());
+                            renewed = std::chrono::steady_clock::now();
+                        }
+                    }
+                    if (!to_renew.empty()) {
+                        try {
+                            auto lost_now = manifest.Renew(owner, to_renew, NowMs(), CLAIM_LEASE_MS);
+                            if (!lost_now.empty()) {
+                                std::lock_guard<std::mutex> guard(lock);
+                                for (auto index : lost_now) {
+                                    // Not if its worker finished it meanwhile.
+                                    if (claimed.erase(index)) {
+                                        lost.insert(index);
+                                    }
+                                }
+                                cv.notify_all();
+                            }
+                        } catch (std::exception &ex) {
+                            Fail(ex.what());
+                        }
+                    }
+                }
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+
+                if (context.interrupted.load()) {
+                    throw InterruptException();
+                }
+                if (!error.empty()) {
+                    throw std::runtime_error(error);
+                }
+
+                std::vector<std::vector<Value>> results;
+                auto partition_count = manifest.PartitionCount(bind_data.partition_rows);
+                for (auto &partition : manifest.Partitions()) {
+                    if (partition.index >= partition_count || partition.file == "-") {
+                        continue;
+                    }
+                    auto mine = extracted.find(partition.index);
+                    string status = mine != extracted.end() ? "extracted"
+                                    : resumed.count(partition.index) ? "resumed" : "peer";
+                    Value duration_ms = mine != extracted.end() ? Value::BIGINT(mine->second) : Value(LogicalType::BIGINT);
+                    results.push_back({ Value::BIGINT(partition.index), Value::BIGINT(partition.row_offset),
+                                        Value::BIGINT(partition.rows),
+                                        Value(fs.JoinPath(bind_data.target, partition.file)), Value(status),
+                                        duration_ms });
+                }
+                return results;
+            }
+
+        private:
+            // A claim not renewed for this long is taken over by another
+            // worker or process; the main thread renews at a third of it.
+            static constexpr int64_t CLAIM_LEASE_MS = 60000;
+            // How often a worker looks again when every partition left is
+            // claimed by another process.
+            static constexpr int64_t BUSY_POLL_MS = 1000;
+
+            ClientContext &context;
+            const SapExtractBindData &bind_data;
+            FileSystem &fs;
+            SapExtractManifest manifest;
+            // Names this run in its claims and temporary files.
+            const string owner;
+
+            std::mutex lock;
+            std::condition_variable cv;
+            idx_t finished_workers = 0;
+            bool stop = false;
+            string error;
+            std::vector<Connection *> active;
+            std::set<idx_t> claimed;
+            // Claimed partitions whose lease ran out before a renewal, e.g.
+            // while this host was suspended.  Another process may have taken
+            // them over, so their workers drop what they extracted; they are
+            // claimed anew like any other partition not yet recorded.
+            std::set<idx_t> lost;
+            // Duration in ms of each partition this run extracted.
+            std::map<idx_t, int64_t> extracted;
+
+            static int64_t NowMs()
+            {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+
+            void Work()
+            {
+                unique_ptr<Connection> conn;
+                try {
+                    conn = make_uniq<Connection>(*context.db);
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        active.push_back(conn.get());
+                    }
+                    WorkOnPartitions(*conn);
+                } catch (std::exception &ex) {
+                    Fail(ex.what());
+                }
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    active.erase(std::remove(active.begin(), active.end(), conn.get()), active.end());
+                    finished_workers++;
+                }
+                cv.notify_all();
+            }
+
+            void WorkOnPartitions(Connection &conn)
+            {
+                while (true) {
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        if (stop) {
+                            return;
+                        }
+                    }
+                    idx_t index;
+                    auto claim = manifest.Claim(owner, NowMs(), CLAIM_LEASE_MS, index);
+                    if (claim == SapExtractManifest::ClaimResult::DONE) {
+                        return;
+                    }
+                    if (claim == SapExtractManifest::ClaimResult::BUSY) {
+                        std::unique_lock<std::mutex> guard(lock);
+                        cv.wait_for(guard, std::chrono::milliseconds(BUSY_POLL_MS), [&]() { return stop; });
+                        continue;
+                    }
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        claimed.insert(index);
+                    }
+
+                    auto started = std::chrono::steady_clock::now();
+                    SapExtractPartition partition;
+                    string last_error;
+                    for (unsigned int attempt = 0; attempt <= bind_data.retries; attempt++) {
+                        try {
+                            partition = ExtractPartition(conn, index);
+                            if (IsLost(index)) {
+                                break;
+                            }
+                            MoveIntoPlace(partition);
+                            last_error.clear();
+                            break;
+                        } catch (std::exception &ex) {
+                            last_error = ex.what();
+                        }
+                        ERPL_TRACE_WARN_DATA("sap_extract",
+                                             StringUtil::Format("Partition %llu of '%s' failed (attempt %u)", index,
+                                                                bind_data.table_name, attempt + 1),
+                                             last_error);
+                        std::unique_lock<std::mutex> guard(lock);
+                        if (stop || attempt == bind_data.retries || lost.count(index)) {
+                            break;
+                        }
+                        cv.wait_for(guard, std::chrono::seconds(1 << MinValue<unsigned int>(attempt, 5)),
+                                    [&]() { return stop || lost.count(index) > 0; });
+                    }
+                    if (IsLost(index)) {
+                        {
+                            std::lock_guard<std::mutex> guard(lock);
+                            lost.erase(index);
+                        }
+                        auto temp_path = TempPath(index);
+                        if (fs.FileExists(temp_path)) {
+                            fs.RemoveFile(temp_path);
+                        }
+                        ERPL_TRACE_WARN("sap_extract",
+                                        StringUtil::Format("Lost the claim on partition %llu of '%s'; leaving it to "
+                                                           "the next claim", index, bind_data.table_name));
+                        continue;
+                    }
+                    if (!last_error.empty()) {
+                        {
+                            std::lock_guard<std::mutex> guard(lock);
+                            claimed.erase(index);
+                        }
+                        // Handed back at once rather than when the lease runs out.
+                        manifest.Release(owner, index);
+                        Fail(StringUtil::Format("Partition %llu of '%s' failed after %u attempts: %s\nCompleted "
+                                                "partitions are recorded in '%s'; run sap_extract again with the "
+                                                "same arguments to resume.",
+                                                index, bind_data.table_name, bind_data.retries + 1, last_error,
+                                                bind_data.target));
+                        return;
+                    }
+
+                    manifest.Record(partition);
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - started);
+                    std::lock_guard<std::mutex> guard(lock);
+                    claimed.erase(index);
+                    lost.erase(index);
+                    extracted[index] = elapsed.count();
+                }
+            }
+
+            SapExtractPartition ExtractPartition(Connection &conn, idx_t index)
+            {
+                SapExtractPartition partition;
+                partition.index = index;
+                partition.row_offset = index * bind_data.partition_rows;
+                if (partition.row_offset + bind_data.partition_rows > (idx_t)NumericLimits<int32_t>::Maximum()) {
+                    throw std::runtime_error(StringUtil::Format("Partition %llu of '%s' starts past the row offsets "
+                                                                "RFC_READ_TABLE can address", index, bind_data.table_name));
+                }
+
+                partition.file = FileName(index);
+                auto temp_path = TempPath(index);
+
+                auto source = StringUtil::Format("sap_read_table(%s, row_offset=%llu, max_rows=%u",
+                                                 SQLString(bind_data.table_name), partition.row_offset,
+                                                 bind_data.partition_rows);
+                if (!bind_data.columns.empty()) {
+                    vector<string> quoted;
+                    for (auto &column : bind_data.columns) {
+                        quoted.push_back(SQLString(column));
+                    }
+                    source += StringUtil::Format(", columns=[%s]", StringUtil::Join(quoted, ", "));
+                }
+                if (!bind_data.filter.empty()) {
+                    source += StringUtil::Format(", filter=%s", SQLString(bind_data.filter));
+                }
+                if (bind_data.threads > 0) {
+                    source += StringUtil::Format(", threads=%u", bind_data.threads);
+                }
+                if (!bind_data.secret_name.empty()) {
+                    source += StringUtil::Format(", secret=%s", SQLString(bind_data.secret_name));
+                }
+                if (!bind_data.read_table_function.empty()) {
+                    source += StringUtil::Format(", read_table_function=%s", SQLString(bind_data.read_table_function));
+                }
+                source += ")";
+
+                // Written under a temporary name and renamed by MoveIntoPlace()
+                // once complete, so a partition file that exists is a whole one.
+                auto copied = RunExtractQuery(conn, StringUtil::Format("COPY (SELECT * FROM %s) TO %s (FORMAT parquet)",
+                                                                       source, SQLString(temp_path)));
+                partition.rows = copied->GetValue(0, 0).GetValue<int64_t>();
+                return partition;
+            }
+
+            string FileName(idx_t index) const
+            {
+                auto stem = StringUtil::Replace(StringUtil::Lower(bind_data.table_name), "/", "_");
+                return StringUtil::Format("%s_%06llu.parquet", stem, index);
+            }
+
+            // Unique per run: after a lease ran out, the old and the new owner
+            // of a partition may both be writing it.
+            string TempPath(idx_t index) const
+            {
+                return StringUtil::Format("%s.%s.tmp", fs.JoinPath(bind_data.target, FileName(index)), owner);
+            }
+
+            bool IsLost(idx_t index)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                return lost.count(index) > 0;
+            }
+
+            // Renames the temporary file of an extracted partition to its
+            // final name.
+            void MoveIntoPlace(SapExtractPartition &partition)
+            {
+                auto index = partition.index;
+                auto temp_path = TempPath(index);
+                auto path = fs.JoinPath(bind_data.target, partition.file);
+                if (partition.rows == 0 && index > 0) {
+                    // Past the end of the table.  Only the first partition of
+                    // an empty table keeps its file, for the schema.
+                    fs.RemoveFile(temp_path);
+                    partition.file = "-";
+                    return;
+                }
+                if (fs.FileExists(path)) {
+                    // Left by a run that died between the rename and the
+                    // manifest line.
+                    fs.RemoveFile(path);
+                }
+                fs.MoveFile(temp_path, path);
+            }
+
+            void Fail(const string &message)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (error.empty()) {
+                        error = message;
+                    }
+                    stop = true;
+                }
+                cv.notify_all();
+            }
+    };
+
+    /**
+     * @brief Binds `sap_extract(table, TARGET='dir/')`.  Nothing is read from
+     *        SAP here; every partition is bound and read on its own.
+    */
+    static unique_ptr<FunctionData> SapExtractBind(ClientContext &context,
+                                                   TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types,
+                                                   vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_extract");
+
+        auto &named_params = input.named_parameters;
+        auto bind_data = make_uniq<SapExtractBindData>();
+        bind_data->table_name = StringUtil::Upper(input.inputs[0].ToString());
+
+        if (named_params.find("TARGET") == named_params.end()) {
+            throw InvalidInputException("sap_extract requires TARGET, the directory the Parquet files and the "
+                                        "manifest are written to");
+        }
+        bind_data->target = named_params["TARGET"].ToString();
+        if (named_params.find("COLUMNS") != named_params.end()) {
+            bind_data->columns = ConvertListValueToVector<std::string>(named_params["COLUMNS"]);
+        }
+        if (named_params.find("FILTER") != named_params.end()) {
+            bind_data->filter = named_params["FILTER"].ToString();
+        }
+        if (named_params.find("SECRET") != named_params.end()) {
+            bind_data->secret_name = named_params["SECRET"].ToString();
+        }
+        if (named_params.find("READ_TABLE_FUNCTION") != named_params.end()) {
+            bind_data->read_table_function = named_params["READ_TABLE_FUNCTION"].ToString();
+        }
+        if (named_params.find("PARTITION_ROWS") != named_params.end()) {
+            bind_data->partition_rows = named_params["PARTITION_ROWS"].GetValue<unsigned int>();
+        }
+        if (named_params.find("PARALLEL") != named_params.end()) {
+            bind_data->parallel = named_params["PARALLEL"].GetValue<unsigned int>();
+        }
+        if (named_params.find("THREADS") != named_params.end()) {
+            bind_data->threads = named_params["THREADS"].GetValue<unsigned int>();
+        }
+        if (named_params.find("RETRIES") != named_params.end()) {
+            bind_data->retries = named_params["RETRIES"].GetValue<unsigned int>();
+        }
+
+        if (bind_data->partition_rows == 0 || bind_data->partition_rows % RfcReadColumnStateMachine::MAX_BATCH_SIZE != 0) {
+            throw InvalidInputException("PARTITION_ROWS must be a positive multiple of %u",
+                                        RfcReadColumnStateMachine::MAX_BATCH_SIZE);
+        }
+        if (bind_data->parallel == 0) {
+            throw InvalidInputException("PARALLEL must be at least 1");
+        }
+
+        names = { "partition", "row_offset", "rows", "file", "status", "duration_ms" };
+        return_types = { LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::VARCHAR,
+                         LogicalType::VARCHAR, LogicalType::BIGINT };
+
+        return std::move(bind_data);
+    }
+
+    static unique_ptr<GlobalTableFunctionState> SapExtractInitGlobalState(ClientContext &context,
+                                                                         TableFunctionInitInput &input)
+    {
+        return make_uniq<SapExtractGlobalState>();
+    }
+
+    static void SapExtractScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<SapExtractBindData>();
+        auto &global_state = data.global_state->Cast<SapExtractGlobalState>();
+
+        if (!global_state.done) {
+            SapExtractJob job(context, bind_data);
+            global_state.rows = job.Run();
+            global_state.done = true;
+        }
+
+        idx_t out_idx = 0;
+        while (global_state.emitted < global_state.rows.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &row = global_state.rows[global_state.emitted++];
+            for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, out_idx, row[col_idx]);
+            }
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+    }
+
+    TableFunction CreateSapExtractScanFunction()
+    {
+        auto fun = TableFunction("sap_extract", { LogicalType::VARCHAR },
+                                 SapExtractScan,
+                                 SapExtractBind,
+                                 SapExtractInitGlobalState);
+        fun.named_parameters["TARGET"] = LogicalType::VARCHAR;
+        fun.named_parameters["COLUMNS"] = LogicalType::LIST(LogicalType::VARCHAR);
+        fun.named_parameters["FILTER"] = LogicalType::VARCHAR;
+        fun.named_parameters["PARTITION_ROWS"] = LogicalType::UINTEGER;
+        fun.named_parameters["PARALLEL"] = LogicalType::UINTEGER;
+        fun.named_parameters["THREADS"] = LogicalType::UINTEGER;
+        fun.named_parameters["RETRIES"] = LogicalType::UINTEGER;
+        fun.named_parameters["READ_TABLE_FUNCTION"] = LogicalType::VARCHAR;
+        fun.named_parameters["SECRET"] = LogicalType::VARCHAR;
+
+        return fun;
+    }
+} // namespace duckdb
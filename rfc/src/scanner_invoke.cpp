@@ -1,6 +1,10 @@
 #include "duckdb.hpp"
 #include "scanner_invoke.hpp"
 #include "sap_secret.hpp"
+#include "sap_metadata_cache.hpp"
+#include "sap_invoke_cache.hpp"
+#include "sap_scan_history.hpp"
+#include "sap_trace_spans.hpp"
 #include "telemetry.hpp"
 #include "erpl_telemetry.hpp"
 
@@ -15,8 +19,31 @@ namespace duckdb
         }
     }
 
+    // Everything needed to make the call, captured at bind.  The call itself
+    // happens once per execution, in RfcInvokeInitGlobalState, so prepared
+    // statements, EXPLAIN and re-binds never reach SAP.
+    struct RfcInvokeBindData : public TableFunctionData
+    {
+        RfcAuthParams auth_params;
+        std::string func_name;
+        std::vector<Value> func_args;
+        std::string path;
+        std::vector<std::string> result_names;
+        std::vector<LogicalType> result_types;
+        // When the called RFC has no export/changing/table parameters
+        // (e.g. RFC_PING), a single boolean 'ok' column is synthesized.
+        bool ok_only = false;
+        // System, client and user of the bind connection, for the invoke
+        // cache key; a cache hit then needs no connection at all.
+        RfcConnectionAttributes connection_attributes;
+    };
+
     /**
      * @brief (Step 1) Binds the input arguments to the function.
+     *
+     * Only the function descriptor is needed for the schema, and it usually
+     * comes from the metadata cache.  The arguments are adapted to a local
+     * function handle too, so type errors still surface at bind time.
     */
     static unique_ptr<FunctionData> RfcInvokeBind(ClientContext &context, 
                                                   TableFunctionBindInput &input, 
@@ -26,28 +53,121 @@ namespace duckdb
         PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_invoke");
 
         auto &inputs = input.inputs;
+        auto bind_data = make_uniq<RfcInvokeBindData>();
+        bind_data->auth_params = GetAuthParamsFromContext(context, input);
+        bind_data->func_name = inputs[0].GetValue<string>();
+        bind_data->func_args = std::vector<Value>(inputs.begin()+1, inputs.end());
+        bind_data->path = GetPathNamedParam(input);
+
+        auto connection = bind_data->auth_params.Connect();
+        {
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data->func_name);
+            auto schema = RfcResultSet::InferResultSchema(*func, bind_data->path);
+            names = schema.first;
+            return_types = schema.second;
+            auto args = bind_data->func_args;
+            if (!args.empty()) {
+                func->BeginInvocation(args);
+            }
+            try {
+                bind_data->connection_attributes = connection->ConnectionAttributes();
+            } catch (std::exception &) {
+                // Without a system id the key is empty and the call is not cached.
+            }
+        }
+        RfcConnectionPool::Get().Release(std::move(connection));
+
+        // DuckDB requires every table function to expose at least one column.
+        // RFC modules like RFC_PING have no export/changing/table parameters,
+        // so the natural schema is empty. Inject a synthetic BOOLEAN 'ok'
+        // column so the call is still usable as `SELECT * FROM sap_rfc_invoke(...)`.
+        bind_data->result_names = names;
+        bind_data->result_types = return_types;
+        bind_data->ok_only = return_types.empty();
+        if (bind_data->ok_only) {
+            names.push_back("ok");
+            return_types.push_back(LogicalType::BOOLEAN);
+        }
+
+        return std::move(bind_data);
+    }
+
+    // One execution: the call's result, and the output columns requested by
+    // the query by result name.  Row-id slots (e.g. for count(*)) carry an
+    // empty name and are filled with NULL.
+    struct RfcInvokeGlobalState : public GlobalTableFunctionState
+    {
+        std::shared_ptr<RfcConnection> connection;
+        std::shared_ptr<RfcResultSet> result_set;
+        std::vector<std::string> projected_names;
+        std::vector<idx_t> row_id_columns;
+        bool ok_only_emitted = false;
 
-        // Connect to the SAP system
-        auto connection = GetAuthParamsFromContext(context, input).Connect();
+        // Set instead of result_set when the result comes from the invoke
+        // cache: the whole result, scanned for the projected columns only.
+        RfcInvokeCache::Result cached;
+        ColumnDataScanState cached_scan;
+        DataChunk cached_chunk;
+        std::vector<idx_t> cached_targets;
+        idx_t cached_rows_emitted = 0;
 
-        // Create the function
-        auto func_name = inputs[0].GetValue<string>();
-        auto func_args = std::vector<Value>(inputs.begin()+1, inputs.end());
-        auto path = GetPathNamedParam(input);
+        // Filled in while the scan history is on; `system` stays empty
+        // otherwise.
+        RfcScanRecord history;
+        std::chrono::steady_clock::time_point started;
+        ClientContext &context;
 
+        explicit RfcInvokeGlobalState(ClientContext &context) : context(context) {}
+
+        ~RfcInvokeGlobalState() override
+        {
+            if (!history.system.empty()) {
+                // As for sap_read_table: an interrupted query is cancelled,
+                // even if this scan had returned all its rows.
+                if (context.interrupted) {
+                    history.status = "cancelled";
+                }
+                history.finished_at_ms = RfcScanHistory::NowMs();
+                history.duration_ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - started).count();
+                RfcScanHistory::Append(FileSystem::GetFileSystem(context), history);
+            }
+            // The call completed (a failed one never gets a global state), so
+            // the connection is clean and can serve the next statement.
+            result_set.reset();
+            RfcConnectionPool::Get().Release(std::move(connection));
+        }
+    };
+
+    static std::shared_ptr<RfcResultSet> InvokeForScan(RfcInvokeBindData &bind_data,
+                                                       std::shared_ptr<RfcConnection> &connection,
+                                                       std::vector<std::string> &projected_names)
+    {
         // Telemetry: SAP BAPIs are RFC-enabled function modules whose names start
         // with "BAPI_"; classify by that prefix so the dashboard can split BAPI
         // vs plain RFC. The prefix check is a code-controlled classification — the
         // function name itself is NEVER sent. Times only the RFC round-trip and
         // emits feature_used {feature, duration_ms} on success; a failure emits an
         // enumerated $exception instead (feature timer cancelled).
-        const char *feat = StringUtil::StartsWith(StringUtil::Upper(func_name), "BAPI_")
+        const char *feat = StringUtil::StartsWith(StringUtil::Upper(bind_data.func_name), "BAPI_")
                                ? erpl_telemetry::feature::kBapiCall
                                : erpl_telemetry::feature::kSapRfc;
         erpl_telemetry::ScopedFeature feat_timer(feat);
         std::shared_ptr<RfcResultSet> result_set;
         try {
-            result_set = RfcResultSet::InvokeFunction(connection, func_name, func_args, path);
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data.func_name);
+            auto args = bind_data.func_args;
+            auto invocation = args.empty() ? func->BeginInvocation() : func->BeginInvocation(args);
+            if (bind_data.path.empty()) {
+                // Without a path every result parameter is a column, so the
+                // projection decides which ones SAP has to send.
+                if (!bind_data.ok_only) {
+                    invocation->DeactivateResultsExcept(projected_names);
+                }
+                result_set = invocation->Invoke();
+            } else {
+                result_set = invocation->Invoke(bind_data.path);
+            }
         } catch (...) {
             feat_timer.Cancel();
             erpl_telemetry::CaptureError(erpl_telemetry::error_class::kRfcError,
@@ -55,58 +175,194 @@ namespace duckdb
             throw;
         }
         feat_timer.Fire();
-        names = result_set->GetResultNames();
-        return_types = result_set->GetResultTypes();
+        return result_set;
+    }
 
-        // DuckDB requires every table function to expose at least one column.
-        // RFC modules like RFC_PING have no export/changing/table parameters,
-        // so the natural schema is empty. Inject a synthetic BOOLEAN 'ok'
-        // column so the call is still usable as `SELECT * FROM sap_rfc_invoke(...)`.
-        // The invocation itself has already succeeded if we reached this line.
-        auto bind_data = make_uniq<RfcFunctionBindData>();
-        bind_data->result_set = result_set;
-        bind_data->ok_only = return_types.empty();
-        if (bind_data->ok_only) {
-            names.push_back("ok");
-            return_types.push_back(LogicalType::BOOLEAN);
+    // The full result of one call, every column, for the invoke cache.
+    static RfcInvokeCache::Result InvokeForCache(RfcInvokeBindData &bind_data,
+                                                 std::shared_ptr<RfcConnection> &connection)
+    {
+        auto all_names = bind_data.result_names;
+        auto result_set = InvokeForScan(bind_data, connection, all_names);
+
+        auto collection = std::make_shared<ColumnDataCollection>(Allocator::DefaultAllocator(), bind_data.result_types);
+        DataChunk chunk;
+        chunk.Initialize(Allocator::DefaultAllocator(), bind_data.result_types);
+        while (result_set->HasMoreResults()) {
+            chunk.Reset();
+            result_set->FetchNextResult(chunk);
+            collection->Append(chunk);
         }
+        return collection;
+    }
 
-        return std::move(bind_data);
+    static std::string TryInvokeCacheKey(RfcInvokeBindData &bind_data)
+    {
+        if (bind_data.ok_only || !RfcInvokeCache::IsCacheable(bind_data.func_name)) {
+            return "";
+        }
+        return RfcInvokeCache::Key(bind_data.connection_attributes, bind_data.func_name,
+                                   bind_data.path, bind_data.func_args);
     }
 
-    /**
-     * @brief (Step 2) Scans the function and returns the next chunk of data.
-    */
-    static void RfcInvokeScan(ClientContext &context,
-                              TableFunctionInput &data,
-                              DataChunk &output)
+    static void InitCachedScan(RfcInvokeBindData &bind_data, RfcInvokeGlobalState &global_state,
+                               const vector<column_t> &column_ids)
+    {
+        vector<column_t> scan_ids;
+        vector<LogicalType> scan_types;
+        for (idx_t i = 0; i < column_ids.size(); i++) {
+            if (IsRowIdColumnId(column_ids[i])) {
+                continue;
+            }
+            scan_ids.push_back(column_ids[i]);
+            scan_types.push_back(bind_data.result_types[column_ids[i]]);
+            global_state.cached_targets.push_back(i);
+        }
+        global_state.cached->InitializeScan(global_state.cached_scan, scan_ids,
+                                            ColumnDataScanProperties::DISALLOW_ZERO_COPY);
+        if (!scan_types.empty()) {
+            global_state.cached_chunk.Initialize(Allocator::DefaultAllocator(), scan_types);
+        }
+    }
+
+    static unique_ptr<GlobalTableFunctionState> RfcInvokeInitGlobalState(ClientContext &context,
+                                                                         TableFunctionInitInput &input)
     {
-	    auto &bind_data = data.bind_data->CastNoConst<RfcFunctionBindData>();
-        auto result_set = bind_data.result_set;
+        auto &bind_data = input.bind_data->CastNoConst<RfcInvokeBindData>();
+        auto global_state = make_uniq<RfcInvokeGlobalState>(context);
+        global_state->started = std::chrono::steady_clock::now();
+
+        if (!bind_data.ok_only) {
+            for (idx_t i = 0; i < input.column_ids.size(); i++) {
+                auto column_id = input.column_ids[i];
+                if (IsRowIdColumnId(column_id)) {
+                    global_state->projected_names.push_back("");
+                    global_state->row_id_columns.push_back(i);
+                    continue;
+                }
+                global_state->projected_names.push_back(bind_data.result_names[column_id]);
+            }
+        }
+
+        // The logon, metadata lookup and call all happen here.
+        auto spans = RfcSpanBuffer::ForQuery(context);
+        RfcSpanContext span_context(spans.get(), spans ? spans->NextScanId() : 0, std::string());
+
+        // A cache hit, or a call joined while in flight, never connects.
+        std::shared_ptr<RfcConnection> connection;
+        auto cache_key = TryInvokeCacheKey(bind_data);
+        auto invoked = false;
+        auto call_started = std::chrono::steady_clock::now();
+        if (!cache_key.empty()) {
+            global_state->cached = RfcInvokeCache::Get().GetOrInvoke(cache_key, bind_data.func_name, [&]() {
+                invoked = true;
+                connection = bind_data.auth_params.Connect();
+                return InvokeForCache(bind_data, connection);
+            });
+            InitCachedScan(bind_data, *global_state, input.column_ids);
+        } else {
+            invoked = true;
+            connection = bind_data.auth_params.Connect();
+            global_state->result_set = InvokeForScan(bind_data, connection, global_state->projected_names);
+        }
+
+        if (!GetRfcScanHistoryPath().empty()) {
+            auto &history = global_state->history;
+            history.function = "sap_rfc_invoke";
+            history.status = "stopped";
+            history.source = invoked ? "extracted" : "cached";
+            history.system = bind_data.auth_params.SystemFingerprint();
+            history.object = RfcScanHistory::ObjectFingerprint(bind_data.func_name);
+            if (invoked) {
+                history.rfc_calls = 1;
+                history.rfc_time_ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - call_started).count();
+            }
+            history.connections_opened = connection && !connection->reused_from_pool ? 1 : 0;
+            history.connections_reused = connection && connection->reused_from_pool ? 1 : 0;
+            history.columns = input.column_ids.size();
+        }
+        global_state->connection = std::move(connection);
+
+        return std::move(global_state);
+    }
+
+    static void RfcInvokeScanChunk(TableFunctionInput &data, DataChunk &output)
+    {
+	    auto &bind_data = data.bind_data->CastNoConst<RfcInvokeBindData>();
+        auto &global_state = data.global_state->Cast<RfcInvokeGlobalState>();
+        auto &result_set = global_state.result_set;
 
         if (bind_data.ok_only) {
             // Synthetic single-row 'ok=true' for functions with no real
             // result params. Emit once, then signal end-of-stream.
-            if (bind_data.ok_only_emitted) {
+            if (global_state.ok_only_emitted) {
                 return;
             }
-            bind_data.ok_only_emitted = true;
+            global_state.ok_only_emitted = true;
             output.SetCardinality(1);
             output.SetValue(0, 0, Value::BOOLEAN(true));
             return;
         }
 
+        if (global_state.cached) {
+            auto &cached = *global_state.cached;
+            if (global_state.cached_targets.empty()) {
+                // No column projected (count(*)): only rows are counted.
+                auto remaining = cached.Count() - global_state.cached_rows_emitted;
+                auto row_count = std::min<idx_t>(remaining, STANDARD_VECTOR_SIZE);
+                global_state.cached_rows_emitted += row_count;
+                output.SetCardinality(row_count);
+            } else {
+                auto &chunk = global_state.cached_chunk;
+                if (!cached.Scan(global_state.cached_scan, chunk)) {
+                    return;
+                }
+                for (idx_t i = 0; i < global_state.cached_targets.size(); i++) {
+                    output.data[global_state.cached_targets[i]].Reference(chunk.data[i]);
+                }
+                output.SetCardinality(chunk.size());
+            }
+            for (auto col_idx : global_state.row_id_columns) {
+                output.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
+                ConstantVector::SetNull(output.data[col_idx], true);
+            }
+            return;
+        }
+
         if (! result_set->HasMoreResults()) {
             return;
         }
 
-        result_set->FetchNextResult(output);
+        // Only the projected fields are decoded from the SDK buffers.
+        result_set->FetchNextResult(output, global_state.projected_names);
+        for (auto col_idx : global_state.row_id_columns) {
+            output.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
+            ConstantVector::SetNull(output.data[col_idx], true);
+        }
+    }
+
+    /**
+     * @brief (Step 2) Scans the function and returns the next chunk of data.
+    */
+    static void RfcInvokeScan(ClientContext &context,
+                              TableFunctionInput &data,
+                              DataChunk &output)
+    {
+        RfcInvokeScanChunk(data, output);
+
+        auto &history = data.global_state->Cast<RfcInvokeGlobalState>().history;
+        history.rows += output.size();
+        if (output.size() == 0) {
+            history.status = "complete";
+        }
     }
 
     TableFunction CreateRfcInvokeScanFunction() 
     {
-        auto fun = TableFunction("sap_rfc_invoke", { LogicalType::VARCHAR }, RfcInvokeScan, RfcInvokeBind);
-        fun.projection_pushdown = false;
+        auto fun = TableFunction("sap_rfc_invoke", { LogicalType::VARCHAR }, RfcInvokeScan, RfcInvokeBind,
+                                 RfcInvokeInitGlobalState);
+        fun.projection_pushdown = true;
         fun.varargs = LogicalType::ANY;
         fun.named_parameters["path"] = LogicalType::VARCHAR;
         fun.named_parameters["secret"] = LogicalType::VARCHAR;
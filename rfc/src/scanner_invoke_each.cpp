@@ -0,0 +1,340 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "duckdb.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+
+#include "scanner_invoke_each.hpp"
+#include "sap_secret.hpp"
+#include "sap_metadata_cache.hpp"
+#include "sap_trace_spans.hpp"
+#include "erpl_tracing.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb 
+{
+    // Upper bound for the `threads` parameter; the SAP gateway limits the
+    // number of concurrent logons per user long before this.
+    static constexpr idx_t MAX_INVOKE_EACH_THREADS = 64;
+    static constexpr idx_t DEFAULT_INVOKE_EACH_THREADS = 4;
+
+    struct RfcInvokeEachBindData : public TableFunctionData
+    {
+        RfcAuthParams auth_params;
+        std::string func_name;
+        std::string path;
+        idx_t threads = DEFAULT_INVOKE_EACH_THREADS;
+        // Sets the parameters named by the input columns from one input row.
+        std::shared_ptr<RfcImportAdapter> import_adapter;
+        std::vector<LogicalType> result_types;
+        // Same convention as sap_rfc_invoke: functions without any result
+        // parameter (e.g. RFC_PING) yield a single `ok` column.
+        bool ok_only = false;
+    };
+
+    /**
+     * @brief Binds `sap_rfc_invoke_each(function_name, (SELECT ...))`.
+     *
+     * Each column of the input relation is an import parameter, matched by
+     * name (case-insensitive).  The result schema comes from the function
+     * descriptor, as for sap_rfc_invoke, prefixed with `input_row_id`.
+    */
+    static unique_ptr<FunctionData> RfcInvokeEachBind(ClientContext &context, 
+                                                      TableFunctionBindInput &input, 
+                                                      vector<LogicalType> &return_types, 
+                                                      vector<string> &names) 
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_invoke_each");
+
+        auto &named_params = input.named_parameters;
+        auto bind_data = make_uniq<RfcInvokeEachBindData>();
+        bind_data->auth_params = GetAuthParamsFromContext(context, input);
+        bind_data->func_name = input.inputs[0].GetValue<string>();
+        bind_data->path = named_params.find("path") != named_params.end()
+                            ? named_params["path"].GetValue<string>()
+                            : "";
+        if (named_params.find("threads") != named_params.end()) {
+            auto threads = named_params["threads"].GetValue<uint32_t>();
+            bind_data->threads = std::max<idx_t>(1, std::min<idx_t>(threads, MAX_INVOKE_EACH_THREADS));
+        }
+
+        auto connection = bind_data->auth_params.Connect();
+        {
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data->func_name);
+            bind_data->import_adapter = std::make_shared<RfcImportAdapter>(*func, input.input_table_names,
+                                                                           input.input_table_types);
+
+            auto schema = RfcResultSet::InferResultSchema(*func, bind_data->path);
+            names = schema.first;
+            return_types = schema.second;
+        }
+        RfcConnectionPool::Get().Release(std::move(connection));
+
+        bind_data->ok_only = return_types.empty();
+        if (bind_data->ok_only) {
+            names.push_back("ok");
+            return_types.push_back(LogicalType::BOOLEAN);
+        }
+        bind_data->result_types = std::vector<LogicalType>(return_types.begin(), return_types.end());
+
+        names.insert(names.begin(), "input_row_id");
+        return_types.insert(return_types.begin(), LogicalType::BIGINT);
+
+        return std::move(bind_data);
+    }
+
+    // Shared by every pipeline thread of one statement.  Input rows are
+    // numbered in the order their chunks arrive, and the number of RFC calls
+    // in flight across all threads is capped at `threads`, so the statement
+    // never holds more connections than that.
+    struct RfcInvokeEachGlobalState : public GlobalTableFunctionState
+    {
+        explicit RfcInvokeEachGlobalState(idx_t max_calls) : max_calls(max_calls) {}
+
+        std::atomic<idx_t> next_row_id{0};
+        // Where the calls' spans go; null when span recording is off.
+        std::shared_ptr<RfcSpanBuffer> spans;
+        idx_t span_scan_id = 0;
+
+        void AcquireCallSlot()
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            slot_free.wait(guard, [&] { return in_flight < max_calls; });
+            in_flight++;
+        }
+
+        void ReleaseCallSlot()
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                in_flight--;
+            }
+            slot_free.notify_one();
+        }
+
+        private:
+            std::mutex lock;
+            std::condition_variable slot_free;
+            idx_t in_flight = 0;
+            idx_t max_calls;
+    };
+
+    // Result rows of the current input chunk that did not fit into the last
+    // output chunk yet.
+    struct RfcInvokeEachLocalState : public LocalTableFunctionState
+    {
+        RfcImportAdapter::Batch batch;
+        std::vector<std::vector<Value>> pending_rows;
+        idx_t emitted = 0;
+        bool input_processed = false;
+    };
+
+    static unique_ptr<GlobalTableFunctionState> RfcInvokeEachInitGlobalState(ClientContext &context,
+                                                                             TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->Cast<RfcInvokeEachBindData>();
+        auto global_state = make_uniq<RfcInvokeEachGlobalState>(bind_data.threads);
+        global_state->spans = RfcSpanBuffer::ForQuery(context);
+        global_state->span_scan_id = global_state->spans ? global_state->spans->NextScanId() : 0;
+        return std::move(global_state);
+    }
+
+    static unique_ptr<LocalTableFunctionState> RfcInvokeEachInitLocalState(ExecutionContext &context,
+                                                                           TableFunctionInitInput &input,
+                                                                           GlobalTableFunctionState *global_state)
+    {
+        return make_uniq<RfcInvokeEachLocalState>();
+    }
+
+    // One call on a pooled connection; returns the result rows as values.
+    static std::vector<std::vector<Value>> InvokeForRow(const RfcInvokeEachBindData &bind_data,
+                                                        const RfcImportAdapter::Batch &batch, idx_t row_idx)
+    {
+        auto auth_params = bind_data.auth_params;
+        auto connection = auth_params.Connect();
+        std::vector<std::vector<Value>> rows;
+        {
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data.func_name);
+            auto invocation = func->BeginInvocation();
+            bind_data.import_adapter->Adapt(*invocation, batch, row_idx);
+            auto result_set = bind_data.path.empty() ? invocation->Invoke() : invocation->Invoke(bind_data.path);
+
+            if (bind_data.ok_only) {
+                rows.push_back({ Value::BOOLEAN(true) });
+            } else {
+                DataChunk chunk;
+                chunk.Initialize(Allocator::DefaultAllocator(), bind_data.result_types);
+                while (result_set->HasMoreResults()) {
+                    chunk.Reset();
+                    result_set->FetchNextResult(chunk);
+                    for (idx_t result_idx = 0; result_idx < chunk.size(); result_idx++) {
+                        std::vector<Value> row;
+                        row.reserve(chunk.ColumnCount());
+                        for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+                            row.push_back(chunk.GetValue(col_idx, result_idx));
+                        }
+                        rows.push_back(std::move(row));
+                    }
+                }
+            }
+        }
+        // Only reached after a successful call, so the connection is clean.
+        RfcConnectionPool::Get().Release(std::move(connection));
+        return rows;
+    }
+
+    // The calls of one input chunk: the rows still to call and the results
+    // so far, shared by the tasks working on the chunk.
+    struct RfcInvokeEachChunkCalls
+    {
+        RfcInvokeEachChunkCalls(ClientContext &context, const RfcInvokeEachBindData &bind_data,
+                                RfcInvokeEachGlobalState &global_state, const RfcImportAdapter::Batch &batch,
+                                idx_t row_count, idx_t first_row_id)
+            : context(context), bind_data(bind_data), global_state(global_state), batch(batch),
+              row_count(row_count), first_row_id(first_row_id), results(row_count)
+        { }
+
+        void Work()
+        {
+            RfcSpanContext span_context(global_state.spans.get(), global_state.span_scan_id, std::string());
+            while (!failed && !context.interrupted) {
+                auto row_idx = next_row.fetch_add(1);
+                if (row_idx >= row_count) {
+                    return;
+                }
+                global_state.AcquireCallSlot();
+                try {
+                    results[row_idx] = InvokeForRow(bind_data, batch, row_idx);
+                } catch (std::exception &ex) {
+                    std::lock_guard<std::mutex> guard(error_lock);
+                    if (!failed) {
+                        error = StringUtil::Format("Call of '%s' for input row %llu failed: %s",
+                                                   bind_data.func_name, first_row_id + row_idx, ex.what());
+                        failed = true;
+                    }
+                }
+                global_state.ReleaseCallSlot();
+            }
+        }
+
+        ClientContext &context;
+        const RfcInvokeEachBindData &bind_data;
+        RfcInvokeEachGlobalState &global_state;
+        const RfcImportAdapter::Batch &batch;
+        idx_t row_count;
+        idx_t first_row_id;
+
+        std::vector<std::vector<std::vector<Value>>> results;
+        std::atomic<idx_t> next_row{0};
+        std::atomic<bool> failed{false};
+        std::mutex error_lock;
+        std::string error;
+    };
+
+    class RfcInvokeEachTask : public BaseExecutorTask
+    {
+        public:
+            RfcInvokeEachTask(TaskExecutor &executor, RfcInvokeEachChunkCalls &calls)
+                : BaseExecutorTask(executor), calls(calls)
+            { }
+
+            void ExecuteTask() override
+            {
+                calls.Work();
+            }
+
+        private:
+            RfcInvokeEachChunkCalls &calls;
+    };
+
+    /**
+     * @brief Calls the function once per input row, `threads` calls at a time,
+     *        and queues the results in input order.  The calls run as tasks
+     *        on DuckDB's scheduler, like sap_read_table's column tasks.
+    */
+    static void InvokeForChunk(ClientContext &context,
+                               const RfcInvokeEachBindData &bind_data,
+                               RfcInvokeEachGlobalState &global_state,
+                               RfcInvokeEachLocalState &local_state,
+                               DataChunk &input)
+    {
+        auto row_count = input.size();
+        auto first_row_id = global_state.next_row_id.fetch_add(row_count);
+
+        bind_data.import_adapter->Stage(input, local_state.batch);
+
+        RfcInvokeEachChunkCalls calls(context, bind_data, global_state, local_state.batch, row_count, first_row_id);
+        auto n_tasks = std::min<idx_t>(bind_data.threads, row_count);
+        TaskExecutor executor(TaskScheduler::GetScheduler(context));
+        for (idx_t i = 0; i < n_tasks; i++) {
+            executor.ScheduleTask(make_uniq<RfcInvokeEachTask>(executor, calls));
+        }
+        executor.WorkOnTasks();
+
+        if (calls.failed) {
+            throw std::runtime_error(calls.error);
+        }
+        if (context.interrupted) {
+            throw InterruptException();
+        }
+
+        local_state.pending_rows.clear();
+        local_state.emitted = 0;
+        for (idx_t row_idx = 0; row_idx < row_count; row_idx++) {
+            auto row_id = Value::BIGINT(static_cast<int64_t>(first_row_id + row_idx));
+            for (auto &result_row : calls.results[row_idx]) {
+                result_row.insert(result_row.begin(), row_id);
+                local_state.pending_rows.push_back(std::move(result_row));
+            }
+        }
+        ERPL_TRACE_DEBUG_DATA("sap_rfc_invoke_each", "Invoked " + bind_data.func_name + " per input row",
+                              StringUtil::Format("%llu rows, %llu results", row_count,
+                                                 local_state.pending_rows.size()));
+    }
+
+    static OperatorResultType RfcInvokeEachFunction(ExecutionContext &context,
+                                                    TableFunctionInput &data,
+                                                    DataChunk &input,
+                                                    DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<RfcInvokeEachBindData>();
+        auto &global_state = data.global_state->Cast<RfcInvokeEachGlobalState>();
+        auto &local_state = data.local_state->Cast<RfcInvokeEachLocalState>();
+
+        if (!local_state.input_processed) {
+            InvokeForChunk(context.client, bind_data, global_state, local_state, input);
+            local_state.input_processed = true;
+        }
+
+        idx_t out_idx = 0;
+        while (local_state.emitted < local_state.pending_rows.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &row = local_state.pending_rows[local_state.emitted++];
+            for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, out_idx, row[col_idx]);
+            }
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+
+        if (local_state.emitted < local_state.pending_rows.size()) {
+            return OperatorResultType::HAVE_MORE_OUTPUT;
+        }
+        local_state.pending_rows.clear();
+        local_state.input_processed = false;
+        return OperatorResultType::NEED_MORE_INPUT;
+    }
+
+    TableFunction CreateRfcInvokeEachScanFunction() 
+    {
+        auto fun = TableFunction("sap_rfc_invoke_each", { LogicalType::VARCHAR, LogicalType::TABLE }, nullptr,
+                                 RfcInvokeEachBind, RfcInvokeEachInitGlobalState, RfcInvokeEachInitLocalState);
+        fun.in_out_function = RfcInvokeEachFunction;
+        fun.named_parameters["path"] = LogicalType::VARCHAR;
+        fun.named_parameters["threads"] = LogicalType::UINTEGER;
+        fun.named_parameters["secret"] = LogicalType::VARCHAR;
+
+        return fun;
+    }
+} // namespace duckdb
@@ -0,0 +1,278 @@
+#include <deque>
+#include <map>
+#include <mutex>
+
+#include "duckdb.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_context_state.hpp"
+
+#include "scanner_invoke_handle.hpp"
+#include "sap_secret.hpp"
+#include "sap_metadata_cache.hpp"
+#include "erpl_tracing.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    // Invocations a DuckDB connection keeps open at once; the oldest is
+    // dropped when a new one is registered.  Each holds its SDK result
+    // buffers and one logon.
+    static constexpr idx_t MAX_INVOCATION_HANDLES = 16;
+
+    /**
+     * One completed call whose results are read by sap_rfc_result.  The SDK
+     * function handle is not thread-safe, so result sets on it are advanced
+     * one chunk at a time under `lock`.
+     */
+    struct RfcInvocationHandle
+    {
+        std::string function_name;
+        std::shared_ptr<RfcConnection> connection;
+        std::shared_ptr<RfcInvocation> invocation;
+        std::mutex lock;
+
+        ~RfcInvocationHandle()
+        {
+            invocation.reset();
+            RfcConnectionPool::Get().Release(std::move(connection));
+        }
+    };
+
+    // The open invocations of one DuckDB connection; they go away with it.
+    class RfcInvocationHandles : public ClientContextState
+    {
+        public:
+            static RfcInvocationHandles &Get(ClientContext &context)
+            {
+                return *context.registered_state->GetOrCreate<RfcInvocationHandles>("erpl_rfc_invocation_handles");
+            }
+
+            std::string Add(std::shared_ptr<RfcInvocationHandle> handle)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                auto name = StringUtil::Format("%s#%llu", handle->function_name, ++last_id);
+                handles[name] = std::move(handle);
+                order.push_back(name);
+                while (order.size() > MAX_INVOCATION_HANDLES) {
+                    handles.erase(order.front());
+                    order.pop_front();
+                }
+                return name;
+            }
+
+            std::shared_ptr<RfcInvocationHandle> Find(const std::string &name)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                auto it = handles.find(name);
+                if (it == handles.end()) {
+                    throw InvalidInputException("Unknown or expired RFC invocation handle '%s'; only the last %llu "
+                                                "sap_rfc_invoke_handle calls of this connection are kept",
+                                                name, MAX_INVOCATION_HANDLES);
+                }
+                return it->second;
+            }
+
+        private:
+            std::mutex lock;
+            std::map<std::string, std::shared_ptr<RfcInvocationHandle>> handles;
+            std::deque<std::string> order;
+            idx_t last_id = 0;
+    };
+
+    // sap_rfc_invoke_handle ---------------------------------------------------
+
+    struct RfcInvokeHandleBindData : public TableFunctionData
+    {
+        RfcAuthParams auth_params;
+        std::string func_name;
+        std::vector<Value> func_args;
+        std::vector<std::string> result_names;
+    };
+
+    /**
+     * @brief Binds `sap_rfc_invoke_handle(function_name, ...args)`.
+     *
+     * Arguments are validated like sap_rfc_invoke's; the call itself is made
+     * once per execution, and its results stay readable through the handle.
+    */
+    static unique_ptr<FunctionData> RfcInvokeHandleBind(ClientContext &context,
+                                                        TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types,
+                                                        vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_invoke_handle");
+
+        auto &inputs = input.inputs;
+        auto bind_data = make_uniq<RfcInvokeHandleBindData>();
+        bind_data->auth_params = GetAuthParamsFromContext(context, input);
+        bind_data->func_name = inputs[0].GetValue<string>();
+        bind_data->func_args = std::vector<Value>(inputs.begin() + 1, inputs.end());
+
+        auto connection = bind_data->auth_params.Connect();
+        {
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data->func_name);
+            bind_data->result_names = func->GetResultNames();
+            auto args = bind_data->func_args;
+            if (!args.empty()) {
+                func->BeginInvocation(args);
+            }
+        }
+        RfcConnectionPool::Get().Release(std::move(connection));
+
+        names = { "handle", "function_name", "result_names" };
+        return_types = { LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::LIST(LogicalType::VARCHAR) };
+
+        return std::move(bind_data);
+    }
+
+    struct RfcInvokeHandleGlobalState : public GlobalTableFunctionState
+    {
+        std::string handle;
+        bool emitted = false;
+    };
+
+    static unique_ptr<GlobalTableFunctionState> RfcInvokeHandleInitGlobalState(ClientContext &context,
+                                                                               TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->CastNoConst<RfcInvokeHandleBindData>();
+        auto global_state = make_uniq<RfcInvokeHandleGlobalState>();
+
+        auto handle = std::make_shared<RfcInvocationHandle>();
+        handle->function_name = StringUtil::Upper(bind_data.func_name);
+        auto connection = bind_data.auth_params.Connect();
+        auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data.func_name);
+        auto args = bind_data.func_args;
+        auto invocation = args.empty() ? func->BeginInvocation() : func->BeginInvocation(args);
+        invocation->Invoke();
+        handle->connection = std::move(connection);
+        handle->invocation = std::move(invocation);
+
+        global_state->handle = RfcInvocationHandles::Get(context).Add(std::move(handle));
+        ERPL_TRACE_INFO_DATA("sap_rfc_invoke_handle", "Invoked " + bind_data.func_name, global_state->handle);
+
+        return std::move(global_state);
+    }
+
+    static void RfcInvokeHandleScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<RfcInvokeHandleBindData>();
+        auto &global_state = data.global_state->Cast<RfcInvokeHandleGlobalState>();
+        if (global_state.emitted) {
+            return;
+        }
+        global_state.emitted = true;
+
+        vector<Value> result_names;
+        for (auto &name : bind_data.result_names) {
+            result_names.emplace_back(name);
+        }
+        output.SetValue(0, 0, Value(global_state.handle));
+        output.SetValue(1, 0, Value(StringUtil::Upper(bind_data.func_name)));
+        output.SetValue(2, 0, Value::LIST(LogicalType::VARCHAR, std::move(result_names)));
+        output.SetCardinality(1);
+    }
+
+    // sap_rfc_result ----------------------------------------------------------
+
+    struct RfcResultBindData : public TableFunctionData
+    {
+        std::string handle;
+        std::string path;
+        std::vector<std::string> result_names;
+    };
+
+    /**
+     * @brief Binds `sap_rfc_result(handle, path)`.
+     *
+     * The schema is that of `sap_rfc_invoke(..., path := path)`; an empty
+     * path reads every result parameter as one row.  It comes from the
+     * stored invocation's function descriptor, so no call is made.
+    */
+    static unique_ptr<FunctionData> RfcResultBind(ClientContext &context,
+                                                  TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types,
+                                                  vector<string> &names)
+    {
+        auto bind_data = make_uniq<RfcResultBindData>();
+        bind_data->handle = input.inputs[0].GetValue<string>();
+        bind_data->path = input.inputs[1].GetValue<string>();
+
+        auto handle = RfcInvocationHandles::Get(context).Find(bind_data->handle);
+        auto schema = RfcResultSet::InferResultSchema(*handle->invocation->GetFunction(), bind_data->path);
+        names = schema.first;
+        return_types = schema.second;
+        if (names.empty()) {
+            throw InvalidInputException("'%s' has no results to read", handle->function_name);
+        }
+        bind_data->result_names = names;
+
+        return std::move(bind_data);
+    }
+
+    struct RfcResultGlobalState : public GlobalTableFunctionState
+    {
+        std::shared_ptr<RfcInvocationHandle> handle;
+        std::shared_ptr<RfcResultSet> result_set;
+        std::vector<std::string> projected_names;
+        std::vector<idx_t> row_id_columns;
+    };
+
+    static unique_ptr<GlobalTableFunctionState> RfcResultInitGlobalState(ClientContext &context,
+                                                                        TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->Cast<RfcResultBindData>();
+        auto global_state = make_uniq<RfcResultGlobalState>();
+
+        for (idx_t i = 0; i < input.column_ids.size(); i++) {
+            auto column_id = input.column_ids[i];
+            if (IsRowIdColumnId(column_id)) {
+                global_state->projected_names.push_back("");
+                global_state->row_id_columns.push_back(i);
+                continue;
+            }
+            global_state->projected_names.push_back(bind_data.result_names[column_id]);
+        }
+
+        // Looked up again: the handle may have been evicted since bind.
+        global_state->handle = RfcInvocationHandles::Get(context).Find(bind_data.handle);
+        std::lock_guard<std::mutex> guard(global_state->handle->lock);
+        global_state->result_set = std::make_shared<RfcResultSet>(global_state->handle->invocation, bind_data.path);
+
+        return std::move(global_state);
+    }
+
+    static void RfcResultScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &global_state = data.global_state->Cast<RfcResultGlobalState>();
+        auto &result_set = global_state.result_set;
+
+        std::lock_guard<std::mutex> guard(global_state.handle->lock);
+        if (!result_set->HasMoreResults()) {
+            return;
+        }
+        result_set->FetchNextResult(output, global_state.projected_names);
+        for (auto col_idx : global_state.row_id_columns) {
+            output.data[col_idx].SetVectorType(VectorType::CONSTANT_VECTOR);
+            ConstantVector::SetNull(output.data[col_idx], true);
+        }
+    }
+
+    TableFunction CreateRfcInvokeHandleScanFunction()
+    {
+        auto fun = TableFunction("sap_rfc_invoke_handle", { LogicalType::VARCHAR }, RfcInvokeHandleScan,
+                                 RfcInvokeHandleBind, RfcInvokeHandleInitGlobalState);
+        fun.varargs = LogicalType::ANY;
+        fun.named_parameters["secret"] = LogicalType::VARCHAR;
+
+        return fun;
+    }
+
+    TableFunction CreateRfcResultScanFunction()
+    {
+        auto fun = TableFunction("sap_rfc_result", { LogicalType::VARCHAR, LogicalType::VARCHAR }, RfcResultScan,
+                                 RfcResultBind, RfcResultInitGlobalState);
+        fun.projection_pushdown = true;
+
+        return fun;
+    }
+} // namespace duckdb
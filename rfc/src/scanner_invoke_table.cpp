@@ -0,0 +1,218 @@
+#include <mutex>
+
+#include "duckdb.hpp"
+
+#include "scanner_invoke_table.hpp"
+#include "sap_secret.hpp"
+#include "sap_metadata_cache.hpp"
+#include "erpl_tracing.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    struct RfcInvokeTableBindData : public TableFunctionData
+    {
+        RfcAuthParams auth_params;
+        std::string func_name;
+        // The TABLES / CHANGING parameter the input relation fills.
+        std::string table_param;
+        // Remaining arguments, as the single STRUCT sap_rfc_invoke takes.
+        std::vector<Value> func_args;
+        std::string path;
+        std::vector<std::string> input_names;
+        std::vector<LogicalType> input_types;
+    };
+
+    static std::shared_ptr<RfcInvocation> BeginTableInvocation(RfcFunction &function, std::vector<Value> args)
+    {
+        return args.empty() ? function.BeginInvocation() : function.BeginInvocation(args);
+    }
+
+    /**
+     * @brief Binds `sap_rfc_invoke_table(function_name, (subquery), parameter := 'T')`.
+     *
+     * Like sap_rfc_invoke, the schema comes from the function descriptor and
+     * no call is made.  The input columns are checked against the fields of
+     * the table parameter here, so a mismatch fails before any row is read.
+    */
+    static unique_ptr<FunctionData> RfcInvokeTableBind(ClientContext &context,
+                                                       TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types,
+                                                       vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_invoke_table");
+
+        auto &named_params = input.named_parameters;
+        auto bind_data = make_uniq<RfcInvokeTableBindData>();
+        bind_data->auth_params = GetAuthParamsFromContext(context, input);
+        bind_data->func_name = input.inputs[0].GetValue<string>();
+        if (named_params.find("parameter") == named_params.end()) {
+            throw std::runtime_error("sap_rfc_invoke_table requires parameter := '<table parameter>'");
+        }
+        bind_data->table_param = StringUtil::Upper(named_params["parameter"].GetValue<string>());
+        if (named_params.find("arguments") != named_params.end()) {
+            auto &arguments = named_params["arguments"];
+            if (arguments.type().id() != LogicalTypeId::STRUCT) {
+                throw std::runtime_error("sap_rfc_invoke_table expects arguments := {...} as a STRUCT");
+            }
+            bind_data->func_args.push_back(arguments);
+        }
+        bind_data->path = named_params.find("path") != named_params.end()
+                            ? named_params["path"].GetValue<string>()
+                            : "";
+        bind_data->input_names = std::vector<std::string>(input.input_table_names.begin(), input.input_table_names.end());
+        bind_data->input_types = std::vector<LogicalType>(input.input_table_types.begin(), input.input_table_types.end());
+
+        auto connection = bind_data->auth_params.Connect();
+        {
+            auto func = RfcMetadataCache::Get().GetFunction(connection, bind_data->func_name);
+            auto param = func->GetParameterInfo(bind_data->table_param);
+            if (param.GetDirection() != RFC_TABLES && param.GetDirection() != RFC_CHANGING) {
+                throw std::runtime_error(StringUtil::Format("Parameter '%s' of '%s' is %s; only TABLES and CHANGING tables take a relation",
+                                                            bind_data->table_param, bind_data->func_name,
+                                                            param.GetDirectionAsString()));
+            }
+            // Both only validate: the column-to-field mapping and the
+            // arguments, against local SDK handles.
+            RfcTableAppender column_check(param.GetRfcType(), bind_data->table_param,
+                                          bind_data->input_names, bind_data->input_types);
+            BeginTableInvocation(*func, bind_data->func_args);
+
+            auto schema = RfcResultSet::InferResultSchema(*func, bind_data->path);
+            names = schema.first;
+            return_types = schema.second;
+        }
+        RfcConnectionPool::Get().Release(std::move(connection));
+
+        return std::move(bind_data);
+    }
+
+    /**
+     * One call per statement, fed by every pipeline thread.
+     *
+     * Threads append their chunks to the same SDK table under `lock`.  The
+     * call is made by whichever thread finalizes last among those that had
+     * started; by then the input is exhausted, because a thread that starts
+     * later finds no input left.  Such a late thread sees `invoked` and
+     * emits nothing.
+     */
+    struct RfcInvokeTableGlobalState : public GlobalTableFunctionState
+    {
+        std::mutex lock;
+        std::shared_ptr<RfcConnection> connection;
+        std::shared_ptr<RfcInvocation> invocation;
+        RFC_TABLE_HANDLE table_handle = nullptr;
+        unique_ptr<RfcTableAppender> appender;
+        idx_t active_threads = 0;
+        bool invoked = false;
+        // False while a call is in flight or after it failed; such a
+        // connection is closed rather than parked.
+        bool reusable = true;
+        std::shared_ptr<RfcResultSet> result_set;
+
+        ~RfcInvokeTableGlobalState() override
+        {
+            result_set.reset();
+            invocation.reset();
+            if (reusable) {
+                RfcConnectionPool::Get().Release(std::move(connection));
+            }
+        }
+    };
+
+    struct RfcInvokeTableLocalState : public LocalTableFunctionState
+    {
+        bool emitting = false;
+    };
+
+    static unique_ptr<GlobalTableFunctionState> RfcInvokeTableInitGlobalState(ClientContext &context,
+                                                                              TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->CastNoConst<RfcInvokeTableBindData>();
+        auto global_state = make_uniq<RfcInvokeTableGlobalState>();
+
+        global_state->connection = bind_data.auth_params.Connect();
+        auto func = RfcMetadataCache::Get().GetFunction(global_state->connection, bind_data.func_name);
+        auto param = func->GetParameterInfo(bind_data.table_param);
+        global_state->invocation = BeginTableInvocation(*func, bind_data.func_args);
+        global_state->table_handle = global_state->invocation->GetTableParameter(bind_data.table_param);
+        global_state->appender = make_uniq<RfcTableAppender>(param.GetRfcType(), bind_data.table_param,
+                                                             bind_data.input_names, bind_data.input_types);
+
+        return std::move(global_state);
+    }
+
+    static unique_ptr<LocalTableFunctionState> RfcInvokeTableInitLocalState(ExecutionContext &context,
+                                                                            TableFunctionInitInput &input,
+                                                                            GlobalTableFunctionState *global_state)
+    {
+        auto &gstate = global_state->Cast<RfcInvokeTableGlobalState>();
+        std::lock_guard<std::mutex> guard(gstate.lock);
+        gstate.active_threads++;
+        return make_uniq<RfcInvokeTableLocalState>();
+    }
+
+    static OperatorResultType RfcInvokeTableFunction(ExecutionContext &context,
+                                                     TableFunctionInput &data,
+                                                     DataChunk &input,
+                                                     DataChunk &output)
+    {
+        auto &global_state = data.global_state->Cast<RfcInvokeTableGlobalState>();
+        {
+            std::lock_guard<std::mutex> guard(global_state.lock);
+            global_state.appender->Append(global_state.table_handle, input);
+        }
+        output.SetCardinality(0);
+        return OperatorResultType::NEED_MORE_INPUT;
+    }
+
+    static OperatorFinalizeResultType RfcInvokeTableFinal(ExecutionContext &context,
+                                                          TableFunctionInput &data,
+                                                          DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<RfcInvokeTableBindData>();
+        auto &global_state = data.global_state->Cast<RfcInvokeTableGlobalState>();
+        auto &local_state = data.local_state->Cast<RfcInvokeTableLocalState>();
+
+        if (!local_state.emitting) {
+            std::lock_guard<std::mutex> guard(global_state.lock);
+            global_state.active_threads--;
+            if (global_state.active_threads > 0 || global_state.invoked) {
+                return OperatorFinalizeResultType::FINISHED;
+            }
+
+            global_state.invoked = true;
+            global_state.reusable = false;
+            ERPL_TRACE_INFO_DATA("sap_rfc_invoke_table", "Invoking " + bind_data.func_name,
+                                 StringUtil::Format("%llu rows in %s", global_state.appender->RowCount(),
+                                                    bind_data.table_param));
+            global_state.result_set = bind_data.path.empty()
+                                        ? global_state.invocation->Invoke()
+                                        : global_state.invocation->Invoke(bind_data.path);
+            global_state.reusable = true;
+            local_state.emitting = true;
+        }
+
+        auto &result_set = global_state.result_set;
+        if (!result_set->HasMoreResults()) {
+            return OperatorFinalizeResultType::FINISHED;
+        }
+        result_set->FetchNextResult(output);
+        return result_set->HasMoreResults() ? OperatorFinalizeResultType::HAVE_MORE_OUTPUT
+                                            : OperatorFinalizeResultType::FINISHED;
+    }
+
+    TableFunction CreateRfcInvokeTableScanFunction()
+    {
+        auto fun = TableFunction("sap_rfc_invoke_table", { LogicalType::VARCHAR, LogicalType::TABLE }, nullptr,
+                                 RfcInvokeTableBind, RfcInvokeTableInitGlobalState, RfcInvokeTableInitLocalState);
+        fun.in_out_function = RfcInvokeTableFunction;
+        fun.in_out_function_final = RfcInvokeTableFinal;
+        fun.named_parameters["parameter"] = LogicalType::VARCHAR;
+        fun.named_parameters["arguments"] = LogicalType::ANY;
+        fun.named_parameters["path"] = LogicalType::VARCHAR;
+        fun.named_parameters["secret"] = LogicalType::VARCHAR;
+
+        return fun;
+    }
+} // namespace duckdb
@@ -9,6 +9,9 @@
 #include "scanner_read_table.hpp"
 #include "duckdb_argument_helper.hpp"
 #include "sap_rfc.hpp"
+#include "sap_shared_scan.hpp"
+#include "sap_scan_history.hpp"
+#include "erpl_tracing.hpp"
 #include "telemetry.hpp"
 #include "erpl_telemetry.hpp"
 
@@ -35,6 +38,15 @@ namespace duckdb
         auto limit = named_params.find("MAX_ROWS") != named_params.end() 
                                     ? named_params["MAX_ROWS"].GetValue<unsigned int>()
                                     : 0;
+        auto row_offset = named_params.find("ROW_OFFSET") != named_params.end()
+                                    ? named_params["ROW_OFFSET"].GetValue<unsigned int>()
+                                    : 0;
+        if (row_offset % RfcReadColumnStateMachine::MAX_BATCH_SIZE != 0 ||
+            (row_offset > 0 && limit % RfcReadColumnStateMachine::MAX_BATCH_SIZE != 0)) {
+            // RFC_READ_TABLE rejects a ROWSKIPS that is not a multiple of ROWCOUNT.
+            throw InvalidInputException("ROW_OFFSET must be a multiple of %u, and MAX_ROWS with it too",
+                                        RfcReadColumnStateMachine::MAX_BATCH_SIZE);
+        }
         auto where_clause = named_params.find("FILTER") != named_params.end() 
                                 ? named_params["FILTER"].ToString()
                                 : "";
@@ -60,6 +72,7 @@ namespace duckdb
         if (!secret_name.empty()) {
             bind_data->SetSecretName(secret_name);
         }
+        bind_data->row_offset = row_offset;
         bind_data->InitOptionsFromWhereClause(where_clause);
         try {
             bind_data->InitAndVerifyFields(fields);
@@ -77,16 +90,141 @@ namespace duckdb
         return std::move(bind_data);
     }
 
+    // Destroyed when the pipeline is torn down — also when DuckDB stops
+    // pulling early (LIMIT satisfied) or the query is interrupted — which
+    // is the earliest point the scan's connections can go back to the pool.
+    struct RfcReadTableGlobalState : public GlobalTableFunctionState
+    {
+        RfcReadTableGlobalState(ClientContext &context, RfcReadTableBindData &bind_data)
+            : bind_data(bind_data), fs(FileSystem::GetFileSystem(context)), started(std::chrono::steady_clock::now()) {}
+        ~RfcReadTableGlobalState() override
+        {
+            RecordHistory();
+            if (shared_scan) {
+                if (producer) {
+                    shared_scan->Abandon();
+                } else {
+                    shared_scan->Leave(reader_id);
+                }
+            }
+            try {
+                bind_data.FinishScan();
+            } catch (...) {
+                // best-effort; connections are closed with the bind data.
+            }
+        }
+
+        void RecordHistory()
+        {
+            if (history_system.empty()) {
+                return;
+            }
+            RfcScanRecord record;
+            record.finished_at_ms = RfcScanHistory::NowMs();
+            record.function = "sap_read_table";
+            record.status = bind_data.IsCancelled() ? "cancelled" : finished ? "complete" : "stopped";
+            record.source = shared_scan && !producer ? "shared" : "extracted";
+            record.system = history_system;
+            record.object = RfcScanHistory::ObjectFingerprint(bind_data.table_name);
+            record.duration_ms = RfcReadTableStats::MicrosecondsSince(started) / 1000.0;
+            record.rows = rows_output;
+            auto &stats = bind_data.stats;
+            record.payload_bytes = stats.payload_bytes;
+            record.rfc_calls = stats.rfc_calls;
+            record.rfc_time_ms = stats.rfc_time_us / 1000.0;
+            record.retries = stats.retries;
+            record.connections_opened = stats.connections_opened;
+            record.connections_reused = stats.connections_reused;
+            record.columns = history_columns;
+            record.threads = bind_data.max_threads;
+            record.max_batch_rows = stats.max_batch_rows;
+            RfcScanHistory::Append(fs, record);
+        }
+
+        RfcReadTableBindData &bind_data;
+        // The query's file system, which writes the scan history.
+        FileSystem &fs;
+        std::chrono::steady_clock::time_point started;
+        // Fingerprint of the SAP system while the scan history is on, empty
+        // otherwise.
+        std::string history_system;
+        idx_t history_columns = 0;
+        // All rows returned, and whether the scan ran to its end; for the
+        // scan history.
+        idx_t rows_output = 0;
+        bool finished = false;
+
+        // Set when an identical scan of another session is shared: this one
+        // either produces it or reads it (see RfcSharedScan).
+        std::shared_ptr<RfcSharedScan> shared_scan;
+        bool producer = false;
+        idx_t reader_id = DConstants::INVALID_INDEX;
+        // Rows a reader returned from the shared scan.
+        idx_t rows_returned = 0;
+    };
+
+    // The projection in output order, as part of the shared-scan key.
+    static std::vector<std::string> DescribeProjection(RfcReadTableBindData &bind_data,
+                                                       const vector<column_t> &column_ids)
+    {
+        auto names = bind_data.GetRfcColumnNames();
+        auto types = bind_data.GetReturnTypes();
+        std::vector<std::string> columns;
+        for (auto column_id : column_ids) {
+            if (IsRowIdColumnId(column_id)) {
+                columns.push_back("rowid");
+            } else {
+                columns.push_back(names[column_id] + " " + types[column_id].ToString());
+            }
+        }
+        return columns;
+    }
+
+    // The scan's connection parameters; false if its secret is missing,
+    // which the scan itself reports.
+    static bool TryGetAuthParams(ClientContext &context, RfcReadTableBindData &bind_data, RfcAuthParams &auth_params)
+    {
+        try {
+            auto &secret_name = bind_data.GetSecretName();
+            auth_params = secret_name.empty() ? RfcAuthParams::FromContext(context)
+                                              : RfcAuthParams::FromContext(context, secret_name);
+            return true;
+        } catch (std::exception &) {
+            return false;
+        }
+    }
+
+    static std::string SharedScanSystem(ClientContext &context, RfcReadTableBindData &bind_data)
+    {
+        // Without parameters the scan just runs unshared.
+        RfcAuthParams auth_params;
+        return TryGetAuthParams(context, bind_data, auth_params) ? auth_params.PoolKey() : std::string();
+    }
+
     static unique_ptr<GlobalTableFunctionState> RfcReadTableInitGlobalState(ClientContext &context,
                                                                             TableFunctionInitInput &input) 
     {
         auto &bind_data = input.bind_data->CastNoConst<RfcReadTableBindData>();
         auto column_ids = input.column_ids;
 
+        bind_data.BeginScan();
         bind_data.ActivateColumns(column_ids);
         bind_data.AddOptionsFromFilters(input.filters);
 
-        return make_uniq<GlobalTableFunctionState>();
+        auto global_state = make_uniq<RfcReadTableGlobalState>(context, bind_data);
+        RfcAuthParams auth_params;
+        if (!GetRfcScanHistoryPath().empty() && TryGetAuthParams(context, bind_data, auth_params)) {
+            global_state->history_system = auth_params.SystemFingerprint();
+            global_state->history_columns = column_ids.size();
+        }
+        if (GetRfcSharedScanBuffer() > 0) {
+            auto key = RfcSharedScan::Key(SharedScanSystem(context, bind_data), bind_data,
+                                          DescribeProjection(bind_data, column_ids));
+            global_state->shared_scan = RfcSharedScan::Join(key, context, global_state->producer,
+                                                            global_state->reader_id);
+        }
+
+        return std::move(global_state);
     }
 
     static void RfcReadTableScan(ClientContext &context, 
@@ -94,7 +232,40 @@ namespace duckdb
                                  DataChunk &output) 
     {
         auto &bind_data = data.bind_data->CastNoConst<RfcReadTableBindData>();
+        auto &global_state = data.global_state->Cast<RfcReadTableGlobalState>();
+
+        if (global_state.shared_scan && !global_state.producer) {
+            auto result = global_state.shared_scan->Read(context, global_state.reader_id, output);
+            if (result == RfcSharedScan::ReadResult::CHUNK) {
+                global_state.rows_returned += output.size();
+                global_state.rows_output += output.size();
+                return;
+            }
+            if (result == RfcSharedScan::ReadResult::FINISHED) {
+                global_state.finished = true;
+                return;
+            }
+            // RFC_READ_TABLE does not promise the same row order on every
+            // call, so the rows already returned cannot be found again in an
+            // extraction of our own.  Only a reader that has returned nothing
+            // yet can start over on its own.
+            if (global_state.rows_returned > 0) {
+                throw IOException("The shared scan of '%s' stopped after this query had read %llu of its rows, "
+                                  "and RFC_READ_TABLE cannot resume at a row; run the query again, or turn "
+                                  "sharing off with SET erpl_rfc_shared_scan_buffer = 0",
+                                  bind_data.table_name, global_state.rows_returned);
+            }
+            ERPL_TRACE_DEBUG("sap_rfc", StringUtil::Format("Shared scan of '%s' left before its first row; reading alone",
+                                                           bind_data.table_name));
+            global_state.shared_scan.reset();
+        }
+
         if (! bind_data.HasMoreResults()) {
+            global_state.finished = true;
+            if (global_state.producer) {
+                global_state.shared_scan->Finish();
+            }
+            bind_data.FinishScan();
 #ifdef __GLIBC__
             // Scan finished: per-column SDK handles were released at FINISHED
             // and the streaming reader holds no whole-batch buffers, so hand
@@ -106,7 +277,14 @@ namespace duckdb
         }
 
         //printf(">> RfcReadTableScan\n");
+        if (global_state.producer) {
+            global_state.shared_scan->BeginStep();
+        }
         bind_data.Step(context, output);
+        global_state.rows_output += output.size();
+        if (global_state.producer) {
+            global_state.shared_scan->Publish(output);
+        }
     }
 
     double RfcReadTableProgress(ClientContext &, const FunctionData *func_data, const GlobalTableFunctionState *)
@@ -119,6 +297,30 @@ namespace duckdb
         return progress;
     }
 
+    static InsertionOrderPreservingMap<string> RfcReadTableToString(TableFunctionToStringInput &input)
+    {
+        auto &bind_data = input.bind_data->CastNoConst<RfcReadTableBindData>();
+        return bind_data.ExplainParams(false);
+    }
+
+    // EXPLAIN ANALYZE: the plan as executed — with the pushed-down filters
+    // and the read function a fallback may have switched to — and what the
+    // scan cost.
+    static InsertionOrderPreservingMap<string> RfcReadTableDynamicToString(TableFunctionDynamicToStringInput &input)
+    {
+        auto &bind_data = input.bind_data->CastNoConst<RfcReadTableBindData>();
+        auto result = bind_data.ExplainParams(true);
+        if (input.global_state) {
+            auto &global_state = input.global_state->Cast<RfcReadTableGlobalState>();
+            if (global_state.producer) {
+                result["Shared Scan"] = "producer";
+            } else if (global_state.reader_id != DConstants::INVALID_INDEX) {
+                result["Shared Scan"] = StringUtil::Format("reader, %llu rows shared", global_state.rows_returned);
+            }
+        }
+        return result;
+    }
+
     TableFunction CreateRfcReadTableScanFunction() 
     {
         auto fun = TableFunction("sap_read_table", { LogicalType::VARCHAR }, 
@@ -129,10 +331,13 @@ namespace duckdb
         fun.named_parameters["COLUMNS"] = LogicalType::LIST(LogicalType::VARCHAR);
         fun.named_parameters["FILTER"] = LogicalType::VARCHAR;
         fun.named_parameters["MAX_ROWS"] = LogicalType::UINTEGER;
+        fun.named_parameters["ROW_OFFSET"] = LogicalType::UINTEGER;
         fun.named_parameters["READ_TABLE_FUNCTION"] = LogicalType::VARCHAR;
         fun.named_parameters["READ_TABLE_DELIMITER"] = LogicalType::VARCHAR;
         fun.named_parameters["SECRET"] = LogicalType::VARCHAR;
         fun.table_scan_progress = RfcReadTableProgress;
+        fun.to_string = RfcReadTableToString;
+        fun.dynamic_to_string = RfcReadTableDynamicToString;
         fun.projection_pushdown = true;
         fun.filter_pushdown = true;
 
@@ -0,0 +1,331 @@
+#include "duckdb.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/pending_query_result.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+
+#include <chrono>
+
+#include "scanner_read_table_incremental.hpp"
+#include "duckdb_argument_helper.hpp"
+#include "sap_connection.hpp"
+#include "sap_rfc.hpp"
+#include "sap_secret.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    static constexpr const char *DEFAULT_WATERMARK_STATE_TABLE = "erpl_watermarks";
+
+    struct RfcReadTableIncrementalBindData : public TableFunctionData
+    {
+        string table_name;
+        string target_table;
+        string state_table;
+        string watermark_column;
+        LogicalType watermark_type;
+        string filter;
+        string secret_name;
+        unsigned int threads = 0;
+
+        vector<string> column_names;
+        vector<LogicalType> column_types;
+        vector<string> key_columns;
+    };
+
+    struct RfcReadTableIncrementalGlobalState : public GlobalTableFunctionState
+    {
+        bool done = false;
+    };
+
+    // `name` or `schema.name` or `catalog.schema.name`, each part quoted.
+    static string QuoteQualifiedName(const string &name)
+    {
+        auto qualified = QualifiedName::Parse(name);
+        string result;
+        if (!qualified.catalog.empty()) {
+            result += SQLIdentifier(qualified.catalog) + ".";
+        }
+        if (!qualified.schema.empty()) {
+            result += SQLIdentifier(qualified.schema) + ".";
+        }
+        return result + SQLIdentifier(qualified.name);
+    }
+
+    /**
+     * @brief Runs `sql` on the load's own connection task by task, and
+     *        forwards an interrupt of the calling query to it.
+    */
+    static unique_ptr<MaterializedQueryResult> RunIncrementalQuery(ClientContext &context, Connection &conn,
+                                                                   const string &sql)
+    {
+        auto pending = conn.PendingQuery(sql);
+        if (pending->HasError()) {
+            throw std::runtime_error(pending->GetError());
+        }
+        auto interrupted = false;
+        PendingExecutionResult state;
+        do {
+            if (!interrupted && context.interrupted.load()) {
+                conn.Interrupt();
+                interrupted = true;
+            }
+            state = pending->ExecuteTask();
+            if (state == PendingExecutionResult::BLOCKED || state == PendingExecutionResult::NO_TASKS_AVAILABLE) {
+                pending->WaitForTask();
+            }
+        } while (!PendingQueryResult::IsResultReady(state));
+        if (interrupted) {
+            throw InterruptException();
+        }
+        if (state == PendingExecutionResult::EXECUTION_ERROR) {
+            throw std::runtime_error(pending->GetError());
+        }
+        auto result = pending->Execute();
+        if (result->HasError()) {
+            throw std::runtime_error(result->GetError());
+        }
+        return unique_ptr_cast<QueryResult, MaterializedQueryResult>(std::move(result));
+    }
+
+    /**
+     * @brief Renders a watermark as a literal for the ABAP where clause of
+     *        RFC_READ_TABLE: DATS and TIMS in their internal YYYYMMDD and
+     *        HHMMSS form, numbers (e.g. the DEC timestamps of TIMESTAMP
+     *        fields) bare, everything else quoted.
+    */
+    static string WatermarkToAbapLiteral(const Value &watermark)
+    {
+        switch (watermark.type().id()) {
+            case LogicalTypeId::DATE: {
+                int32_t year, month, day;
+                Date::Convert(watermark.GetValue<date_t>(), year, month, day);
+                return StringUtil::Format("'%04d%02d%02d'", year, month, day);
+            }
+            case LogicalTypeId::TIME: {
+                int32_t hour, minute, second, micros;
+                Time::Convert(watermark.GetValue<dtime_t>(), hour, minute, second, micros);
+                return StringUtil::Format("'%02d%02d%02d'", hour, minute, second);
+            }
+            case LogicalTypeId::TINYINT:
+            case LogicalTypeId::SMALLINT:
+            case LogicalTypeId::INTEGER:
+            case LogicalTypeId::BIGINT:
+            case LogicalTypeId::UTINYINT:
+            case LogicalTypeId::USMALLINT:
+            case LogicalTypeId::UINTEGER:
+            case LogicalTypeId::UBIGINT:
+            case LogicalTypeId::HUGEINT:
+            case LogicalTypeId::DECIMAL:
+            case LogicalTypeId::FLOAT:
+            case LogicalTypeId::DOUBLE:
+                return watermark.ToString();
+            default:
+                return KeywordHelper::WriteQuoted(watermark.ToString());
+        }
+    }
+
+    /**
+     * @brief Binds `sap_read_table_incremental(table, watermark_column := ...)`.
+     *        The DDIC definition is read here: the watermark column must
+     *        exist and the table must have key fields to upsert by.
+    */
+    static unique_ptr<FunctionData> RfcReadTableIncrementalBind(ClientContext &context,
+                                                                TableFunctionBindInput &input,
+                                                                vector<LogicalType> &return_types,
+                                                                vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_read_table_incremental");
+
+        auto &named_params = input.named_parameters;
+        auto bind_data = make_uniq<RfcReadTableIncrementalBindData>();
+        bind_data->table_name = StringUtil::Upper(input.inputs[0].ToString());
+
+        if (named_params.find("WATERMARK_COLUMN") == named_params.end()) {
+            throw InvalidInputException("sap_read_table_incremental requires WATERMARK_COLUMN, e.g. "
+                                        "watermark_column := 'AEDAT'");
+        }
+        bind_data->watermark_column = StringUtil::Upper(named_params["WATERMARK_COLUMN"].ToString());
+        bind_data->target_table = named_params.find("TARGET") != named_params.end()
+                                      ? named_params["TARGET"].ToString()
+                                      : StringUtil::Lower(bind_data->table_name);
+        bind_data->state_table = named_params.find("STATE") != named_params.end()
+                                     ? named_params["STATE"].ToString()
+                                     : DEFAULT_WATERMARK_STATE_TABLE;
+        bind_data->filter = named_params.find("FILTER") != named_params.end()
+                                ? named_params["FILTER"].ToString()
+                                : "";
+        bind_data->secret_name = named_params.find("SECRET") != named_params.end()
+                                     ? named_params["SECRET"].ToString()
+                                     : "";
+        bind_data->threads = named_params.find("THREADS") != named_params.end()
+                                 ? named_params["THREADS"].GetValue<unsigned int>()
+                                 : 0;
+
+        auto auth_params = GetAuthParamsFromContext(context, input);
+        auto connection = auth_params.Connect();
+        auto field_metas = RfcReadTableBindData::GetTableFieldMetas(connection, bind_data->table_name);
+        RfcConnectionPool::Get().Release(std::move(connection));
+
+        if (field_metas.empty()) {
+            throw std::runtime_error(StringUtil::Format("Table '%s' has no fields in the DDIC", bind_data->table_name));
+        }
+        RfcReadTableBindData::GetSchemaForFieldMetas(field_metas, bind_data->column_names, bind_data->column_types);
+
+        for (idx_t i = 0; i < field_metas.size(); i++) {
+            auto helper = ValueHelper(field_metas[i]);
+            if (helper["KEYFLAG"].ToString() == "X") {
+                bind_data->key_columns.push_back(bind_data->column_names[i]);
+            }
+            if (bind_data->column_names[i] == bind_data->watermark_column) {
+                bind_data->watermark_type = bind_data->column_types[i];
+            }
+        }
+        if (bind_data->watermark_type.id() == LogicalTypeId::INVALID) {
+            throw InvalidInputException("Watermark column '%s' is not a field of '%s'",
+                                        bind_data->watermark_column, bind_data->table_name);
+        }
+        if (bind_data->key_columns.empty()) {
+            throw InvalidInputException("Table '%s' has no key fields to merge by; use sap_read_table for a "
+                                        "full load instead", bind_data->table_name);
+        }
+
+        names = { "table_name", "target_table", "watermark_column", "previous_watermark", "new_watermark",
+                  "rows_merged", "duration_ms" };
+        return_types = { LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                         LogicalType::VARCHAR, LogicalType::BIGINT, LogicalType::BIGINT };
+
+        return std::move(bind_data);
+    }
+
+    static unique_ptr<GlobalTableFunctionState> RfcReadTableIncrementalInitGlobalState(ClientContext &context,
+                                                                                       TableFunctionInitInput &input)
+    {
+        return make_uniq<RfcReadTableIncrementalGlobalState>();
+    }
+
+    /**
+     * @brief Runs one delta load on a connection of its own:
+     *
+     *   1. read the last watermark of (table, target) from the state table;
+     *   2. read the rows with `watermark_column >= watermark` from SAP — the
+     *      whole table on the first run — and upsert them into the target by
+     *      the DDIC key;
+     *   3. store max(watermark_column) of the target as the new watermark.
+     *
+     * Steps 2 and 3 share one transaction, so the watermark never moves past
+     * rows that were not merged.  It is the nested connection's, not the
+     * caller's: the load commits even if the calling transaction rolls back.
+     * `>=` rather than `>` re-reads the rows at the watermark itself: a date
+     * watermark like AEDAT is hit again by later changes on the same day.
+     * The upsert keeps the target free of duplicates, but rows_merged counts
+     * the re-read rows again.
+    */
+    static void RfcReadTableIncrementalScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &bind_data = data.bind_data->Cast<RfcReadTableIncrementalBindData>();
+        auto &global_state = data.global_state->Cast<RfcReadTableIncrementalGlobalState>();
+        if (global_state.done) {
+            return;
+        }
+        global_state.done = true;
+
+        auto started = std::chrono::steady_clock::now();
+        auto target = QuoteQualifiedName(bind_data.target_table);
+        auto state = QuoteQualifiedName(bind_data.state_table);
+        auto watermark_column = SQLIdentifier(bind_data.watermark_column);
+
+        Connection conn(*context.db);
+        RunIncrementalQuery(context, conn, StringUtil::Format(
+            "CREATE TABLE IF NOT EXISTS %s (table_name VARCHAR, target_table VARCHAR, watermark_column VARCHAR, "
+            "watermark VARCHAR, updated_at TIMESTAMP, PRIMARY KEY (table_name, target_table))", state));
+        auto previous = RunIncrementalQuery(context, conn, StringUtil::Format(
+            "SELECT watermark_column, watermark FROM %s WHERE table_name = %s AND target_table = %s", state,
+            SQLString(bind_data.table_name), SQLString(bind_data.target_table)));
+
+        Value previous_watermark(LogicalType::VARCHAR);
+        if (previous->RowCount() > 0) {
+            auto stored_column = previous->GetValue(0, 0).ToString();
+            if (stored_column != bind_data.watermark_column) {
+                throw InvalidInputException("'%s' was loaded into '%s' by watermark column '%s', not '%s'; delete "
+                                            "its row from '%s' to start over", bind_data.table_name,
+                                            bind_data.target_table, stored_column, bind_data.watermark_column,
+                                            bind_data.state_table);
+            }
+            previous_watermark = previous->GetValue(1, 0);
+        }
+
+        auto where_clause = bind_data.filter;
+        if (!previous_watermark.IsNull()) {
+            auto watermark = previous_watermark.DefaultCastAs(bind_data.watermark_type);
+            auto delta = StringUtil::Format("%s >= %s", bind_data.watermark_column, WatermarkToAbapLiteral(watermark));
+            where_clause = where_clause.empty() ? delta : StringUtil::Format("( %s ) AND %s", where_clause, delta);
+        }
+
+        auto source = StringUtil::Format("sap_read_table(%s", SQLString(bind_data.table_name));
+        if (!where_clause.empty()) {
+            source += StringUtil::Format(", filter=%s", SQLString(where_clause));
+        }
+        if (bind_data.threads > 0) {
+            source += StringUtil::Format(", threads=%u", bind_data.threads);
+        }
+        if (!bind_data.secret_name.empty()) {
+            source += StringUtil::Format(", secret=%s", SQLString(bind_data.secret_name));
+        }
+        source += ")";
+
+        vector<string> column_defs;
+        for (idx_t i = 0; i < bind_data.column_names.size(); i++) {
+            column_defs.push_back(SQLIdentifier(bind_data.column_names[i]) + " " + bind_data.column_types[i].ToString());
+        }
+        vector<string> keys;
+        for (auto &key : bind_data.key_columns) {
+            keys.push_back(SQLIdentifier(key));
+        }
+
+        RunIncrementalQuery(context, conn, "BEGIN TRANSACTION");
+        // An existing target must already have the DDIC key as its primary
+        // key; INSERT OR REPLACE fails otherwise.
+        RunIncrementalQuery(context, conn, StringUtil::Format("CREATE TABLE IF NOT EXISTS %s (%s, PRIMARY KEY (%s))", target,
+                                                     StringUtil::Join(column_defs, ", "), StringUtil::Join(keys, ", ")));
+        auto merged = RunIncrementalQuery(context, conn, StringUtil::Format("INSERT OR REPLACE INTO %s BY NAME SELECT * FROM %s",
+                                                                   target, source));
+        auto rows_merged = merged->GetValue(0, 0).GetValue<int64_t>();
+        auto new_max = RunIncrementalQuery(context, conn, StringUtil::Format("SELECT max(%s)::VARCHAR FROM %s",
+                                                                    watermark_column, target));
+        auto new_watermark = new_max->GetValue(0, 0);
+        if (!new_watermark.IsNull()) {
+            RunIncrementalQuery(context, conn, StringUtil::Format(
+                "INSERT OR REPLACE INTO %s VALUES (%s, %s, %s, %s, current_timestamp::TIMESTAMP)", state,
+                SQLString(bind_data.table_name), SQLString(bind_data.target_table),
+                SQLString(bind_data.watermark_column), SQLString(new_watermark.ToString())));
+        }
+        RunIncrementalQuery(context, conn, "COMMIT");
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        output.SetValue(0, 0, Value(bind_data.table_name));
+        output.SetValue(1, 0, Value(bind_data.target_table));
+        output.SetValue(2, 0, Value(bind_data.watermark_column));
+        output.SetValue(3, 0, previous_watermark);
+        output.SetValue(4, 0, new_watermark);
+        output.SetValue(5, 0, Value::BIGINT(rows_merged));
+        output.SetValue(6, 0, Value::BIGINT(elapsed.count()));
+        output.SetCardinality(1);
+    }
+
+    TableFunction CreateRfcReadTableIncrementalScanFunction()
+    {
+        auto fun = TableFunction("sap_read_table_incremental", { LogicalType::VARCHAR },
+                                 RfcReadTableIncrementalScan,
+                                 RfcReadTableIncrementalBind,
+                                 RfcReadTableIncrementalInitGlobalState);
+        fun.named_parameters["WATERMARK_COLUMN"] = LogicalType::VARCHAR;
+        fun.named_parameters["TARGET"] = LogicalType::VARCHAR;
+        fun.named_parameters["STATE"] = LogicalType::VARCHAR;
+        fun.named_parameters["FILTER"] = LogicalType::VARCHAR;
+        fun.named_parameters["THREADS"] = LogicalType::UINTEGER;
+        fun.named_parameters["SECRET"] = LogicalType::VARCHAR;
+
+        return fun;
+    }
+} // namespace duckdb
@@ -0,0 +1,148 @@
+#include "duckdb.hpp"
+
+#include "scanner_replica_status.hpp"
+#include "sap_replica.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    struct SapReplicaRefreshBindData : public TableFunctionData
+    {
+        std::string database_name;
+    };
+
+    struct SapReplicaStatusGlobalState : public GlobalTableFunctionState
+    {
+        std::vector<std::vector<Value>> rows;
+        idx_t emitted = 0;
+    };
+
+    static void SetStatusColumns(vector<LogicalType> &return_types, vector<string> &names)
+    {
+        names = { "database_name", "table_name", "replica_table", "replica_path", "loaded", "refreshed_at",
+                  "staleness", "row_count", "refresh_ms", "refreshing", "next_refresh_at", "last_error" };
+        return_types = { LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                         LogicalType::BOOLEAN, LogicalType::TIMESTAMP, LogicalType::INTERVAL, LogicalType::BIGINT,
+                         LogicalType::BIGINT, LogicalType::BOOLEAN, LogicalType::TIMESTAMP, LogicalType::VARCHAR };
+    }
+
+    static void AppendStatusRows(SapReplica &replica, std::vector<std::vector<Value>> &rows)
+    {
+        auto now = Timestamp::GetCurrentTimestamp();
+        for (auto &status : replica.Status()) {
+            auto replica_table = StringUtil::Format("%s.main.%s", SQLIdentifier(replica.ReplicaName()),
+                                                    SQLIdentifier(status.table_name));
+            // A table never loaded has no age; reads still go to SAP.
+            auto refreshed_at = status.loaded ? Value::TIMESTAMP(status.refreshed_at) : Value(LogicalType::TIMESTAMP);
+            auto staleness = status.loaded
+                                ? Value::INTERVAL(Interval::FromMicro(now.value - status.refreshed_at.value))
+                                : Value(LogicalType::INTERVAL);
+            auto row_count = status.loaded ? Value::BIGINT(status.row_count) : Value(LogicalType::BIGINT);
+            auto last_error = status.last_error.empty() ? Value(LogicalType::VARCHAR) : Value(status.last_error);
+
+            rows.push_back({ Value(replica.CatalogName()), Value(status.table_name),
+                             Value(replica_table), Value(replica.Path()),
+                             Value::BOOLEAN(status.loaded), refreshed_at, staleness, row_count,
+                             Value::BIGINT(status.refresh_ms), Value::BOOLEAN(status.refreshing),
+                             Value::TIMESTAMP(status.next_refresh_at), last_error });
+        }
+    }
+
+    static std::shared_ptr<SapReplica> FindReplica(const std::string &database_name)
+    {
+        for (auto &replica : SapReplica::All()) {
+            if (StringUtil::CIEquals(replica->CatalogName(), database_name) && !replica->Stopped()) {
+                return replica;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Binds `sap_replica_status()`: one row per table mirrored by an
+     *        ATTACH ... (CACHE ...) catalog of this process.
+    */
+    static unique_ptr<FunctionData> SapReplicaStatusBind(ClientContext &context,
+                                                         TableFunctionBindInput &input,
+                                                         vector<LogicalType> &return_types,
+                                                         vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_replica_status");
+
+        SetStatusColumns(return_types, names);
+        return make_uniq<TableFunctionData>();
+    }
+
+    static unique_ptr<GlobalTableFunctionState> SapReplicaStatusInitGlobalState(ClientContext &context,
+                                                                               TableFunctionInitInput &input)
+    {
+        auto global_state = make_uniq<SapReplicaStatusGlobalState>();
+        for (auto &replica : SapReplica::All()) {
+            AppendStatusRows(*replica, global_state->rows);
+        }
+        return std::move(global_state);
+    }
+
+    /**
+     * @brief Binds `sap_replica_refresh(database_name)`, which reloads every
+     *        table of one replica now and returns its sap_replica_status() rows.
+    */
+    static unique_ptr<FunctionData> SapReplicaRefreshBind(ClientContext &context,
+                                                          TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types,
+                                                          vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_replica_refresh");
+
+        auto bind_data = make_uniq<SapReplicaRefreshBindData>();
+        bind_data->database_name = input.inputs[0].GetValue<string>();
+        if (!FindReplica(bind_data->database_name)) {
+            throw BinderException("'%s' is not a SAP catalog attached with CACHE", bind_data->database_name);
+        }
+
+        SetStatusColumns(return_types, names);
+        return std::move(bind_data);
+    }
+
+    static unique_ptr<GlobalTableFunctionState> SapReplicaRefreshInitGlobalState(ClientContext &context,
+                                                                                TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->Cast<SapReplicaRefreshBindData>();
+        auto replica = FindReplica(bind_data.database_name);
+        if (!replica) {
+            throw InvalidInputException("'%s' is not a SAP catalog attached with CACHE", bind_data.database_name);
+        }
+        replica->RefreshNow(context);
+
+        auto global_state = make_uniq<SapReplicaStatusGlobalState>();
+        AppendStatusRows(*replica, global_state->rows);
+        return std::move(global_state);
+    }
+
+    static void SapReplicaStatusScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &global_state = data.global_state->Cast<SapReplicaStatusGlobalState>();
+
+        idx_t out_idx = 0;
+        while (global_state.emitted < global_state.rows.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &row = global_state.rows[global_state.emitted++];
+            for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, out_idx, row[col_idx]);
+            }
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+    }
+
+    TableFunction CreateSapReplicaStatusScanFunction()
+    {
+        return TableFunction("sap_replica_status", {}, SapReplicaStatusScan, SapReplicaStatusBind,
+                             SapReplicaStatusInitGlobalState);
+    }
+
+    TableFunction CreateSapReplicaRefreshScanFunction()
+    {
+        return TableFunction("sap_replica_refresh", { LogicalType::VARCHAR }, SapReplicaStatusScan,
+                             SapReplicaRefreshBind, SapReplicaRefreshInitGlobalState);
+    }
+} // namespace duckdb
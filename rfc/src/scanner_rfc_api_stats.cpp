@@ -0,0 +1,91 @@
+#include "duckdb.hpp"
+
+#include "scanner_rfc_api_stats.hpp"
+#include "sap_rfc_api.hpp"
+#include "sap_type_conversion.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    struct SapRfcApiStatsGlobalState : public GlobalTableFunctionState
+    {
+        std::vector<std::vector<Value>> rows;
+        idx_t emitted = 0;
+    };
+
+    /**
+     * @brief Binds `sap_rfc_api_stats()`: one row per SDK entry point called
+     *        while `erpl_rfc_api_stats` was on, slowest in total first.
+    */
+    static unique_ptr<FunctionData> SapRfcApiStatsBind(ClientContext &context,
+                                                       TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types,
+                                                       vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_api_stats");
+
+        names = { "entry_point", "calls", "errors", "total_ms", "avg_us", "p50_us", "p95_us", "p99_us", "max_us",
+                  "error_codes" };
+        return_types = { LogicalType::VARCHAR, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::DOUBLE,
+                         LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE,
+                         LogicalType::DOUBLE, LogicalType::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT) };
+
+        return make_uniq<TableFunctionData>();
+    }
+
+    static unique_ptr<GlobalTableFunctionState> SapRfcApiStatsInitGlobalState(ClientContext &context,
+                                                                             TableFunctionInitInput &input)
+    {
+        auto global_state = make_uniq<SapRfcApiStatsGlobalState>();
+
+        auto all_stats = GetRfcApiStats();
+        std::sort(all_stats.begin(), all_stats.end(), [](const RfcApiEntryStats &a, const RfcApiEntryStats &b) {
+            return a.total_ns > b.total_ns;
+        });
+
+        for (auto &stats : all_stats) {
+            if (stats.calls == 0) {
+                continue;
+            }
+            vector<Value> codes, counts;
+            for (auto &entry : stats.error_codes) {
+                auto rc = entry.first;
+                codes.push_back(Value(rfcrc2std(rc)));
+                counts.push_back(Value::UBIGINT(entry.second));
+            }
+            global_state->rows.push_back({ Value(stats.name), Value::UBIGINT(stats.calls),
+                                           Value::UBIGINT(stats.errors),
+                                           Value::DOUBLE((double)stats.total_ns / 1e6),
+                                           Value::DOUBLE((double)stats.total_ns / 1e3 / (double)stats.calls),
+                                           Value::DOUBLE(stats.LatencyPercentileUs(0.50)),
+                                           Value::DOUBLE(stats.LatencyPercentileUs(0.95)),
+                                           Value::DOUBLE(stats.LatencyPercentileUs(0.99)),
+                                           Value::DOUBLE((double)stats.max_ns / 1e3),
+                                           Value::MAP(LogicalType::VARCHAR, LogicalType::UBIGINT, std::move(codes),
+                                                      std::move(counts)) });
+        }
+
+        return std::move(global_state);
+    }
+
+    static void SapRfcApiStatsScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &global_state = data.global_state->Cast<SapRfcApiStatsGlobalState>();
+
+        idx_t out_idx = 0;
+        while (global_state.emitted < global_state.rows.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &row = global_state.rows[global_state.emitted++];
+            for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, out_idx, row[col_idx]);
+            }
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+    }
+
+    TableFunction CreateSapRfcApiStatsScanFunction()
+    {
+        return TableFunction("sap_rfc_api_stats", {}, SapRfcApiStatsScan, SapRfcApiStatsBind,
+                             SapRfcApiStatsInitGlobalState);
+    }
+} // namespace duckdb
@@ -0,0 +1,102 @@
+#include "duckdb.hpp"
+
+#include "scanner_scan_history.hpp"
+#include "sap_scan_history.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    struct SapRfcScanHistoryBindData : public TableFunctionData
+    {
+        std::string path;
+        // Fingerprint of OBJECT, empty for every scan.
+        std::string object;
+    };
+
+    struct SapRfcScanHistoryGlobalState : public GlobalTableFunctionState
+    {
+        std::vector<std::vector<Value>> rows;
+        idx_t emitted = 0;
+    };
+
+    /**
+     * @brief Binds `sap_rfc_scan_history([OBJECT, PATH])`: one row per scan
+     *        recorded in the erpl_rfc_scan_history file, or in PATH.
+    */
+    static unique_ptr<FunctionData> SapRfcScanHistoryBind(ClientContext &context,
+                                                          TableFunctionBindInput &input,
+                                                          vector<LogicalType> &return_types,
+                                                          vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("sap_rfc_scan_history");
+
+        auto bind_data = make_uniq<SapRfcScanHistoryBindData>();
+        auto &named_params = input.named_parameters;
+        bind_data->path = named_params.find("PATH") != named_params.end() ? named_params["PATH"].ToString()
+                                                                           : GetRfcScanHistoryPath();
+        if (bind_data->path.empty()) {
+            throw InvalidInputException("No scan history to read: set erpl_rfc_scan_history to a file, or pass PATH");
+        }
+        if (named_params.find("OBJECT") != named_params.end()) {
+            bind_data->object = RfcScanHistory::ObjectFingerprint(named_params["OBJECT"].ToString());
+        }
+
+        names = { "finished_at", "function", "status", "source", "system_fingerprint", "object_fingerprint",
+                  "duration_ms", "rows", "payload_bytes", "rfc_calls", "rfc_time_ms", "retries",
+                  "connections_opened", "connections_reused", "columns", "threads", "max_batch_rows" };
+        return_types = { LogicalType::TIMESTAMP, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                         LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::DOUBLE, LogicalType::UBIGINT,
+                         LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::DOUBLE, LogicalType::UBIGINT,
+                         LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT, LogicalType::UBIGINT,
+                         LogicalType::UBIGINT };
+
+        return std::move(bind_data);
+    }
+
+    static unique_ptr<GlobalTableFunctionState> SapRfcScanHistoryInitGlobalState(ClientContext &context,
+                                                                                TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->Cast<SapRfcScanHistoryBindData>();
+        auto global_state = make_uniq<SapRfcScanHistoryGlobalState>();
+
+        for (auto &r : RfcScanHistory::Read(FileSystem::GetFileSystem(context), bind_data.path)) {
+            if (!bind_data.object.empty() && r.object != bind_data.object) {
+                continue;
+            }
+            global_state->rows.push_back({ Value::TIMESTAMP(Timestamp::FromEpochMs(r.finished_at_ms)),
+                                           Value(r.function), Value(r.status), Value(r.source), Value(r.system),
+                                           Value(r.object), Value::DOUBLE(r.duration_ms), Value::UBIGINT(r.rows),
+                                           Value::UBIGINT(r.payload_bytes), Value::UBIGINT(r.rfc_calls),
+                                           Value::DOUBLE(r.rfc_time_ms), Value::UBIGINT(r.retries),
+                                           Value::UBIGINT(r.connections_opened), Value::UBIGINT(r.connections_reused),
+                                           Value::UBIGINT(r.columns), Value::UBIGINT(r.threads),
+                                           Value::UBIGINT(r.max_batch_rows) });
+        }
+
+        return std::move(global_state);
+    }
+
+    static void SapRfcScanHistoryScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &global_state = data.global_state->Cast<SapRfcScanHistoryGlobalState>();
+
+        idx_t out_idx = 0;
+        while (global_state.emitted < global_state.rows.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &row = global_state.rows[global_state.emitted++];
+            for (idx_t col_idx = 0; col_idx < row.size(); col_idx++) {
+                output.SetValue(col_idx, out_idx, row[col_idx]);
+            }
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+    }
+
+    TableFunction CreateSapRfcScanHistoryScanFunction()
+    {
+        auto fun = TableFunction("sap_rfc_scan_history", {}, SapRfcScanHistoryScan, SapRfcScanHistoryBind,
+                                 SapRfcScanHistoryInitGlobalState);
+        fun.named_parameters["OBJECT"] = LogicalType::VARCHAR;
+        fun.named_parameters["PATH"] = LogicalType::VARCHAR;
+        return fun;
+    }
+} // namespace duckdb
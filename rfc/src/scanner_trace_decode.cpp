@@ -0,0 +1,93 @@
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/config.hpp"
+
+#include "scanner_trace_decode.hpp"
+#include "erpl_tracing.hpp"
+#include "telemetry.hpp"
+
+namespace duckdb
+{
+    struct ErplTraceDecodeBindData : public TableFunctionData
+    {
+        std::string path;
+    };
+
+    struct ErplTraceDecodeGlobalState : public GlobalTableFunctionState
+    {
+        std::vector<erpl::TraceRecord> records;
+        idx_t emitted = 0;
+    };
+
+    /**
+     * @brief Binds `erpl_trace_decode(PATH)`: one row per message of a binary
+     *        trace file, as written with erpl_trace_format = 'binary'.
+    */
+    static unique_ptr<FunctionData> ErplTraceDecodeBind(ClientContext &context,
+                                                        TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types,
+                                                        vector<string> &names)
+    {
+        PostHogTelemetry::Instance().RecordFunctionCall("erpl_trace_decode");
+
+        auto bind_data = make_uniq<ErplTraceDecodeBindData>();
+        bind_data->path = input.inputs[0].ToString();
+        if (!DBConfig::GetConfig(context).CanAccessFile(bind_data->path, FileType::FILE_TYPE_REGULAR)) {
+            throw PermissionException("Cannot read the trace file '%s': file system operations are "
+                                      "disabled by configuration", bind_data->path);
+        }
+
+        names = { "timestamp", "level", "thread", "component", "message", "data" };
+        return_types = { LogicalType::TIMESTAMP, LogicalType::VARCHAR, LogicalType::UINTEGER,
+                         LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR };
+
+        return std::move(bind_data);
+    }
+
+    static unique_ptr<GlobalTableFunctionState> ErplTraceDecodeInitGlobalState(ClientContext &context,
+                                                                             TableFunctionInitInput &input)
+    {
+        auto &bind_data = input.bind_data->Cast<ErplTraceDecodeBindData>();
+        auto global_state = make_uniq<ErplTraceDecodeGlobalState>();
+
+        // Messages still queued in this process belong in the file too.
+        erpl::ErplTracer::Instance().Flush();
+
+        auto &fs = FileSystem::GetFileSystem(context);
+        if (!fs.FileExists(bind_data.path)) {
+            throw IOException("Could not open trace file '%s'", bind_data.path);
+        }
+        auto handle = fs.OpenFile(bind_data.path, FileFlags::FILE_FLAGS_READ);
+        std::string content(handle->GetFileSize(), '\0');
+        handle->Read((void *)content.data(), content.size());
+        if (!erpl::ErplTracer::DecodeBinary(content, global_state->records)) {
+            throw InvalidInputException("'%s' is not a binary ERPL trace file", bind_data.path);
+        }
+
+        return std::move(global_state);
+    }
+
+    static void ErplTraceDecodeScan(ClientContext &context, TableFunctionInput &data, DataChunk &output)
+    {
+        auto &global_state = data.global_state->Cast<ErplTraceDecodeGlobalState>();
+
+        idx_t out_idx = 0;
+        while (global_state.emitted < global_state.records.size() && out_idx < STANDARD_VECTOR_SIZE) {
+            auto &record = global_state.records[global_state.emitted++];
+            output.SetValue(0, out_idx, Value::TIMESTAMP(timestamp_t(record.timestamp_us)));
+            output.SetValue(1, out_idx, Value(erpl::ErplTracer::LevelToString(record.level)));
+            output.SetValue(2, out_idx, Value::UINTEGER(record.thread));
+            output.SetValue(3, out_idx, Value(record.component));
+            output.SetValue(4, out_idx, Value(record.message));
+            output.SetValue(5, out_idx, record.data.empty() ? Value() : Value(record.data));
+            out_idx++;
+        }
+        output.SetCardinality(out_idx);
+    }
+
+    TableFunction CreateErplTraceDecodeScanFunction()
+    {
+        return TableFunction("erpl_trace_decode", { LogicalType::VARCHAR }, ErplTraceDecodeScan,
+                             ErplTraceDecodeBind, ErplTraceDecodeInitGlobalState);
+    }
+} // namespace duckdb
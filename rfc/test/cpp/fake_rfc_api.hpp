@@ -0,0 +1,76 @@
+#pragma once
+
+// Include with ERPL_RFC_API_IMPLEMENTATION defined: the dispatch macros would
+// otherwise rewrite the slot names assigned below.
+#ifndef ERPL_RFC_API_IMPLEMENTATION
+#error "Define ERPL_RFC_API_IMPLEMENTATION before including fake_rfc_api.hpp"
+#endif
+
+#include "sap_rfc_api.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace duckdb {
+
+// Serves RFC calls while it lives, so the code around them runs without a SAP
+// system or SDK.  Only the string conversions and RfcCloseConnection are
+// filled in; a test sets the slots it exercises, and reaching any other is a
+// bug in the test.  Declare it before anything holding a handle it handed
+// out, so those are released first.
+struct FakeRfcApi {
+	RfcApi api {};
+
+	FakeRfcApi() {
+		// ASCII is all the tests need.
+		api.RfcSAPUCToUTF8 = [](auto in, auto in_length, auto out, auto out_size, auto result_length, auto) {
+			unsigned i = 0;
+			for (; i < in_length && i + 1 < *out_size; i++) {
+				out[i] = static_cast<RFC_BYTE>(in[i]);
+			}
+			out[i] = 0;
+			*result_length = i;
+			return RFC_OK;
+		};
+		api.RfcUTF8ToSAPUC = [](auto in, auto in_length, auto out, auto out_size, auto result_length, auto) {
+			unsigned i = 0;
+			for (; i < in_length && i + 1 < *out_size; i++) {
+				out[i] = static_cast<SAP_UC>(in[i]);
+			}
+			out[i] = 0;
+			*result_length = i;
+			return RFC_OK;
+		};
+		api.RfcGetRcAsString = [](auto) -> const SAP_UC * {
+			static const SAP_UC rc[] = {'R', 'F', 'C', '_', 'R', 'C', 0};
+			return rc;
+		};
+		api.RfcCloseConnection = [](auto, auto) { return RFC_OK; };
+		SetRfcApiOverride(&api);
+	}
+
+	~FakeRfcApi() {
+		SetRfcApiOverride(nullptr);
+	}
+
+	FakeRfcApi(const FakeRfcApi &) = delete;
+	FakeRfcApi &operator=(const FakeRfcApi &) = delete;
+
+	// Fills in what a failed call reports.
+	static void SetError(RFC_ERROR_INFO *error_info, RFC_RC code, const std::string &message) {
+		std::memset(error_info, 0, sizeof(RFC_ERROR_INFO));
+		error_info->code = code;
+		for (size_t i = 0; i < message.size() && i + 1 < sizeof(error_info->message) / sizeof(SAP_UC); i++) {
+			error_info->message[i] = static_cast<SAP_UC>(message[i]);
+		}
+	}
+
+	// A distinct, never dereferenced handle of any SDK handle type.
+	template <class HANDLE>
+	static HANDLE Handle(idx_t n) {
+		static char handles[64];
+		return reinterpret_cast<HANDLE>(&handles[n]);
+	}
+};
+
+} // namespace duckdb
@@ -0,0 +1,83 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+#include "sap_attach_warmup.hpp"
+
+using namespace duckdb;
+
+static SapTableSchema KeyOnly(const string &table) {
+	SapTableSchema schema;
+	schema.names = {table + "_KEY"};
+	schema.types = {LogicalType::VARCHAR};
+	return schema;
+}
+
+TEST_CASE("Catalog discovery looks every table up once", "[erpl_rfc][catalog_discovery]") {
+	std::mutex lookups_lock;
+	std::map<string, int> lookups;
+	SapAttachWarmup discovery(RfcAuthParams(), 0, {}, [&](auto &, auto &, const string &table) {
+		std::lock_guard<std::mutex> guard(lookups_lock);
+		lookups[table]++;
+		return KeyOnly(table);
+	});
+
+	discovery.Prefetch({"MARA", "MAKT", "mara", "T001"}, 3);
+	SapTableSchema schema;
+	REQUIRE(discovery.TryGetSchema("MAKT", schema));
+	REQUIRE(schema.names == vector<string> {"MAKT_KEY"});
+	REQUIRE(discovery.TryGetSchema("mara", schema));
+	REQUIRE(schema.names == vector<string> {"MARA_KEY"});
+	REQUIRE(discovery.TryGetSchema("T001", schema));
+
+	// Resolved tables are not queued again.
+	discovery.Prefetch({"MARA", "T001"}, 3);
+	REQUIRE(discovery.TryGetSchema("MARA", schema));
+	std::lock_guard<std::mutex> guard(lookups_lock);
+	REQUIRE(lookups == std::map<string, int> {{"MAKT", 1}, {"MARA", 1}, {"T001", 1}});
+}
+
+TEST_CASE("Catalog discovery leaves failed and unlisted tables to the caller", "[erpl_rfc][catalog_discovery]") {
+	SapAttachWarmup discovery(RfcAuthParams(), 0, {}, [](auto &, auto &, const string &table) {
+		if (table == "ZMISSING") {
+			throw std::runtime_error("TABLE_NOT_FOUND");
+		}
+		return KeyOnly(table);
+	});
+
+	discovery.Prefetch({"ZMISSING", "MARA"}, 2);
+	SapTableSchema schema;
+	REQUIRE_FALSE(discovery.TryGetSchema("ZMISSING", schema));
+	REQUIRE(discovery.TryGetSchema("MARA", schema));
+	REQUIRE_FALSE(discovery.TryGetSchema("BKPF", schema));
+}
+
+TEST_CASE("Catalog discovery runs no more lookups at once than it has workers", "[erpl_rfc][catalog_discovery]") {
+	std::atomic<int> running {0};
+	std::atomic<int> peak {0};
+	SapAttachWarmup discovery(RfcAuthParams(), 0, {}, [&](auto &, auto &, const string &table) {
+		auto now = ++running;
+		auto seen = peak.load();
+		while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		running--;
+		return KeyOnly(table);
+	});
+
+	vector<string> tables;
+	for (int i = 0; i < 12; i++) {
+		tables.push_back("ZTABLE" + std::to_string(i));
+	}
+	discovery.Prefetch(tables, 3);
+	SapTableSchema schema;
+	for (auto &table : tables) {
+		REQUIRE(discovery.TryGetSchema(table, schema));
+	}
+	REQUIRE(peak <= 3);
+}
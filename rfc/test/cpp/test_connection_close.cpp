@@ -61,3 +61,49 @@ TEST_CASE("RfcConnection::Close on an already-invalid handle does not throw",
 	// std::terminate the whole process.
 	REQUIRE_NOTHROW(conn.reset());
 }
+
+// A connection handed back to the pool has its ABAP session reset first; one
+// whose reset fails is closed instead of being parked for the next user.
+TEST_CASE("RfcConnectionPool::Release parks only connections it could reset",
+          "[erpl_rfc][connection]") {
+	const char *ashost = std::getenv("ERPL_SAP_ASHOST");
+	const char *sysnr  = std::getenv("ERPL_SAP_SYSNR");
+	const char *user   = std::getenv("ERPL_SAP_USER");
+	const char *passwd = std::getenv("ERPL_SAP_PASSWORD");
+	const char *client = std::getenv("ERPL_SAP_CLIENT");
+	const char *lang   = std::getenv("ERPL_SAP_LANG");
+
+	if (!ashost || !sysnr || !user || !passwd || !client || !lang) {
+		WARN("Skipping: ERPL_SAP_* environment variables not set (needs a live SAP system)");
+		return;
+	}
+
+	RfcAuthParams params;
+	params.ashost = ashost;
+	params.sysnr = sysnr;
+	params.user = user;
+	params.password = passwd;
+	params.client = client;
+	params.lang = lang;
+
+	auto &pool = RfcConnectionPool::Get();
+	auto key = params.PoolKey();
+	pool.Clear();
+
+	auto conn = params.OpenConnection();
+	REQUIRE(conn->ResetServerContext());
+	pool.Release(std::move(conn));
+	REQUIRE(pool.Size(key) == 1);
+
+	auto taken = pool.TryTake(key);
+	REQUIRE(taken != nullptr);
+	REQUIRE(taken->reused_from_pool);
+	REQUIRE(pool.Size(key) == 0);
+
+	// Invalidate the handle out-of-band, as in the test above.
+	RFC_ERROR_INFO error_info;
+	REQUIRE(RfcCloseConnection(taken->handle, &error_info) == RFC_OK);
+	REQUIRE_FALSE(taken->ResetServerContext());
+	REQUIRE_NOTHROW(pool.Release(std::move(taken)));
+	REQUIRE(pool.Size(key) == 0);
+}
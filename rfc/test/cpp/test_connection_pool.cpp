@@ -0,0 +1,74 @@
+#define ERPL_RFC_API_IMPLEMENTATION
+#include "catch.hpp"
+#include "duckdb.hpp"
+
+#include "fake_rfc_api.hpp"
+#include "sap_connection.hpp"
+
+using namespace duckdb;
+
+static int g_pings = 0;
+static int g_closes = 0;
+
+// Handle 0 stands for a session the gateway dropped while it was parked.
+static void FakePingAndClose(FakeRfcApi &fake) {
+	g_pings = 0;
+	g_closes = 0;
+	fake.api.RfcPing = [](auto handle, auto error_info) {
+		g_pings++;
+		if (handle == FakeRfcApi::Handle<RFC_CONNECTION_HANDLE>(0)) {
+			FakeRfcApi::SetError(error_info, RFC_COMMUNICATION_FAILURE, "connection reset by peer");
+			return RFC_COMMUNICATION_FAILURE;
+		}
+		return RFC_OK;
+	};
+	fake.api.RfcCloseConnection = [](auto, auto) {
+		g_closes++;
+		return RFC_OK;
+	};
+}
+
+static std::shared_ptr<RfcConnection> FakeConnection(idx_t n) {
+	auto connection = std::make_shared<RfcConnection>(FakeRfcApi::Handle<RFC_CONNECTION_HANDLE>(n));
+	connection->pool_key = "fake";
+	return connection;
+}
+
+TEST_CASE("A parked connection that does not answer a ping is closed, not handed out", "[erpl_rfc][connection]") {
+	FakeRfcApi fake;
+	FakePingAndClose(fake);
+	auto &pool = RfcConnectionPool::Get();
+	pool.Clear();
+
+	pool.Park("fake", FakeConnection(0), RfcConnectionPool::PING_AFTER_IDLE);
+	REQUIRE(pool.TryTake("fake") == nullptr);
+	REQUIRE(g_pings == 1);
+	REQUIRE(g_closes == 1);
+	REQUIRE(pool.Size("fake") == 0);
+}
+
+TEST_CASE("Taking from the pool skips dead connections and pings only idle ones", "[erpl_rfc][connection]") {
+	FakeRfcApi fake;
+	FakePingAndClose(fake);
+	auto &pool = RfcConnectionPool::Get();
+	pool.Clear();
+
+	pool.Park("fake", FakeConnection(0), RfcConnectionPool::PING_AFTER_IDLE);
+	pool.Park("fake", FakeConnection(1), RfcConnectionPool::PING_AFTER_IDLE);
+	auto taken = pool.TryTake("fake");
+	REQUIRE(taken != nullptr);
+	REQUIRE(taken->handle == FakeRfcApi::Handle<RFC_CONNECTION_HANDLE>(1));
+	REQUIRE(taken->reused_from_pool);
+	REQUIRE(g_pings == 2);
+	REQUIRE(g_closes == 1);
+
+	// Parked just now: handed out without a round-trip.
+	pool.Park("fake", FakeConnection(2));
+	auto fresh = pool.TryTake("fake");
+	REQUIRE(fresh != nullptr);
+	REQUIRE(g_pings == 2);
+
+	taken.reset();
+	fresh.reset();
+	REQUIRE(g_closes == 3);
+}
@@ -0,0 +1,189 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+#include "duckdb/common/local_file_system.hpp"
+
+#include "sap_extract_manifest.hpp"
+
+using namespace duckdb;
+
+static string ManifestDirectory(const string &name) {
+	auto directory = TestCreatePath(name);
+	TestDeleteDirectory(directory);
+	TestCreateDirectory(directory);
+	return directory;
+}
+
+static SapExtractPartition Partition(idx_t index, idx_t rows, const string &file) {
+	SapExtractPartition partition;
+	partition.index = index;
+	partition.row_offset = index * 32768;
+	partition.rows = rows;
+	partition.file = file;
+	return partition;
+}
+
+TEST_CASE("Manifest partition lines round-trip", "[erpl_rfc][extract_manifest]") {
+	auto line = SapExtractManifest::FormatPartition(Partition(7, 32768, "bseg_000007.parquet"));
+	REQUIRE(line == "part\t7\t229376\t32768\tbseg_000007.parquet");
+
+	SapExtractPartition parsed;
+	REQUIRE(SapExtractManifest::ParsePartition(line, parsed));
+	REQUIRE(parsed.index == 7);
+	REQUIRE(parsed.row_offset == 229376);
+	REQUIRE(parsed.rows == 32768);
+	REQUIRE(parsed.file == "bseg_000007.parquet");
+
+	REQUIRE_FALSE(SapExtractManifest::ParsePartition("part\t7\t229376\t327", parsed));
+	REQUIRE_FALSE(SapExtractManifest::ParsePartition("part\tx\t0\t0\tf", parsed));
+	REQUIRE_FALSE(SapExtractManifest::ParsePartition("job\tBSEG\t32768\t\t", parsed));
+}
+
+TEST_CASE("Manifest job line keeps each field on its line", "[erpl_rfc][extract_manifest]") {
+	auto job = SapExtractManifest::FormatJob("bseg", 32768, {"BUKRS", "BELNR"}, "BUKRS = '1000'\nAND GJAHR = '2024'");
+	REQUIRE(job == "job\tBSEG\t32768\tBUKRS,BELNR\tBUKRS = '1000' AND GJAHR = '2024'");
+}
+
+TEST_CASE("Manifest resumes recorded partitions and learns the end", "[erpl_rfc][extract_manifest]") {
+	LocalFileSystem fs;
+	auto directory = ManifestDirectory("extract_manifest_resume");
+	auto job = SapExtractManifest::FormatJob("BSEG", 32768, {}, "");
+	{
+		SapExtractManifest manifest(fs, directory);
+		manifest.Open(job);
+		REQUIRE(manifest.PartitionCount(32768) == DConstants::INVALID_INDEX);
+		manifest.Record(Partition(0, 32768, "bseg_000000.parquet"));
+		manifest.Record(Partition(2, 100, "bseg_000002.parquet"));
+	}
+
+	SapExtractManifest manifest(fs, directory);
+	manifest.Open(job);
+	REQUIRE(manifest.IsDone(0));
+	REQUIRE_FALSE(manifest.IsDone(1));
+	REQUIRE(manifest.IsDone(2));
+	REQUIRE(manifest.PartitionCount(32768) == 3);
+	REQUIRE(manifest.Partitions().size() == 2);
+	TestDeleteDirectory(directory);
+}
+
+TEST_CASE("Manifest ignores a torn last line", "[erpl_rfc][extract_manifest]") {
+	LocalFileSystem fs;
+	auto directory = ManifestDirectory("extract_manifest_torn");
+	auto job = SapExtractManifest::FormatJob("BSEG", 32768, {}, "");
+	{
+		SapExtractManifest manifest(fs, directory);
+		manifest.Open(job);
+		manifest.Record(Partition(0, 32768, "bseg_000000.parquet"));
+	}
+	{
+		auto handle = fs.OpenFile(fs.JoinPath(directory, SapExtractManifest::FILE_NAME),
+		                          FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_APPEND);
+		string torn = "part\t1\t32768\t32";
+		handle->Write((void *)torn.data(), torn.size());
+	}
+	{
+		SapExtractManifest manifest(fs, directory);
+		manifest.Open(job);
+		REQUIRE(manifest.IsDone(0));
+		REQUIRE_FALSE(manifest.IsDone(1));
+		manifest.Record(Partition(1, 32768, "bseg_000001.parquet"));
+	}
+
+	SapExtractManifest manifest(fs, directory);
+	manifest.Open(job);
+	REQUIRE(manifest.IsDone(1));
+	TestDeleteDirectory(directory);
+}
+
+TEST_CASE("Manifest refuses a different job", "[erpl_rfc][extract_manifest]") {
+	LocalFileSystem fs;
+	auto directory = ManifestDirectory("extract_manifest_job");
+	{
+		SapExtractManifest manifest(fs, directory);
+		manifest.Open(SapExtractManifest::FormatJob("BSEG", 32768, {}, ""));
+	}
+
+	SapExtractManifest manifest(fs, directory);
+	REQUIRE_THROWS_AS(manifest.Open(SapExtractManifest::FormatJob("BSEG", 65536, {}, "")), InvalidInputException);
+	REQUIRE_THROWS_AS(manifest.Open(SapExtractManifest::FormatJob("BKPF", 32768, {}, "")), InvalidInputException);
+	TestDeleteDirectory(directory);
+}
+
+TEST_CASE("Manifest hands each partition to one process until its claim expires", "[erpl_rfc][extract_manifest]") {
+	LocalFileSystem fs;
+	auto directory = ManifestDirectory("extract_manifest_claims");
+	auto job = SapExtractManifest::FormatJob("BSEG", 32768, {}, "");
+	// Two manifests on one directory stand in for two processes.
+	SapExtractManifest a(fs, directory);
+	SapExtractManifest b(fs, directory);
+	a.Open(job);
+	b.Open(job);
+
+	idx_t index = DConstants::INVALID_INDEX;
+	REQUIRE(a.Claim("a", 1000, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 0);
+	REQUIRE(b.Claim("b", 1000, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 1);
+
+	// A short partition ends the table; what is left is a's claim on 0.
+	b.Record(Partition(1, 100, "bseg_000001.parquet"));
+	REQUIRE(b.Claim("b", 1050, 100, index) == SapExtractManifest::ClaimResult::BUSY);
+	a.Renew("a", {0}, 1050, 100);
+	REQUIRE(b.Claim("b", 1120, 100, index) == SapExtractManifest::ClaimResult::BUSY);
+	REQUIRE(b.Claim("b", 1200, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 0);
+
+	b.Record(Partition(0, 32768, "bseg_000000.parquet"));
+	REQUIRE(a.Claim("a", 1200, 100, index) == SapExtractManifest::ClaimResult::DONE);
+	REQUIRE(a.PartitionCount(32768) == 2);
+	REQUIRE(a.IsDone(1));
+	TestDeleteDirectory(directory);
+}
+
+TEST_CASE("Manifest claim released by its owner is free at once", "[erpl_rfc][extract_manifest]") {
+	LocalFileSystem fs;
+	auto directory = ManifestDirectory("extract_manifest_release");
+	auto job = SapExtractManifest::FormatJob("BSEG", 32768, {}, "");
+	SapExtractManifest a(fs, directory);
+	SapExtractManifest b(fs, directory);
+	a.Open(job);
+	b.Open(job);
+
+	idx_t index = DConstants::INVALID_INDEX;
+	REQUIRE(a.Claim("a", 1000, 60000, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 0);
+	// Only the owner can release a claim.
+	b.Release("b", 0);
+	REQUIRE(b.Claim("b", 1000, 60000, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 1);
+	a.Release("a", 0);
+	REQUIRE(b.Claim("b", 1000, 60000, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 0);
+	TestDeleteDirectory(directory);
+}
+
+TEST_CASE("Manifest renews only claims still held and reports the lost ones", "[erpl_rfc][extract_manifest]") {
+	LocalFileSystem fs;
+	auto directory = ManifestDirectory("extract_manifest_renew");
+	auto job = SapExtractManifest::FormatJob("BSEG", 32768, {}, "");
+	SapExtractManifest a(fs, directory);
+	SapExtractManifest b(fs, directory);
+	a.Open(job);
+	b.Open(job);
+
+	idx_t index = DConstants::INVALID_INDEX;
+	REQUIRE(a.Claim("a", 1000, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(a.Claim("a", 1000, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(a.Renew("a", {0, 1}, 1050, 100).empty());
+
+	// a misses a renewal; b takes over partition 0 once the lease runs out.
+	REQUIRE(b.Claim("b", 1200, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 0);
+	// Partition 1 expired too, but nobody took it.
+	REQUIRE(a.Renew("a", {0, 1}, 1200, 100) == vector<idx_t> {0, 1});
+	// Neither claim was extended: b keeps 0 and can take 1.
+	REQUIRE(b.Claim("b", 1200, 100, index) == SapExtractManifest::ClaimResult::CLAIMED);
+	REQUIRE(index == 1);
+	REQUIRE(b.Renew("b", {0, 1}, 1250, 100).empty());
+	TestDeleteDirectory(directory);
+}
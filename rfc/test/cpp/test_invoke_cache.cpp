@@ -0,0 +1,156 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include "sap_invoke_cache.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("Invoke cache allow-list matches names and wildcards", "[erpl_rfc][invoke_cache]") {
+	auto patterns = std::string(RfcInvokeCache::DEFAULT_FUNCTIONS);
+	REQUIRE(RfcInvokeCache::MatchesAllowList(patterns, "BAPI_COMPANYCODE_GETLIST"));
+	REQUIRE(RfcInvokeCache::MatchesAllowList(patterns, "bapi_companycode_getdetail"));
+	REQUIRE(RfcInvokeCache::MatchesAllowList(patterns, "RFC_READ_TEXT"));
+	REQUIRE_FALSE(RfcInvokeCache::MatchesAllowList(patterns, "BAPI_PO_CREATE1"));
+	REQUIRE_FALSE(RfcInvokeCache::MatchesAllowList(patterns, "BAPI_TRANSACTION_COMMIT"));
+	REQUIRE_FALSE(RfcInvokeCache::MatchesAllowList(patterns, "RFC_READ_TEXT_X"));
+}
+
+TEST_CASE("Invoke cache allow-list ignores blanks and can be empty", "[erpl_rfc][invoke_cache]") {
+	REQUIRE(RfcInvokeCache::MatchesAllowList(" Z_READ_* , STFC_CONNECTION ", "Z_READ_ORDERS"));
+	REQUIRE(RfcInvokeCache::MatchesAllowList(" Z_READ_* , STFC_CONNECTION ", "STFC_CONNECTION"));
+	REQUIRE_FALSE(RfcInvokeCache::MatchesAllowList("", "STFC_CONNECTION"));
+	REQUIRE_FALSE(RfcInvokeCache::MatchesAllowList(",,", "STFC_CONNECTION"));
+}
+
+TEST_CASE("Invoke cache key separates clients, users, paths and arguments", "[erpl_rfc][invoke_cache]") {
+	RfcConnectionAttributes a;
+	a.sys_id = "S4H";
+	a.partner_release = "758";
+	a.language = "E";
+	a.client = "100";
+	a.user = "ALICE";
+
+	child_list_t<Value> args;
+	args.emplace_back("REQUTEXT", Value("Hello"));
+	auto hello = std::vector<Value> { Value::STRUCT(args) };
+	args[0].second = Value("World");
+	auto world = std::vector<Value> { Value::STRUCT(args) };
+
+	auto key = RfcInvokeCache::Key(a, "STFC_CONNECTION", "", hello);
+	REQUIRE(key == RfcInvokeCache::Key(a, "stfc_connection", "", hello));
+
+	auto other_client = a;
+	other_client.client = "200";
+	auto other_user = a;
+	other_user.user = "BOB";
+
+	REQUIRE(key != RfcInvokeCache::Key(other_client, "STFC_CONNECTION", "", hello));
+	REQUIRE(key != RfcInvokeCache::Key(other_user, "STFC_CONNECTION", "", hello));
+	REQUIRE(key != RfcInvokeCache::Key(a, "STFC_CONNECTION", "/ECHOTEXT", hello));
+	REQUIRE(key != RfcInvokeCache::Key(a, "STFC_CONNECTION", "", world));
+	REQUIRE(key != RfcInvokeCache::Key(a, "STFC_CONNECTION", "", {}));
+}
+
+TEST_CASE("Invoke cache key is empty without a system id", "[erpl_rfc][invoke_cache]") {
+	RfcConnectionAttributes unknown;
+	REQUIRE(RfcInvokeCache::Key(unknown, "STFC_CONNECTION", "", {}).empty());
+}
+
+static RfcInvokeCache::Result MakeResult(int64_t value) {
+	auto collection = std::make_shared<ColumnDataCollection>(Allocator::DefaultAllocator(),
+	                                                         vector<LogicalType> {LogicalType::BIGINT});
+	DataChunk chunk;
+	chunk.Initialize(Allocator::DefaultAllocator(), {LogicalType::BIGINT});
+	chunk.SetValue(0, 0, Value::BIGINT(value));
+	chunk.SetCardinality(1);
+	collection->Append(chunk);
+	return collection;
+}
+
+TEST_CASE("Invoke cache calls once per key and does not cache failures", "[erpl_rfc][invoke_cache]") {
+	SetRfcInvokeCacheTtl(60);
+	auto &cache = RfcInvokeCache::Get();
+
+	int calls = 0;
+	auto first = cache.GetOrInvoke("k1", "RFC_SYSTEM_INFO", [&]() { calls++; return MakeResult(1); });
+	auto second = cache.GetOrInvoke("k1", "RFC_SYSTEM_INFO", [&]() { calls++; return MakeResult(2); });
+	REQUIRE(calls == 1);
+	REQUIRE(first.get() == second.get());
+
+	REQUIRE_THROWS(cache.GetOrInvoke("k2", "RFC_SYSTEM_INFO", [&]() -> RfcInvokeCache::Result {
+		calls++;
+		throw std::runtime_error("RFC_COMMUNICATION_FAILURE");
+	}));
+	cache.GetOrInvoke("k2", "RFC_SYSTEM_INFO", [&]() { calls++; return MakeResult(3); });
+	REQUIRE(calls == 3);
+	REQUIRE(cache.Size() == 2);
+
+	SetRfcInvokeCacheTtl(0);
+	REQUIRE(cache.Size() == 0);
+	REQUIRE(cache.MemoryUsage() == 0);
+}
+
+TEST_CASE("Invoke cache stays within its memory bound", "[erpl_rfc][invoke_cache]") {
+	SetRfcInvokeCacheTtl(60);
+	auto &cache = RfcInvokeCache::Get();
+	auto one_result = MakeResult(0)->AllocationSize();
+	SetRfcInvokeCacheMaxMemory(2 * one_result);
+
+	cache.GetOrInvoke("a", "RFC_SYSTEM_INFO", []() { return MakeResult(1); });
+	cache.GetOrInvoke("b", "RFC_SYSTEM_INFO", []() { return MakeResult(2); });
+	// Touch "a", so "b" is the least recently used when "c" arrives.
+	cache.GetOrInvoke("a", "RFC_SYSTEM_INFO", []() { return MakeResult(1); });
+	cache.GetOrInvoke("c", "RFC_SYSTEM_INFO", []() { return MakeResult(3); });
+
+	REQUIRE(cache.Size() == 2);
+	REQUIRE(cache.MemoryUsage() <= 2 * one_result);
+	int calls = 0;
+	cache.GetOrInvoke("a", "RFC_SYSTEM_INFO", [&]() { calls++; return MakeResult(1); });
+	REQUIRE(calls == 0);
+
+	SetRfcInvokeCacheMaxMemory(RfcInvokeCache::DEFAULT_MAX_MEMORY);
+	SetRfcInvokeCacheTtl(0);
+}
+
+TEST_CASE("Invoke cache does not keep results of functions off the allow-list", "[erpl_rfc][invoke_cache]") {
+	SetRfcInvokeCacheTtl(60);
+	auto &cache = RfcInvokeCache::Get();
+
+	int calls = 0;
+	cache.GetOrInvoke("w", "BAPI_PO_CREATE1", [&]() { calls++; return MakeResult(1); });
+	cache.GetOrInvoke("w", "BAPI_PO_CREATE1", [&]() { calls++; return MakeResult(1); });
+	REQUIRE(calls == 2);
+	REQUIRE(cache.Size() == 0);
+
+	// Taken off the allow-list while in flight: handed back, not cached.
+	cache.GetOrInvoke("r", "RFC_SYSTEM_INFO", [&]() {
+		SetRfcInvokeCacheFunctions("BAPI_*_GETLIST");
+		return MakeResult(2);
+	});
+	REQUIRE(cache.Size() == 0);
+
+	SetRfcInvokeCacheFunctions(RfcInvokeCache::DEFAULT_FUNCTIONS);
+	SetRfcInvokeCacheTtl(0);
+}
+
+TEST_CASE("Invoke cache Clear forgets calls in flight", "[erpl_rfc][invoke_cache]") {
+	SetRfcInvokeCacheTtl(60);
+	auto &cache = RfcInvokeCache::Get();
+
+	int calls = 0;
+	cache.GetOrInvoke("f", "RFC_SYSTEM_INFO", [&]() {
+		cache.Clear();
+		// The cleared flight is not joined: the same key is called again.
+		cache.GetOrInvoke("f", "RFC_SYSTEM_INFO", [&]() { calls++; return MakeResult(2); });
+		calls++;
+		return MakeResult(1);
+	});
+	REQUIRE(calls == 2);
+	// Only the call that started after Clear() is cached.
+	cache.GetOrInvoke("f", "RFC_SYSTEM_INFO", [&]() { calls++; return MakeResult(3); });
+	REQUIRE(calls == 2);
+	REQUIRE(cache.Size() == 1);
+
+	SetRfcInvokeCacheTtl(0);
+}
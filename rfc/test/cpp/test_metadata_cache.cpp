@@ -0,0 +1,69 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include "sap_metadata_cache.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("Read-table result path prefers the widest TBLOUT bucket", "[erpl_rfc][metadata_cache]") {
+	REQUIRE(RfcReadTableCapabilities::SelectResultPath({"TBLOUT128", "TBLOUT2048", "TBLOUT512", "FIELDS"}) ==
+	        "/TBLOUT2048");
+	REQUIRE(RfcReadTableCapabilities::SelectResultPath({"TBLOUT30000", "TBLOUT8192", "DATA"}) == "/TBLOUT30000");
+}
+
+TEST_CASE("Read-table result path falls back to DATA, then to nothing", "[erpl_rfc][metadata_cache]") {
+	REQUIRE(RfcReadTableCapabilities::SelectResultPath({"DATA", "FIELDS", "ET_DATA"}) == "/DATA");
+	REQUIRE(RfcReadTableCapabilities::SelectResultPath({"FIELDS", "ET_DATA"}).empty());
+	REQUIRE(RfcReadTableCapabilities::SelectResultPath({}).empty());
+}
+
+TEST_CASE("System key is shared across app servers of one system", "[erpl_rfc][metadata_cache]") {
+	RfcConnectionAttributes a;
+	a.sys_id = "S4H";
+	a.partner_host = "app01";
+	a.partner_release = "758";
+	a.language = "E";
+	a.client = "100";
+
+	auto b = a;
+	b.partner_host = "app02";
+	b.client = "200";
+
+	REQUIRE(RfcMetadataCache::SystemKey(a) == RfcMetadataCache::SystemKey(b));
+}
+
+TEST_CASE("System key separates systems, releases and logon languages", "[erpl_rfc][metadata_cache]") {
+	RfcConnectionAttributes a;
+	a.sys_id = "S4H";
+	a.partner_release = "758";
+	a.language = "E";
+
+	auto other_system = a;
+	other_system.sys_id = "ECC";
+	auto other_release = a;
+	other_release.partner_release = "757";
+	auto other_language = a;
+	other_language.language = "D";
+
+	REQUIRE(RfcMetadataCache::SystemKey(a) != RfcMetadataCache::SystemKey(other_system));
+	REQUIRE(RfcMetadataCache::SystemKey(a) != RfcMetadataCache::SystemKey(other_release));
+	REQUIRE(RfcMetadataCache::SystemKey(a) != RfcMetadataCache::SystemKey(other_language));
+}
+
+TEST_CASE("System key falls back to the partner host, and is empty without either", "[erpl_rfc][metadata_cache]") {
+	RfcConnectionAttributes a;
+	a.partner_host = "app01";
+	REQUIRE_FALSE(RfcMetadataCache::SystemKey(a).empty());
+
+	RfcConnectionAttributes unknown;
+	REQUIRE(RfcMetadataCache::SystemKey(unknown).empty());
+}
+
+TEST_CASE("Cached missing functions are looked up again after a short while", "[erpl_rfc][metadata_cache]") {
+	auto cached_at = std::chrono::steady_clock::now();
+	REQUIRE_FALSE(RfcMetadataCache::NegativeEntryExpired(cached_at, cached_at));
+	REQUIRE_FALSE(RfcMetadataCache::NegativeEntryExpired(cached_at, cached_at + std::chrono::seconds(30)));
+	REQUIRE(RfcMetadataCache::NegativeEntryExpired(cached_at, cached_at + RfcMetadataCache::NEGATIVE_TTL));
+	REQUIRE(RfcMetadataCache::NegativeEntryExpired(cached_at, cached_at + std::chrono::minutes(10)));
+}
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include "sap_rfc.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("EXPLAIN shows the table, read function and pushed options", "[erpl_rfc][explain]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	RfcReadTableBindData bind_data("SFLIGHT", 4, 65536, &DefaultRfcConnectionFactory, *con.context);
+	std::string where_clause = "CARRID = 'LH' AND CONNID = '0400' AND FLDATE >= '20240101' AND FLDATE <= '20241231'";
+	bind_data.InitOptionsFromWhereClause(where_clause);
+	REQUIRE(bind_data.options.size() > 1);
+
+	auto params = bind_data.ExplainParams(false);
+	REQUIRE(params["Table"] == "SFLIGHT");
+	REQUIRE(params["Function"] == "RFC_READ_TABLE");
+	REQUIRE(params["Options"] == where_clause);
+	REQUIRE(params["Max Rows"] == "65536");
+	REQUIRE(params["Threads"] == "4");
+	REQUIRE(params.find("Row Offset") == params.end());
+	REQUIRE(params.find("RFC Calls") == params.end());
+}
+
+TEST_CASE("EXPLAIN ANALYZE shows the scan's counters until the next run", "[erpl_rfc][explain]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	RfcReadTableBindData bind_data("SFLIGHT", 0, 0, &DefaultRfcConnectionFactory, *con.context);
+	bind_data.stats.RecordCall(std::chrono::steady_clock::now() - std::chrono::milliseconds(5));
+	bind_data.stats.RecordCall(std::chrono::steady_clock::now());
+	bind_data.stats.rows_decoded += 4096;
+	bind_data.stats.payload_bytes += 2048;
+	bind_data.stats.connections_opened += 1;
+	bind_data.stats.connections_reused += 3;
+	bind_data.stats.retries += 1;
+
+	auto params = bind_data.ExplainParams(true);
+	REQUIRE(params["Threads"] == "all columns");
+	REQUIRE(params["RFC Calls"] == "2");
+	REQUIRE(params["Rows Decoded"] == "4096");
+	REQUIRE(params["Payload Received"] == StringUtil::BytesToHumanReadableString(2048));
+	REQUIRE(params["Connections"] == "1 opened, 3 reused");
+	REQUIRE(params["Retries"] == "1");
+	REQUIRE(bind_data.stats.rfc_time_us >= 5000);
+
+	bind_data.BeginScan();
+	REQUIRE(bind_data.ExplainParams(true)["RFC Calls"] == "0");
+	bind_data.FinishScan();
+}
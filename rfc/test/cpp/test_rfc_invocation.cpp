@@ -0,0 +1,134 @@
+#define ERPL_RFC_API_IMPLEMENTATION
+#include "catch.hpp"
+#include "duckdb.hpp"
+
+#include "fake_rfc_api.hpp"
+#include "sap_connection.hpp"
+#include "sap_function.hpp"
+
+using namespace duckdb;
+
+template <size_t N>
+static void CopyName(SAP_UC (&target)[N], const std::string &name) {
+	for (size_t i = 0; i < name.size() && i + 1 < N; i++) {
+		target[i] = static_cast<SAP_UC>(name[i]);
+	}
+}
+
+static std::string NameOf(const SAP_UC *name) {
+	std::string result;
+	for (; *name; name++) {
+		result += static_cast<char>(*name);
+	}
+	return result;
+}
+
+static bool g_delete_fails = false;
+static std::vector<std::string> g_cleared;
+static int g_rowskips = 0;
+static std::vector<std::string> g_deactivated;
+
+// RFC_READ_TABLE cut down to one paging import, one input and one result table.
+static void FakeReadTableFunction(FakeRfcApi &fake) {
+	g_delete_fails = false;
+	g_cleared.clear();
+	g_rowskips = 0;
+	g_deactivated.clear();
+	fake.api.RfcGetParameterCount = [](auto, auto count, auto) {
+		*count = 3;
+		return RFC_OK;
+	};
+	fake.api.RfcGetParameterDescByIndex = [](auto, auto index, auto param_desc, auto) {
+		std::memset(param_desc, 0, sizeof(RFC_PARAMETER_DESC));
+		if (index == 0) {
+			CopyName(param_desc->name, "ROWSKIPS");
+			param_desc->type = RFCTYPE_INT;
+			param_desc->direction = RFC_IMPORT;
+			param_desc->nucLength = 4;
+		} else {
+			CopyName(param_desc->name, index == 1 ? "OPTIONS" : "DATA");
+			param_desc->type = RFCTYPE_TABLE;
+			param_desc->direction = RFC_TABLES;
+		}
+		return RFC_OK;
+	};
+	fake.api.RfcCreateFunction = [](auto, auto) { return FakeRfcApi::Handle<RFC_FUNCTION_HANDLE>(1); };
+	fake.api.RfcDestroyFunction = [](auto, auto) { return RFC_OK; };
+	fake.api.RfcGetTable = [](auto, auto name, auto table_handle, auto) {
+		*table_handle = FakeRfcApi::Handle<RFC_TABLE_HANDLE>(NameOf(name) == "DATA" ? 2 : 3);
+		return RFC_OK;
+	};
+	fake.api.RfcDeleteAllRows = [](auto table_handle, auto error_info) {
+		if (g_delete_fails) {
+			FakeRfcApi::SetError(error_info, RFC_NOT_SUPPORTED, "RfcDeleteAllRows not supported");
+			return RFC_NOT_SUPPORTED;
+		}
+		g_cleared.push_back(table_handle == FakeRfcApi::Handle<RFC_TABLE_HANDLE>(2) ? "DATA" : "OPTIONS");
+		return RFC_OK;
+	};
+	fake.api.RfcSetInt = [](auto, auto, auto value, auto) {
+		g_rowskips = value;
+		return RFC_OK;
+	};
+	fake.api.RfcSetParameterActive = [](auto, auto name, auto is_active, auto) {
+		if (!is_active) {
+			g_deactivated.push_back(NameOf(name));
+		}
+		return RFC_OK;
+	};
+}
+
+static std::shared_ptr<RfcInvocation> BeginFakeInvocation() {
+	auto connection = std::make_shared<RfcConnection>(FakeRfcApi::Handle<RFC_CONNECTION_HANDLE>(0));
+	auto function = std::make_shared<RfcFunction>(connection, "RFC_READ_TABLE",
+	                                              FakeRfcApi::Handle<RFC_FUNCTION_DESC_HANDLE>(0));
+	return function->BeginInvocation();
+}
+
+TEST_CASE("A prepared invocation clears only its result tables and rewrites the paging import",
+          "[erpl_rfc][invocation]") {
+	FakeRfcApi fake;
+	FakeReadTableFunction(fake);
+	auto invocation = BeginFakeInvocation();
+
+	REQUIRE(invocation->PrepareNextCall({"OPTIONS"}, {{"ROWSKIPS", Value::INTEGER(4096)}}));
+	REQUIRE(g_cleared == std::vector<std::string> {"DATA"});
+	REQUIRE(g_rowskips == 4096);
+}
+
+TEST_CASE("A backend rejecting RfcDeleteAllRows makes the caller rebuild the invocation", "[erpl_rfc][invocation]") {
+	FakeRfcApi fake;
+	FakeReadTableFunction(fake);
+	g_delete_fails = true;
+	auto invocation = BeginFakeInvocation();
+
+	REQUIRE_FALSE(invocation->PrepareNextCall({"OPTIONS"}, {{"ROWSKIPS", Value::INTEGER(4096)}}));
+	// The stale result rows were not cleared, so the paging import is not
+	// touched either: the handle is about to be dropped.
+	REQUIRE(g_cleared.empty());
+	REQUIRE(g_rowskips == 0);
+}
+
+TEST_CASE("Result parameters outside the path are deactivated before the call", "[erpl_rfc][invocation]") {
+	FakeRfcApi fake;
+	FakeReadTableFunction(fake);
+
+	auto invocation = BeginFakeInvocation();
+	invocation->DeactivateResultsOutsidePath("/DATA");
+	REQUIRE(g_deactivated == std::vector<std::string> {"OPTIONS"});
+
+	g_deactivated.clear();
+	invocation = BeginFakeInvocation();
+	invocation->DeactivateResultsOutsidePath("");
+	REQUIRE(g_deactivated.empty());
+}
+
+TEST_CASE("A table parameter carrying input stays active outside the path", "[erpl_rfc][invocation]") {
+	FakeRfcApi fake;
+	FakeReadTableFunction(fake);
+
+	auto invocation = BeginFakeInvocation();
+	invocation->GetTableParameter("OPTIONS");
+	invocation->DeactivateResultsOutsidePath("/DATA");
+	REQUIRE(g_deactivated.empty());
+}
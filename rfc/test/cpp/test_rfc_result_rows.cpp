@@ -0,0 +1,151 @@
+#define ERPL_RFC_API_IMPLEMENTATION
+#include "catch.hpp"
+#include "duckdb.hpp"
+
+#include "fake_rfc_api.hpp"
+#include "sap_connection.hpp"
+#include "sap_function.hpp"
+
+using namespace duckdb;
+
+static const unsigned NO_MISSING_ROW = ~0u;
+
+static unsigned g_row_count = 0;
+static unsigned g_missing_row = NO_MISSING_ROW;
+static unsigned g_current_row = 0;
+static unsigned g_decoded_n = 0;
+
+template <size_t N>
+static void CopyName(SAP_UC (&target)[N], const std::string &name) {
+	for (size_t i = 0; i < name.size() && i + 1 < N; i++) {
+		target[i] = static_cast<SAP_UC>(name[i]);
+	}
+}
+
+// A table whose lines have two INT fields N and M, holding 10 * row and
+// 10 * row + 1.  The SDK cannot hand back line g_missing_row.
+static void FakeTable(FakeRfcApi &fake, unsigned row_count) {
+	g_row_count = row_count;
+	g_missing_row = NO_MISSING_ROW;
+	g_current_row = 0;
+	g_decoded_n = 0;
+	fake.api.RfcGetFieldCount = [](auto, auto field_count, auto) {
+		*field_count = 2;
+		return RFC_OK;
+	};
+	fake.api.RfcGetFieldDescByIndex = [](auto, auto index, auto field_desc, auto) {
+		std::memset(field_desc, 0, sizeof(RFC_FIELD_DESC));
+		CopyName(field_desc->name, index == 0 ? "N" : "M");
+		field_desc->type = RFCTYPE_INT;
+		field_desc->nucLength = 4;
+		return RFC_OK;
+	};
+	fake.api.RfcGetTable = [](auto, auto, auto table_handle, auto) {
+		*table_handle = FakeRfcApi::Handle<RFC_TABLE_HANDLE>(1);
+		return RFC_OK;
+	};
+	fake.api.RfcGetRowCount = [](auto, auto row_count, auto) {
+		*row_count = g_row_count;
+		return RFC_OK;
+	};
+	fake.api.RfcMoveTo = [](auto, auto index, auto) {
+		g_current_row = index;
+		return RFC_OK;
+	};
+	fake.api.RfcGetCurrentRow = [](auto, auto error_info) {
+		if (g_current_row == g_missing_row) {
+			FakeRfcApi::SetError(error_info, RFC_TABLE_MOVE_EOF, "no current row");
+			return RFC_STRUCTURE_HANDLE(nullptr);
+		}
+		return FakeRfcApi::Handle<RFC_STRUCTURE_HANDLE>(2);
+	};
+	fake.api.RfcGetInt = [](auto, auto name, auto value, auto) {
+		g_decoded_n += name[0] == 'N' ? 1 : 0;
+		*value = 10 * g_current_row + (name[0] == 'M' ? 1 : 0);
+		return RFC_OK;
+	};
+}
+
+// A function module whose only parameter is the TABLES parameter LINES.
+static void FakeFunction(FakeRfcApi &fake) {
+	fake.api.RfcGetParameterCount = [](auto, auto count, auto) {
+		*count = 1;
+		return RFC_OK;
+	};
+	fake.api.RfcGetParameterDescByIndex = [](auto, auto, auto param_desc, auto) {
+		std::memset(param_desc, 0, sizeof(RFC_PARAMETER_DESC));
+		CopyName(param_desc->name, "LINES");
+		param_desc->type = RFCTYPE_TABLE;
+		param_desc->direction = RFC_TABLES;
+		param_desc->typeDescHandle = FakeRfcApi::Handle<RFC_TYPE_DESC_HANDLE>(0);
+		return RFC_OK;
+	};
+	fake.api.RfcCreateFunction = [](auto, auto) { return FakeRfcApi::Handle<RFC_FUNCTION_HANDLE>(3); };
+	fake.api.RfcDestroyFunction = [](auto, auto) { return RFC_OK; };
+	fake.api.RfcInvoke = [](auto, auto, auto) { return RFC_OK; };
+}
+
+static std::shared_ptr<RfcResultSet> InvokeFakeFunction(const std::string &path) {
+	auto connection = std::make_shared<RfcConnection>(FakeRfcApi::Handle<RFC_CONNECTION_HANDLE>(0));
+	auto function = std::make_shared<RfcFunction>(connection, "Z_LINES", FakeRfcApi::Handle<RFC_FUNCTION_DESC_HANDLE>(0));
+	return function->BeginInvocation()->Invoke(path);
+}
+
+TEST_CASE("A table result is streamed from the SDK table handle", "[erpl_rfc][result]") {
+	FakeRfcApi fake;
+	FakeTable(fake, 3);
+	FakeFunction(fake);
+
+	auto result_set = InvokeFakeFunction("/LINES");
+	REQUIRE(result_set->IsStreaming());
+	REQUIRE(result_set->GetResultNames() == std::vector<std::string> {"N", "M"});
+
+	DataChunk output;
+	output.Initialize(Allocator::DefaultAllocator(), result_set->GetResultTypes());
+	result_set->FetchNextResult(output);
+	REQUIRE(output.size() == 3);
+	REQUIRE(output.GetValue(0, 2) == Value::BIGINT(20));
+	REQUIRE(output.GetValue(1, 2) == Value::BIGINT(21));
+	REQUIRE_FALSE(result_set->HasMoreResults());
+}
+
+TEST_CASE("Only the projected fields of a streamed table are decoded", "[erpl_rfc][result]") {
+	FakeRfcApi fake;
+	FakeTable(fake, 3);
+	FakeFunction(fake);
+
+	auto result_set = InvokeFakeFunction("/LINES");
+	DataChunk output;
+	output.Initialize(Allocator::DefaultAllocator(), {LogicalType::BIGINT});
+	result_set->FetchNextResult(output, {"M"});
+	REQUIRE(output.size() == 3);
+	REQUIRE(output.GetValue(0, 1) == Value::BIGINT(11));
+	REQUIRE(g_decoded_n == 0);
+}
+
+TEST_CASE("A streamed row the SDK cannot return fails the scan instead of being dereferenced", "[erpl_rfc][result]") {
+	FakeRfcApi fake;
+	FakeTable(fake, 3);
+	FakeFunction(fake);
+	g_missing_row = 1;
+
+	auto result_set = InvokeFakeFunction("/LINES");
+	DataChunk output;
+	output.Initialize(Allocator::DefaultAllocator(), result_set->GetResultTypes());
+	REQUIRE_THROWS_WITH(result_set->FetchNextResult(output),
+	                    Catch::Contains("Failed to get row 1") && Catch::Contains("no current row"));
+}
+
+TEST_CASE("A nested table line the SDK cannot return fails the read instead of being dereferenced",
+          "[erpl_rfc][result]") {
+	FakeRfcApi fake;
+	FakeTable(fake, 2);
+	g_missing_row = 1;
+
+	auto table_type = std::make_shared<RfcType>(RFCTYPE_TABLE, FakeRfcApi::Handle<RFC_TYPE_DESC_HANDLE>(0), 0, 0);
+	RfcVectorLayout layout("LINES", table_type);
+	Vector target(table_type->CreateDuckDbType(), 1);
+
+	REQUIRE_THROWS_WITH(layout.Write(FakeRfcApi::Handle<RFC_FUNCTION_HANDLE>(3), target, 0),
+	                    Catch::Contains("Failed to get row 1") && Catch::Contains("no current row"));
+}
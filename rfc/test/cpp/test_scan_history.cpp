@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include <fstream>
+
+#include "sap_scan_history.hpp"
+
+using namespace duckdb;
+
+static RfcScanRecord Record(const std::string &object, idx_t rows)
+{
+	RfcScanRecord record;
+	record.finished_at_ms = 1760000000000;
+	record.function = "sap_read_table";
+	record.status = "complete";
+	record.source = "extracted";
+	record.system = RfcScanHistory::Fingerprint("sap.example.com\n00\n\n\n\n\n\n100");
+	record.object = RfcScanHistory::ObjectFingerprint(object);
+	record.duration_ms = 1234.5;
+	record.rows = rows;
+	record.payload_bytes = 1 << 20;
+	record.rfc_calls = 12;
+	record.rfc_time_ms = 987.25;
+	record.retries = 1;
+	record.connections_opened = 4;
+	record.connections_reused = 8;
+	record.columns = 4;
+	record.threads = 2;
+	record.max_batch_rows = 32768;
+	return record;
+}
+
+TEST_CASE("Scan history fingerprints are stable and hide names", "[erpl_rfc][scan_history]")
+{
+	// FNV-1a, 64 bits: the published test vectors.
+	REQUIRE(RfcScanHistory::Fingerprint("") == "cbf29ce484222325");
+	REQUIRE(RfcScanHistory::Fingerprint("a") == "af63dc4c8601ec8c");
+
+	REQUIRE(RfcScanHistory::ObjectFingerprint(" sflight ") == RfcScanHistory::ObjectFingerprint("SFLIGHT"));
+	REQUIRE(RfcScanHistory::ObjectFingerprint("SFLIGHT") != RfcScanHistory::ObjectFingerprint("SBOOK"));
+
+	auto line = RfcScanHistory::FormatRecord(Record("SFLIGHT", 100));
+	REQUIRE(line.find("SFLIGHT") == std::string::npos);
+	REQUIRE(line.find("sap.example.com") == std::string::npos);
+}
+
+TEST_CASE("Scan history lines round-trip", "[erpl_rfc][scan_history]")
+{
+	auto record = Record("SFLIGHT", 100);
+	auto line = RfcScanHistory::FormatRecord(record);
+	REQUIRE(StringUtil::StartsWith(line, "v1\t1760000000000\tsap_read_table\tcomplete\textracted\t"));
+
+	RfcScanRecord parsed;
+	REQUIRE(RfcScanHistory::ParseRecord(line, parsed));
+	REQUIRE(parsed.finished_at_ms == record.finished_at_ms);
+	REQUIRE(parsed.system == record.system);
+	REQUIRE(parsed.object == record.object);
+	REQUIRE(parsed.duration_ms == Approx(1234.5));
+	REQUIRE(parsed.rows == 100);
+	REQUIRE(parsed.payload_bytes == 1 << 20);
+	REQUIRE(parsed.rfc_time_ms == Approx(987.25));
+	REQUIRE(parsed.connections_reused == 8);
+	REQUIRE(parsed.max_batch_rows == 32768);
+
+	REQUIRE_FALSE(RfcScanHistory::ParseRecord("v2" + line.substr(2), parsed));
+	REQUIRE_FALSE(RfcScanHistory::ParseRecord(line.substr(0, line.size() / 2), parsed));
+}
+
+TEST_CASE("Scan history appends only while on and skips torn lines", "[erpl_rfc][scan_history]")
+{
+	LocalFileSystem fs;
+	auto path = TestCreatePath("scan_history.tsv");
+	std::remove(path.c_str());
+
+	SetRfcScanHistoryPath("");
+	RfcScanHistory::Append(fs, Record("SFLIGHT", 1));
+	REQUIRE(RfcScanHistory::Read(fs, path).empty());
+
+	SetRfcScanHistoryPath(path);
+	RfcScanHistory::Append(fs, Record("SFLIGHT", 2));
+	{
+		std::ofstream file(path, std::ios::app);
+		file << "v1\t1760000000000\tsap_read_table\tcompl\n";
+	}
+	RfcScanHistory::Append(fs, Record("SBOOK", 3));
+	SetRfcScanHistoryPath("");
+
+	auto records = RfcScanHistory::Read(fs, path);
+	REQUIRE(records.size() == 2);
+	REQUIRE(records[0].rows == 2);
+	REQUIRE(records[1].rows == 3);
+	REQUIRE(records[1].object == RfcScanHistory::ObjectFingerprint("SBOOK"));
+	std::remove(path.c_str());
+}
+
+TEST_CASE("Scan history follows DuckDB's external access setting", "[erpl_rfc][scan_history]")
+{
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto path = TestCreatePath("scan_history_denied.tsv");
+	std::remove(path.c_str());
+	REQUIRE_FALSE(con.Query("SET enable_external_access = false")->HasError());
+
+	// Appending never throws; the line is just not written.
+	SetRfcScanHistoryPath(path);
+	RfcScanHistory::Append(FileSystem::GetFileSystem(*con.context), Record("SFLIGHT", 1));
+	SetRfcScanHistoryPath("");
+	LocalFileSystem fs;
+	REQUIRE_FALSE(fs.FileExists(path));
+	REQUIRE_THROWS(RfcScanHistory::Read(FileSystem::GetFileSystem(*con.context), path));
+}
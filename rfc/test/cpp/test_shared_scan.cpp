@@ -0,0 +1,161 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include "sap_shared_scan.hpp"
+
+using namespace duckdb;
+
+static void MakeBatch(DataChunk &chunk, int32_t value) {
+	chunk.Initialize(Allocator::DefaultAllocator(), {LogicalType::INTEGER});
+	for (idx_t i = 0; i < 10; i++) {
+		chunk.SetValue(0, i, Value::INTEGER(value));
+	}
+	chunk.SetCardinality(10);
+}
+
+static void Publish(RfcSharedScan &scan, int32_t value) {
+	DataChunk chunk;
+	MakeBatch(chunk, value);
+	scan.BeginStep();
+	scan.Publish(chunk);
+}
+
+static RfcSharedScan::ReadResult Read(RfcSharedScan &scan, ClientContext &context, idx_t reader_id, int32_t &value) {
+	DataChunk output;
+	output.Initialize(Allocator::DefaultAllocator(), {LogicalType::INTEGER});
+	auto result = scan.Read(context, reader_id, output);
+	if (result == RfcSharedScan::ReadResult::CHUNK) {
+		REQUIRE(output.size() == 10);
+		value = output.GetValue(0, 9).GetValue<int32_t>();
+	}
+	return result;
+}
+
+TEST_CASE("Shared scan key separates systems, tables, filters and projections", "[erpl_rfc][shared_scan]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	RfcReadTableBindData mara("MARA", 0, 0, &DefaultRfcConnectionFactory, *con.context);
+	RfcReadTableBindData mara_filtered("MARA", 0, 0, &DefaultRfcConnectionFactory, *con.context);
+	mara_filtered.options = {"MTART = 'FERT'"};
+	RfcReadTableBindData marc("MARC", 0, 0, &DefaultRfcConnectionFactory, *con.context);
+
+	auto columns = std::vector<std::string> {"MATNR VARCHAR", "MTART VARCHAR"};
+	auto key = RfcSharedScan::Key("system-a", mara, columns);
+	REQUIRE(key == RfcSharedScan::Key("system-a", mara, columns));
+	REQUIRE(key != RfcSharedScan::Key("system-b", mara, columns));
+	REQUIRE(key != RfcSharedScan::Key("system-a", mara_filtered, columns));
+	REQUIRE(key != RfcSharedScan::Key("system-a", marc, columns));
+	REQUIRE(key != RfcSharedScan::Key("system-a", mara, {"MTART VARCHAR", "MATNR VARCHAR"}));
+	REQUIRE(RfcSharedScan::Key("", mara, columns).empty());
+}
+
+TEST_CASE("Shared scan readers start at the first batch and see the end", "[erpl_rfc][shared_scan]") {
+	DuckDB db(nullptr);
+	Connection a(db), b(db), c(db);
+	SetRfcSharedScanBuffer(64ULL * 1024 * 1024);
+
+	bool producer = false;
+	idx_t reader_id;
+	auto scan = RfcSharedScan::Join("readers", *a.context, producer, reader_id);
+	REQUIRE(scan);
+	REQUIRE(producer);
+	// The producer's own query never waits on itself.
+	REQUIRE_FALSE(RfcSharedScan::Join("readers", *a.context, producer, reader_id));
+
+	idx_t early_id;
+	REQUIRE(RfcSharedScan::Join("readers", *b.context, producer, early_id) == scan);
+	REQUIRE_FALSE(producer);
+
+	Publish(*scan, 1);
+	Publish(*scan, 2);
+
+	// Joins late, still reads from the start.
+	idx_t late_id;
+	REQUIRE(RfcSharedScan::Join("readers", *c.context, producer, late_id) == scan);
+	int32_t value = 0;
+	REQUIRE(Read(*scan, *c.context, late_id, value) == RfcSharedScan::ReadResult::CHUNK);
+	REQUIRE(value == 1);
+
+	scan->Finish();
+	for (auto id : {early_id, late_id}) {
+		auto &context = id == early_id ? *b.context : *c.context;
+		while (Read(*scan, context, id, value) == RfcSharedScan::ReadResult::CHUNK) {
+		}
+		REQUIRE(value == 2);
+	}
+
+	// A finished scan takes no readers; the next identical scan produces anew.
+	auto next = RfcSharedScan::Join("readers", *b.context, producer, reader_id);
+	REQUIRE(producer);
+	REQUIRE(next != scan);
+	next->Finish();
+	SetRfcSharedScanBuffer(RfcSharedScan::DEFAULT_BUFFER);
+}
+
+TEST_CASE("Shared scan detaches readers that fall behind a full spool", "[erpl_rfc][shared_scan]") {
+	DuckDB db(nullptr);
+	Connection a(db), b(db), c(db);
+
+	DataChunk batch;
+	MakeBatch(batch, 0);
+	SetRfcSharedScanBuffer(2 * batch.GetAllocationSize());
+
+	bool producer;
+	idx_t slow_id, fast_id;
+	auto scan = RfcSharedScan::Join("full", *a.context, producer, slow_id);
+	RfcSharedScan::Join("full", *b.context, producer, slow_id);
+	RfcSharedScan::Join("full", *c.context, producer, fast_id);
+	REQUIRE(RfcSharedScan::RunningCount() == 1);
+
+	int32_t value = 0;
+	for (int32_t i = 1; i <= 4; i++) {
+		Publish(*scan, i);
+		REQUIRE(Read(*scan, *c.context, fast_id, value) == RfcSharedScan::ReadResult::CHUNK);
+		REQUIRE(value == i);
+	}
+
+	// Closed to new readers once full, and the reader that read nothing is
+	// on its own; the one keeping up is not.
+	REQUIRE(RfcSharedScan::RunningCount() == 0);
+	REQUIRE(Read(*scan, *b.context, slow_id, value) == RfcSharedScan::ReadResult::DETACHED);
+	scan->Finish();
+	REQUIRE(Read(*scan, *c.context, fast_id, value) == RfcSharedScan::ReadResult::FINISHED);
+
+	SetRfcSharedScanBuffer(RfcSharedScan::DEFAULT_BUFFER);
+}
+
+TEST_CASE("Shared scan readers drain the spool when the producer stops early", "[erpl_rfc][shared_scan]") {
+	DuckDB db(nullptr);
+	Connection a(db), b(db);
+	SetRfcSharedScanBuffer(64ULL * 1024 * 1024);
+
+	bool producer;
+	idx_t reader_id;
+	auto scan = RfcSharedScan::Join("abandoned", *a.context, producer, reader_id);
+	RfcSharedScan::Join("abandoned", *b.context, producer, reader_id);
+
+	Publish(*scan, 1);
+	// E.g. the producer's query was satisfied by a LIMIT.
+	scan->Abandon();
+
+	int32_t value = 0;
+	REQUIRE(Read(*scan, *b.context, reader_id, value) == RfcSharedScan::ReadResult::CHUNK);
+	REQUIRE(value == 1);
+	REQUIRE(Read(*scan, *b.context, reader_id, value) == RfcSharedScan::ReadResult::DETACHED);
+	SetRfcSharedScanBuffer(RfcSharedScan::DEFAULT_BUFFER);
+}
+
+TEST_CASE("Shared scans are off by default and with a zero buffer", "[erpl_rfc][shared_scan]") {
+	DuckDB db(nullptr);
+	Connection a(db);
+
+	REQUIRE(RfcSharedScan::DEFAULT_BUFFER == 0);
+	SetRfcSharedScanBuffer(0);
+	bool producer = true;
+	idx_t reader_id;
+	REQUIRE_FALSE(RfcSharedScan::Join("off", *a.context, producer, reader_id));
+	REQUIRE_FALSE(producer);
+	SetRfcSharedScanBuffer(RfcSharedScan::DEFAULT_BUFFER);
+}
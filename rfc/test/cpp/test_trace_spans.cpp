@@ -0,0 +1,105 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include "sap_trace_spans.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("Spans without a span context are dropped", "[erpl_rfc][trace_spans]") {
+	auto buffer = std::make_shared<RfcSpanBuffer>();
+	{
+		RfcTraceSpan span("RfcInvoke", "rfc");
+		REQUIRE_FALSE(span.Recording());
+	}
+	REQUIRE(RfcSpanContext::Current() == nullptr);
+	{
+		RfcSpanContext context(nullptr, 0, "CARRID");
+		RfcTraceSpan span("RfcInvoke", "rfc");
+		REQUIRE_FALSE(span.Recording());
+		REQUIRE(RfcSpanContext::Current() == nullptr);
+	}
+	REQUIRE(buffer->Size() == 0);
+}
+
+TEST_CASE("Span details set while recording are kept", "[erpl_rfc][trace_spans]") {
+	auto buffer = std::make_shared<RfcSpanBuffer>();
+	{
+		RfcSpanContext context(buffer.get(), 0, "");
+		RfcTraceSpan span("RfcInvoke", "rfc");
+		REQUIRE(span.Recording());
+		span.SetDetail("BAPI_USER_GET_DETAIL");
+	}
+	REQUIRE(buffer->ToChromeTraceJson().find("\"detail\":\"BAPI_USER_GET_DETAIL\"") != string::npos);
+}
+
+TEST_CASE("Spans are tagged with scan and column and nest", "[erpl_rfc][trace_spans]") {
+	auto buffer = std::make_shared<RfcSpanBuffer>();
+	auto scan_id = buffer->NextScanId();
+	REQUIRE(buffer->NextScanId() == scan_id + 1);
+	{
+		RfcSpanContext step(buffer.get(), scan_id, "");
+		RfcTraceSpan outer("Step", "scan", "SFLIGHT");
+		{
+			RfcSpanContext task(buffer.get(), scan_id, "CARRID");
+			REQUIRE(RfcSpanContext::Current() == &task);
+			RfcTraceSpan inner("RfcInvoke", "rfc", "RFC_READ_TABLE");
+		}
+		REQUIRE(RfcSpanContext::Current() == &step);
+	}
+	REQUIRE(RfcSpanContext::Current() == nullptr);
+	REQUIRE(buffer->Size() == 2);
+
+	auto json = buffer->ToChromeTraceJson();
+	REQUIRE(json.find("\"traceEvents\":[") != string::npos);
+	REQUIRE(json.find("\"name\":\"Step\",\"cat\":\"scan\",\"ph\":\"X\"") != string::npos);
+	REQUIRE(json.find("\"name\":\"RfcInvoke\",\"cat\":\"rfc\",\"ph\":\"X\"") != string::npos);
+	REQUIRE(json.find("\"column\":\"CARRID\"") != string::npos);
+	REQUIRE(json.find("\"detail\":\"RFC_READ_TABLE\"") != string::npos);
+	// One thread, one track.
+	REQUIRE(json.find("\"tid\":1") != string::npos);
+	REQUIRE(json.find("\"tid\":2") == string::npos);
+	REQUIRE(json.find("\"name\":\"thread_name\"") != string::npos);
+}
+
+TEST_CASE("Span details are JSON-escaped", "[erpl_rfc][trace_spans]") {
+	auto buffer = std::make_shared<RfcSpanBuffer>();
+	{
+		RfcSpanContext context(buffer.get(), 0, "A\"B");
+		RfcTraceSpan span("Step", "scan", "line\nbreak");
+	}
+	auto json = buffer->ToChromeTraceJson();
+	REQUIRE(json.find("\"column\":\"A\\\"B\"") != string::npos);
+	REQUIRE(json.find("\"detail\":\"line\\nbreak\"") != string::npos);
+}
+
+TEST_CASE("A full span buffer drops spans and counts them", "[erpl_rfc][trace_spans]") {
+	auto buffer = std::make_shared<RfcSpanBuffer>();
+	{
+		RfcSpanContext context(buffer.get(), 0, "");
+		for (idx_t i = 0; i < RfcSpanBuffer::MAX_SPANS + 3; i++) {
+			RfcTraceSpan span("RfcInvoke", "rfc");
+		}
+	}
+	REQUIRE(buffer->Size() == RfcSpanBuffer::MAX_SPANS);
+	REQUIRE(buffer->Dropped() == 3);
+	REQUIRE(buffer->ToChromeTraceJson().find("\"dropped_spans\":3") != string::npos);
+}
+
+TEST_CASE("Span traces are written through DuckDB's file system", "[erpl_rfc][trace_spans]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+	auto directory = TestCreatePath("erpl_rfc_spans");
+
+	auto buffer = std::make_shared<RfcSpanBuffer>();
+	{
+		RfcSpanContext context(buffer.get(), 0, "");
+		RfcTraceSpan span("RfcInvoke", "rfc");
+	}
+	auto path = buffer->WriteTo(fs, directory);
+	REQUIRE(fs.FileExists(path));
+
+	REQUIRE_FALSE(con.Query("SET enable_external_access = false")->HasError());
+	REQUIRE_THROWS(buffer->WriteTo(fs, directory));
+}
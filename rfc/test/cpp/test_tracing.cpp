@@ -0,0 +1,163 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "erpl_tracing.hpp"
+
+using namespace duckdb;
+
+// The tracer is process-wide; each case turns it off again so the others see
+// it in its default state.
+
+static std::string ReadFile(const std::filesystem::path &path)
+{
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+static int g_evaluated = 0;
+
+static std::string Evaluated()
+{
+	g_evaluated++;
+	return "evaluated";
+}
+
+TEST_CASE("Trace macros do not build arguments of levels that are off", "[erpl_rfc][tracing]") {
+	auto &tracer = erpl::ErplTracer::Instance();
+	g_evaluated = 0;
+	REQUIRE_FALSE(erpl::ErplTracer::ShouldTrace(erpl::TraceLevel::ERROR));
+	ERPL_TRACE_ERROR("test", Evaluated());
+	REQUIRE(g_evaluated == 0);
+
+	tracer.SetOutputMode("file");
+	tracer.SetLevel(erpl::TraceLevel::INFO);
+	tracer.SetEnabled(true);
+	ERPL_TRACE_DEBUG("test", Evaluated());
+	REQUIRE(g_evaluated == 0);
+	ERPL_TRACE_INFO("test", Evaluated());
+	REQUIRE(g_evaluated == 1);
+
+	tracer.SetEnabled(false);
+	tracer.SetOutputMode("console");
+	REQUIRE_FALSE(erpl::ErplTracer::ShouldTrace(erpl::TraceLevel::ERROR));
+}
+
+TEST_CASE("Binary trace records round-trip", "[erpl_rfc][tracing]") {
+	erpl::TraceRecord record;
+	record.timestamp_us = 1760000000123456;
+	record.level = erpl::TraceLevel::WARN;
+	record.thread = 7;
+	record.component = "sap_read_table";
+	record.message = std::string("tab\there, nul \0 too", 19);
+	record.data = "";
+
+	std::string bytes(erpl::ErplTracer::BINARY_MAGIC, erpl::ErplTracer::BINARY_MAGIC_SIZE);
+	bytes += erpl::ErplTracer::EncodeBinary(record);
+	bytes += erpl::ErplTracer::EncodeBinary(record);
+
+	std::vector<erpl::TraceRecord> decoded;
+	REQUIRE(erpl::ErplTracer::DecodeBinary(bytes, decoded));
+	REQUIRE(decoded.size() == 2);
+	REQUIRE(decoded[0].timestamp_us == record.timestamp_us);
+	REQUIRE(decoded[0].level == erpl::TraceLevel::WARN);
+	REQUIRE(decoded[0].thread == 7);
+	REQUIRE(decoded[0].component == record.component);
+	REQUIRE(decoded[0].message == record.message);
+	REQUIRE(decoded[0].data.empty());
+
+	// A record cut off by a crash is dropped, the ones before it are kept.
+	decoded.clear();
+	REQUIRE(erpl::ErplTracer::DecodeBinary(bytes.substr(0, bytes.size() - 3), decoded));
+	REQUIRE(decoded.size() == 1);
+
+	decoded.clear();
+	REQUIRE_FALSE(erpl::ErplTracer::DecodeBinary("2026-10-18 12:00:00.000 [INFO] [x] y\n", decoded));
+}
+
+TEST_CASE("Messages of several threads reach the binary trace file", "[erpl_rfc][tracing]") {
+	auto directory = std::filesystem::temp_directory_path() / "erpl_rfc_test_tracing";
+	std::filesystem::remove_all(directory);
+
+	auto &tracer = erpl::ErplTracer::Instance();
+	tracer.SetTraceDirectory(directory.string());
+	tracer.SetOutputMode("file");
+	tracer.SetFormat(erpl::TraceFormat::BINARY);
+	tracer.SetLevel(erpl::TraceLevel::DEBUG_LEVEL);
+	tracer.SetEnabled(true);
+
+	// Fewer than a ring holds, so nothing is dropped.
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++) {
+		threads.emplace_back([t]() {
+			for (int i = 0; i < 100; i++) {
+				ERPL_TRACE_DEBUG_DATA("test", "message " + std::to_string(i), std::to_string(t));
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	tracer.Flush();
+
+	std::vector<erpl::TraceRecord> decoded;
+	REQUIRE(erpl::ErplTracer::DecodeBinary(ReadFile(directory / "erpl_trace.bin"), decoded));
+	idx_t messages = 0;
+	for (auto &record : decoded) {
+		if (record.component == "test") {
+			REQUIRE(record.level == erpl::TraceLevel::DEBUG_LEVEL);
+			messages++;
+		}
+	}
+	REQUIRE(messages == 400);
+	REQUIRE(tracer.Dropped() == 0);
+
+	tracer.SetEnabled(false);
+	tracer.SetFormat(erpl::TraceFormat::TEXT);
+	tracer.SetOutputMode("console");
+	tracer.SetLevel(erpl::TraceLevel::INFO);
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("A full trace file without rotation stops growing", "[erpl_rfc][tracing]") {
+	auto directory = std::filesystem::temp_directory_path() / "erpl_rfc_test_tracing_full";
+	std::filesystem::remove_all(directory);
+
+	auto &tracer = erpl::ErplTracer::Instance();
+	tracer.SetTraceDirectory(directory.string());
+	tracer.SetOutputMode("file");
+	tracer.SetMaxFileSize(200);
+	tracer.SetEnabled(true);
+
+	for (int i = 0; i < 10; i++) {
+		ERPL_TRACE_INFO("test", "message " + std::to_string(i));
+	}
+	tracer.Flush();
+	auto full_size = std::filesystem::file_size(directory / "erpl_trace.log");
+	REQUIRE(full_size >= 200);
+
+	for (int round = 0; round < 5; round++) {
+		ERPL_TRACE_INFO("test", "dropped " + std::to_string(round));
+		tracer.Flush();
+	}
+	REQUIRE(std::filesystem::file_size(directory / "erpl_trace.log") == full_size);
+	REQUIRE_FALSE(std::filesystem::exists(directory / "erpl_trace.log.1"));
+
+	// A new directory is a new file.
+	tracer.SetTraceDirectory((directory / "next").string());
+	ERPL_TRACE_INFO("test", "resumed");
+	tracer.Flush();
+	REQUIRE(ReadFile(directory / "next" / "erpl_trace.log").find("resumed") != std::string::npos);
+
+	tracer.SetEnabled(false);
+	tracer.SetMaxFileSize(0);
+	tracer.SetOutputMode("console");
+	std::filesystem::remove_all(directory);
+}